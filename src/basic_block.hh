@@ -24,9 +24,13 @@
  * ****************************************************************************************************************** */
 
 namespace game {
+
+  /**
+   * Base class of the block. It has no virtual functions, so the derived blocks can be stored by value in flat arrays.
+   */
   class basic_block {
     public:
-      enum E_block_type {
+      enum E_block_type : unsigned char {
         EMPTY = 0,
         WALL,
         TARGET,
@@ -37,8 +41,7 @@ namespace game {
       };
 
     protected:
-      enum E_block_type type_;
-      bool has_player_ {false};
+      E_block_type type_;
 
     public:
       basic_block() : type_{EMPTY}
@@ -51,12 +54,12 @@ namespace game {
         return;
       }}}
 
-      virtual ~basic_block()
+      ~basic_block()
       {{{
         return;
       }}}
 
-      virtual void set(E_block_type type)
+      void set(E_block_type type)
       {{{
         type_ = type;
         return;
@@ -0,0 +1,297 @@
+/**
+ * @file      binary_archive.hh
+ * @author    Dee'Kej (David Kaspar - xkaspa34)
+ * @version   1.0
+ * @brief     Compact binary archives for the protocol's structures, used instead of Boost's text archives.
+ *
+ * @detailed  The archives use the same serialize() member functions of the protocol's structures as the Boost's
+ *            archives do. Enums are encoded as 1 byte, signed/unsigned chars as 1 byte, unsigned short integers as 2
+ *            bytes and long integers as 8 bytes in little endian. The length of strings and vectors is encoded as
+ *            variable length unsigned integer (7 bits per byte, little endian), followed by the content itself.
+ */
+
+
+/* ****************************************************************************************************************** *
+ * ***[ START OF BINARY_ARCHIVE.HH ]********************************************************************************* *
+ * ****************************************************************************************************************** */
+
+#ifndef H_GUARD_BINARY_ARCHIVE_HH
+#define H_GUARD_BINARY_ARCHIVE_HH
+
+
+/* ****************************************************************************************************************** *
+ ~ ~~~[ HEADER FILES ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ ~
+ * ****************************************************************************************************************** */
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+
+/* ****************************************************************************************************************** *
+ ~ ~~~[ BINARY ARCHIVES ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ ~
+ * ****************************************************************************************************************** */
+
+namespace protocol {
+
+  /**
+   * Output archive appending the encoded data to the given buffer. The buffer can be reused for next encoding, so no
+   * allocation is needed once the buffer is large enough.
+   */
+  class binary_oarchive {
+      std::vector<char> &buffer_;
+
+    public:
+      binary_oarchive(std::vector<char> &buffer) : buffer_(buffer) {}
+
+      template <typename T>
+      binary_oarchive &operator&(const T &t)
+      {{{
+        save(t);
+        return *this;
+      }}}
+
+      template <typename T>
+      binary_oarchive &operator<<(const T &t)
+      {{{
+        save(t);
+        return *this;
+      }}}
+
+    private:
+      template <typename T>
+      typename std::enable_if<std::is_enum<T>::value>::type save(const T &t)
+      {{{
+        assert(static_cast<unsigned long>(t) <= UINT8_MAX);   // Fixed width of enums is 1 byte.
+        buffer_.push_back(static_cast<char>(t));
+        return;
+      }}}
+
+      template <typename T>
+      typename std::enable_if<std::is_class<T>::value>::type save(const T &t)
+      {{{
+        // The serialize() member functions aren't const, but they only read the structure when saving:
+        const_cast<T &>(t).serialize(*this, 0);
+        return;
+      }}}
+
+      void save(signed char value)
+      {{{
+        buffer_.push_back(static_cast<char>(value));
+        return;
+      }}}
+
+      void save(unsigned char value)
+      {{{
+        buffer_.push_back(static_cast<char>(value));
+        return;
+      }}}
+
+      void save(unsigned short value)
+      {{{
+        buffer_.push_back(static_cast<char>(value));
+        buffer_.push_back(static_cast<char>(value >> 8));
+        return;
+      }}}
+
+      void save(long value)
+      {{{
+        std::uint64_t bits = static_cast<std::uint64_t>(value);
+
+        for (unsigned i = 0; i < 8; i++) {
+          buffer_.push_back(static_cast<char>(bits >> (8 * i)));
+        }
+
+        return;
+      }}}
+
+      void save(const std::string &str)
+      {{{
+        save_length(str.size());
+        buffer_.insert(buffer_.end(), str.begin(), str.end());
+        return;
+      }}}
+
+      template <typename T1, typename T2>
+      void save(const std::pair<T1, T2> &pair)
+      {{{
+        save(pair.first);
+        save(pair.second);
+        return;
+      }}}
+
+      template <typename T>
+      void save(const std::vector<T> &vector)
+      {{{
+        save_length(vector.size());
+
+        for (const T &item : vector) {
+          save(item);
+        }
+
+        return;
+      }}}
+
+      void save_length(std::size_t length)
+      {{{
+        while (length >= 0x80) {
+          buffer_.push_back(static_cast<char>((length & 0x7F) | 0x80));
+          length >>= 7;
+        }
+
+        buffer_.push_back(static_cast<char>(length));
+        return;
+      }}}
+  };
+
+  // // // // // // // // // // // // // // // //
+
+  /**
+   * Input archive decoding the data directly from the given memory, without copying it. Throws std::runtime_error when
+   * the data are truncated or malformed.
+   */
+  class binary_iarchive {
+      const char *p_data_;
+      const char *p_end_;
+
+    public:
+      binary_iarchive(const char *p_data, std::size_t size) : p_data_{p_data}, p_end_{p_data + size} {}
+
+      template <typename T>
+      binary_iarchive &operator&(T &t)
+      {{{
+        load(t);
+        return *this;
+      }}}
+
+      template <typename T>
+      binary_iarchive &operator>>(T &t)
+      {{{
+        load(t);
+        return *this;
+      }}}
+
+    private:
+      template <typename T>
+      typename std::enable_if<std::is_enum<T>::value>::type load(T &t)
+      {{{
+        t = static_cast<T>(static_cast<unsigned char>(next()));
+        return;
+      }}}
+
+      template <typename T>
+      typename std::enable_if<std::is_class<T>::value>::type load(T &t)
+      {{{
+        t.serialize(*this, 0);
+        return;
+      }}}
+
+      void load(signed char &value)
+      {{{
+        value = static_cast<signed char>(next());
+        return;
+      }}}
+
+      void load(unsigned char &value)
+      {{{
+        value = static_cast<unsigned char>(next());
+        return;
+      }}}
+
+      void load(unsigned short &value)
+      {{{
+        value = static_cast<unsigned char>(next());
+        value |= static_cast<unsigned short>(static_cast<unsigned char>(next()) << 8);
+        return;
+      }}}
+
+      void load(long &value)
+      {{{
+        std::uint64_t bits {0};
+
+        for (unsigned i = 0; i < 8; i++) {
+          bits |= static_cast<std::uint64_t>(static_cast<unsigned char>(next())) << (8 * i);
+        }
+
+        value = static_cast<long>(bits);
+        return;
+      }}}
+
+      void load(std::string &str)
+      {{{
+        std::size_t length = load_length();
+
+        str.assign(p_data_, length);
+        p_data_ += length;
+
+        return;
+      }}}
+
+      template <typename T1, typename T2>
+      void load(std::pair<T1, T2> &pair)
+      {{{
+        load(pair.first);
+        load(pair.second);
+        return;
+      }}}
+
+      template <typename T>
+      void load(std::vector<T> &vector)
+      {{{
+        // Every item takes at least 1 byte, so the length can't exceed the remaining data:
+        vector.resize(load_length());
+
+        for (T &item : vector) {
+          load(item);
+        }
+
+        return;
+      }}}
+
+      /**
+       * @return  Decoded length of a string or vector, which is never greater than the size of remaining data.
+       */
+      std::size_t load_length()
+      {{{
+        std::size_t length {0};
+        unsigned    shift {0};
+        char        byte;
+
+        do {
+          if (shift >= 8 * sizeof(std::size_t)) {
+            throw std::runtime_error("binary_iarchive: length overflow");
+          }
+
+          byte = next();
+          length |= static_cast<std::size_t>(byte & 0x7F) << shift;
+          shift += 7;
+        } while ((byte & 0x80) != 0);
+
+        if (length > static_cast<std::size_t>(p_end_ - p_data_)) {
+          throw std::runtime_error("binary_iarchive: truncated data");
+        }
+
+        return length;
+      }}}
+
+      char next()
+      {{{
+        if (p_data_ == p_end_) {
+          throw std::runtime_error("binary_iarchive: truncated data");
+        }
+
+        return *p_data_++;
+      }}}
+  };
+}
+
+/* ****************************************************************************************************************** *
+ * ***[ END OF BINARY_ARCHIVE.HH ]*********************************************************************************** *
+ * ****************************************************************************************************************** */
+
+#endif
@@ -15,6 +15,7 @@
  ~ ~~~[ HEADER FILES ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ ~
  * ****************************************************************************************************************** */
 
+#include <algorithm>
 #include <cassert>
 
 #include "client_globals.hh"
@@ -47,9 +48,13 @@ namespace client {
   {{{
     messages_out_.resize(1);    // Avoiding segmentation fault.
 
-    messages_out_[0].type = protocol::E_type::CTRL;
-    messages_out_[0].ctrl_type = protocol::E_ctrl_type::SYN;
-    messages_out_[0].status = protocol::E_status::QUERY;
+    // Prepare SYN packet requesting the multiplexing of the game channel:
+    SYN_packet_.type = protocol::E_type::CTRL;
+    SYN_packet_.ctrl_type = protocol::E_ctrl_type::SYN;
+    SYN_packet_.status = protocol::E_status::QUERY;
+    SYN_packet_.data.push_back(PROTOCOL_MUX);
+    SYN_packet_.data.push_back(PROTOCOL_BINARY);
+    SYN_packet_.data.push_back(PROTOCOL_DELTA);
 
     // Prepare HELLO packet for fast sending:
     HELLO_packet_.type = protocol::E_type::INFO;
@@ -179,9 +184,36 @@ namespace client {
 
     io_service_.reset();                // Prepare the io_service for possible next run.
 
+    // Next connection has to negotiate the multiplexing again:
+    output_mutex_.lock();
+    {
+      frames_out_.clear();
+      frames_sending_ = false;
+      multiplexed_ = false;
+      pu_tcp_connect_->binary(false);
+    }
+    output_mutex_.unlock();
+
     return true;
   }}}
 
+
+  /**
+   * @return  'true' if the server has confirmed the multiplexing of the game channel over this connection.
+   */
+  bool tcp_connection::multiplexed()
+  {{{
+    bool retval;
+
+    output_mutex_.lock();
+    {
+      retval = multiplexed_;
+    }
+    output_mutex_.unlock();
+
+    return retval;
+  }}}
+
   
   /**
    * Sends the given message to the server.
@@ -192,15 +224,75 @@ namespace client {
 
     output_mutex_.lock();
     {
-      messages_out_[0] = msg;
-      pu_tcp_connect_->async_write(messages_out_, boost::bind(&tcp_connection::async_send_handler, this, 
-                                                              boost::asio::placeholders::error));
+      if (multiplexed_ == true) {
+        frames_out_.emplace_back();
+        frames_out_.back().channel = protocol::E_channel::LOBBY;
+        frames_out_.back().msg = msg;
+        frame_send();
+      }
+      else {
+        messages_out_[0] = msg;
+        pu_tcp_connect_->async_write(messages_out_, boost::bind(&tcp_connection::async_send_handler, this, 
+                                                                boost::asio::placeholders::error));
+      }
+    }
+    output_mutex_.unlock();
+
+    return;
+  }}}
+
+
+  /**
+   * Sends the given game command to the server over the multiplexed connection.
+   */
+  void tcp_connection::async_send(const protocol::command &cmd)
+  {{{
+    timeout_out_reset();                // Game commands are keeping the connection alive as well.
+
+    output_mutex_.lock();
+    {
+      assert(multiplexed_ == true);
+
+      frames_out_.emplace_back();
+      frames_out_.back().channel = protocol::E_channel::GAME_COMMAND;
+      frames_out_.back().cmd = cmd;
+      frame_send();
     }
     output_mutex_.unlock();
 
     return;
   }}}
 
+
+  /**
+   * Attaches the game connection, which will be receiving the game updates from the multiplexed connection.
+   */
+  void tcp_connection::game_attach(client::game_connection *p_game_connect)
+  {{{
+    game_mutex_.lock();
+    {
+      p_game_connect_ = p_game_connect;
+    }
+    game_mutex_.unlock();
+
+    return;
+  }}}
+
+
+  /**
+   * Detaches the game connection. Any game updates received afterwards are dropped.
+   */
+  void tcp_connection::game_detach()
+  {{{
+    game_mutex_.lock();
+    {
+      p_game_connect_ = NULL;
+    }
+    game_mutex_.unlock();
+
+    return;
+  }}}
+
   // // // // // // // // // // // //
 
   /**
@@ -208,6 +300,7 @@ namespace client {
    */
   void tcp_connection::communication_start()
   {{{
+    messages_out_[0] = SYN_packet_;
     pu_tcp_connect_->async_write(messages_out_, boost::bind(&tcp_connection::handshake_send_handler, this,
                                                             boost::asio::placeholders::error));
     start_timeout_in_timer();           // Timeout for server's answers.
@@ -336,6 +429,22 @@ namespace client {
       return;
     }
 
+    // Switch to the frames if the server has confirmed the multiplexing:
+    if (std::find(messages_in_[0].data.begin(), messages_in_[0].data.end(), PROTOCOL_MUX) !=
+        messages_in_[0].data.end()) {
+      output_mutex_.lock();
+      {
+        multiplexed_ = true;
+      }
+      output_mutex_.unlock();
+    }
+
+    // The SYN ACK was the last message sent in text archive, if the server has confirmed the binary format:
+    if (std::find(messages_in_[0].data.begin(), messages_in_[0].data.end(), PROTOCOL_BINARY) !=
+        messages_in_[0].data.end()) {
+      pu_tcp_connect_->binary(true);
+    }
+
     asio_loops_start();                 // Successful handshake, continue.
 
     return;
@@ -543,8 +652,15 @@ namespace client {
    */
   void tcp_connection::async_receive()
   {{{
-    pu_tcp_connect_->async_read(messages_in_, boost::bind(&tcp_connection::async_receive_handler, this,
-                                                          boost::asio::placeholders::error));
+    if (multiplexed_ == true) {
+      pu_tcp_connect_->async_read(frame_in_, boost::bind(&tcp_connection::async_receive_handler, this,
+                                                         boost::asio::placeholders::error));
+    }
+    else {
+      pu_tcp_connect_->async_read(messages_in_, boost::bind(&tcp_connection::async_receive_handler, this,
+                                                            boost::asio::placeholders::error));
+    }
+
     return;
   }}}
 
@@ -590,6 +706,11 @@ namespace client {
       
       return;
     }
+    // Game updates are passed directly to the game connection, they aren't meant for the client:
+    else if (multiplexed_ == true && frame_unpack() == false) {
+      async_receive();
+      return;
+    }
     // Testing the message received - the protocol expects only one actual message from server:
     else if (messages_in_.size() != 1) {
       action_req_mutex_.lock();
@@ -655,6 +776,95 @@ namespace client {
   }}}
 
 
+  /**
+   * Unpacks the received frame of the multiplexed connection. Lobby message is stored into the incoming messages'
+   * buffer, game update is passed to the attached game connection.
+   *
+   * @return  'true' if the frame contained lobby message to be processed, 'false' otherwise.
+   */
+  bool tcp_connection::frame_unpack()
+  {{{
+    switch (frame_in_.channel) {
+      case protocol::E_channel::LOBBY :
+        messages_in_.resize(1);
+        messages_in_[0] = std::move(frame_in_.msg);
+        return true;
+
+      case protocol::E_channel::GAME_UPDATE :
+        game_mutex_.lock();
+        {
+          if (p_game_connect_ != NULL) {
+            p_game_connect_->update_received(frame_in_.upd);
+          }
+        }
+        game_mutex_.unlock();
+        return false;
+
+      default :
+        action_req_mutex_.lock();
+        {
+          message_in_.type = protocol::E_type::ERROR;
+          message_in_.error_type = protocol::E_error_type::WRONG_PROTOCOL;
+          message_in_.status = protocol::E_status::LOCAL;
+          message_in_.data.push_back("Server is using wrong protocol");
+
+          new_message_flag_ = true;
+          action_req_.notify_one();
+        }
+        action_req_mutex_.unlock();
+        return false;
+    }
+  }}}
+
+
+  /**
+   * Starts sending of the first queued frame, unless another frame is being sent right now. The frames are sent one by
+   * one, so the serialized data of one frame aren't overwritten by another. The output mutex must be already locked.
+   */
+  void tcp_connection::frame_send()
+  {{{
+    if (frames_sending_ == true || frames_out_.empty() == true) {
+      return;
+    }
+
+    bool lobby_frame = (frames_out_.front().channel == protocol::E_channel::LOBBY);
+    frames_sending_ = true;
+
+    pu_tcp_connect_->async_write(frames_out_.front(), boost::bind(&tcp_connection::frame_send_handler, this,
+                                                                  boost::asio::placeholders::error, lobby_frame));
+    frames_out_.pop_front();            // The frame has been already serialized.
+
+    return;
+  }}}
+
+
+  /**
+   * Handler for sent frame. Continues with sending of next queued frame. Only the lobby messages are expecting the
+   * server's response, so only these are setting the timeout of incoming messages.
+   */
+  void tcp_connection::frame_send_handler(const boost::system::error_code &error, bool lobby_frame)
+  {{{
+    output_mutex_.lock();
+    {
+      frames_sending_ = false;
+
+      if (error) {
+        frames_out_.clear();
+      }
+      else {
+        frame_send();
+      }
+    }
+    output_mutex_.unlock();
+
+    if (error || lobby_frame == true) {
+      async_send_handler(error);
+    }
+
+    return;
+  }}}
+
+
   /**
    * Starts the outcoming timer for sending HELLO packets and starts the asynchronous receiving loop.
    */
@@ -688,8 +898,30 @@ namespace client {
   }}}
 
 
+  /**
+   * Constructor of game connection multiplexed over the already established lobby connection. No new connection to the
+   * server is opened, the game updates are delivered by the lobby connection.
+   */
+  game_connection::game_connection(client::tcp_connection *p_lobby_connect, protocol::update &update_storage,
+                                   boost::condition_variable &update_cond_var, boost::mutex &update_mutex,
+                                   boost::condition_variable &error_cond_var, boost::mutex &error_mutex,
+                                   protocol::message &error_msg_storage, bool &error_flag) :
+    connection("", ""),
+    update_in_{update_storage}, update_in_received_{update_cond_var}, update_in_mutex_{update_mutex},
+    error_occured_{error_cond_var}, error_mutex_{error_mutex}, error_message_{error_msg_storage},
+    error_flag_{error_flag},
+    p_lobby_connect_{p_lobby_connect}
+  {{{
+    return;
+  }}}
+
+
   game_connection::~game_connection()
   {{{
+    if (p_lobby_connect_ != NULL) {
+      p_lobby_connect_->game_detach();
+    }
+
     if (socket_.is_open() == true) {
       // Closing the connection:
       boost::system::error_code ignored_error;
@@ -713,6 +945,11 @@ namespace client {
 
   bool game_connection::connect()
   {{{
+    if (p_lobby_connect_ != NULL) {
+      p_lobby_connect_->game_attach(this);
+      return true;
+    }
+
     assert(socket_.is_open() == false);
 
     boost::system::error_code error;
@@ -758,6 +995,11 @@ namespace client {
 
   bool game_connection::disconnect()
   {{{
+    if (p_lobby_connect_ != NULL) {
+      p_lobby_connect_->game_detach();
+      return true;
+    }
+
     if (socket_.is_open() == true) {
       // Closing the connection:
       boost::system::error_code ignored_error;
@@ -855,6 +1097,11 @@ namespace client {
 
   void game_connection::async_send(const protocol::command &cmd)
   {{{
+    if (p_lobby_connect_ != NULL) {
+      p_lobby_connect_->async_send(cmd);
+      return;
+    }
+
     commands_out_[0] = cmd;
     pu_tcp_connect_->async_write(commands_out_, boost::bind(&game_connection::async_send_handler, this,
                                                             boost::asio::placeholders::error));
@@ -968,17 +1215,75 @@ namespace client {
     }
     else {
       //  Message has met all pre-conditions, prepare it for the game instance:
-      update_in_mutex_.lock();
-      {
-        update_in_ = updates_in_[0];
-        update_in_received_.notify_one();
-      }
-      update_in_mutex_.unlock();
+      update_received(updates_in_[0]);
     
       async_receive();
       return;
     }
   }}}
+
+
+  /**
+   * Stores the received update for the game instance and notifies it. DELTA update is applied to the stored state, so
+   * the game instance always has the whole state of the game, even when it didn't process some of the updates.
+   */
+  void game_connection::update_received(const protocol::update &upd)
+  {{{
+    update_in_mutex_.lock();
+    {
+      if (upd.type == protocol::E_update_type::KEYFRAME) {
+        update_in_ = upd;
+      }
+      else {
+        update_apply(upd);
+      }
+
+      update_in_received_.notify_one();
+    }
+    update_in_mutex_.unlock();
+
+    return;
+  }}}
+
+
+  /**
+   * Applies the DELTA update to the stored state of the game. Expects the update_in_mutex_ to be locked.
+   */
+  void game_connection::update_apply(const protocol::update &delta)
+  {{{
+    std::vector<std::pair<signed char, signed char>>::const_iterator iter;
+    std::vector<std::pair<signed char, signed char>>::iterator it_key;
+
+    update_in_.last_move = delta.last_move;
+
+    update_in_.opened_gates_coords.insert(update_in_.opened_gates_coords.end(), delta.opened_gates_coords.begin(),
+                                          delta.opened_gates_coords.end());
+
+    for (iter = delta.taken_keys_coords.begin(); iter != delta.taken_keys_coords.end(); iter++) {
+      it_key = std::find(update_in_.keys_coords.begin(), update_in_.keys_coords.end(), *iter);
+
+      if (it_key != update_in_.keys_coords.end()) {
+        update_in_.keys_coords.erase(it_key);
+      }
+    }
+
+    update_in_.keys_coords.insert(update_in_.keys_coords.end(), delta.keys_coords.begin(), delta.keys_coords.end());
+
+    // NOTE: Indexes out of range are ignored, the server sends only indexes of the previous KEYFRAME.
+    for (std::size_t i = 0; i < delta.players_moved.size() && i < delta.players_coords.size(); i++) {
+      if (delta.players_moved[i] < update_in_.players_coords.size()) {
+        update_in_.players_coords[delta.players_moved[i]] = delta.players_coords[i];
+      }
+    }
+
+    for (std::size_t i = 0; i < delta.guardians_moved.size() && i < delta.guardians_coords.size(); i++) {
+      if (delta.guardians_moved[i] < update_in_.guardians_coords.size()) {
+        update_in_.guardians_coords[delta.guardians_moved[i]] = delta.guardians_coords[i];
+      }
+    }
+
+    return;
+  }}}
 }
 
 
@@ -17,6 +17,8 @@
  ~ ~~~[ HEADER FILES ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ ~
  * ****************************************************************************************************************** */
 
+#include <deque>
+
 #include "abc_connection.hh"
 #include "client_globals.hh"
 
@@ -25,6 +27,8 @@
  * ****************************************************************************************************************** */
 
 namespace client {
+  class game_connection;
+
   class tcp_connection : public ABC::connection {
       // Messages timeout timers:
       boost::asio::deadline_timer                   timeout_in_;
@@ -41,9 +45,19 @@ namespace client {
 
       boost::barrier                                &init_barrier_;
       boost::mutex                                  output_mutex_;
+      protocol::message                             SYN_packet_;
       protocol::message                             HELLO_packet_;
       protocol::message                             FIN_packet_;
 
+      // Frames' buffers & game connection used when the game channel is multiplexed (MUX) over this connection:
+      protocol::frame                               frame_in_;
+      std::deque<protocol::frame>                   frames_out_;
+      bool                                          frames_sending_ {false};
+      bool                                          multiplexed_ {false};
+
+      client::game_connection                       *p_game_connect_ {NULL};
+      boost::mutex                                  game_mutex_;
+
       client::settings_tuple                        &settings_;
 
       // // // // // // // // // // //
@@ -68,12 +82,22 @@ namespace client {
 
       // // // // // // // // // // //
 
+      bool frame_unpack();
+      void frame_send();
+      void frame_send_handler(const boost::system::error_code &error, bool lobby_frame);
+
+      // // // // // // // // // // //
+
       void asio_loops_start();
 
     public:
       bool connect() override;
       bool disconnect() override;
+      bool multiplexed();
       void async_send(const protocol::message &msg);
+      void async_send(const protocol::command &cmd);
+      void game_attach(client::game_connection *p_game_connect);
+      void game_detach();
       tcp_connection(client::settings_tuple &settings, protocol::message &msg_storage,
                      boost::condition_variable &action_req, boost::mutex &action_req_mutex, bool &flag,
                      boost::barrier &barrier);
@@ -95,6 +119,9 @@ namespace client {
 
       std::string                                   auth_key_;
 
+      // Lobby connection used instead of the own one, when the game channel is multiplexed:
+      client::tcp_connection                        *p_lobby_connect_ {NULL};
+
       // // // // // // // // // // //
       
       void communication_start();
@@ -104,17 +131,24 @@ namespace client {
       void async_receive_handler(const boost::system::error_code &error);
 
       void async_send_handler(const boost::system::error_code &error);
+
+      void update_apply(const protocol::update &delta);
       
     public:
       game_connection(const std::string &IP_address, const std::string &port, const std::string &auth_key,
                       protocol::update &update_storage, boost::condition_variable &update_cond_var,
                       boost::mutex &update_mutex, boost::condition_variable &error_cond_var, boost::mutex &error_mutex,
                       protocol::message &error_msg_storage, bool &error_flag);
+      game_connection(client::tcp_connection *p_lobby_connect, protocol::update &update_storage,
+                      boost::condition_variable &update_cond_var, boost::mutex &update_mutex,
+                      boost::condition_variable &error_cond_var, boost::mutex &error_mutex,
+                      protocol::message &error_msg_storage, bool &error_flag);
      ~game_connection();
 
       bool connect() override;
       bool disconnect() override;
       void async_send(const protocol::command &cmd);
+      void update_received(const protocol::update &upd);
   };
 
 }
@@ -26,13 +26,33 @@ namespace client {
   game_instance::game_instance(const std::string IP_address, const std::string port, const std::string auth_key,
                                const std::string maze_scheme, const std::string maze_rows, const std::string maze_cols,
                                boost::condition_variable &mediator_cv, boost::mutex &mediator_mutex,
-                               protocol::message &mediator_message_in, bool &mediator_message_flag) :
-    maze_scheme_{maze_scheme}
+                               protocol::message &mediator_message_in, bool &mediator_message_flag,
+                               client::tcp_connection *p_lobby_connect) :
+    maze_scheme_{maze_scheme},
+    maze_rows_{static_cast<signed char>(std::stoi(maze_rows))},
+    maze_cols_{static_cast<signed char>(std::stoi(maze_cols))},
+    slides_(maze_rows_, maze_cols_)
   {{{
-    maze_rows_ = static_cast<signed char>(std::stoi(maze_rows));
-    maze_cols_ = static_cast<signed char>(std::stoi(maze_cols));
     output_string_ = maze_scheme_;
 
+    // Walls & gates are in the scheme, keys are received with the updates:
+    for (signed char row = 0; row < maze_rows_; row++) {
+      for (signed char col = 0; col < maze_cols_; col++) {
+        char block = maze_scheme_[(row * maze_cols_ * 2) + (col * 2)];
+        slides_.set_blocked(row, col, block == 'X' || block == '~');
+      }
+    }
+
+    slides_.build();
+
+    // Game channel multiplexed over the lobby connection doesn't need its own connection:
+    if (p_lobby_connect != NULL) {
+      p_game_conn_ = new client::game_connection(p_lobby_connect, update_in_, update_in_new_, update_in_mutex_,
+                                                 mediator_cv, mediator_mutex, mediator_message_in,
+                                                 mediator_message_flag);
+      return;
+    }
+
     p_game_conn_ = new client::game_connection(IP_address, port, auth_key, update_in_, update_in_new_, update_in_mutex_,
                                                mediator_cv, mediator_mutex, mediator_message_in, mediator_message_flag);
     return;
@@ -85,6 +105,27 @@ namespace client {
   }}}
 
 
+  /**
+   * Predicts where the player's slide ends, when it keeps moving in the given direction.
+   *
+   * @param[in]   coords      Actual coordinates of the player.
+   * @param[in]   direction   One of the LEFT, RIGHT, UP or DOWN commands.
+   * @return      Coordinates where the player stops | the given coordinates for the other commands.
+   */
+  std::pair<signed char, signed char> game_instance::slide_end(std::pair<signed char, signed char> coords,
+                                                               protocol::E_user_command direction)
+  {{{
+    if (direction != protocol::LEFT && direction != protocol::RIGHT && direction != protocol::UP &&
+        direction != protocol::DOWN) {
+      return coords;
+    }
+
+    boost::lock_guard<boost::mutex> update_in_lock(update_in_mutex_);
+
+    return slides_.slide_end(coords.first, coords.second, static_cast<game::slide_table::E_direction>(direction));
+  }}}
+
+
   void game_instance::process_updates()
   {{{
     boost::unique_lock<boost::mutex> update_in_lock(update_in_mutex_);
@@ -112,14 +153,22 @@ namespace client {
 
     output_string_ = maze_scheme_;
 
+    for (auto coords : keys_coords_) {
+      slides_.set_blocked(coords.first, coords.second, false);
+    }
+
     for (auto coords : update_in_.opened_gates_coords) {
       output_string_[(coords.first * maze_cols_ * 2) + (coords.second * 2)] = ' ';
+      slides_.set_blocked(coords.first, coords.second, false);
     }
 
     for (auto coords : update_in_.keys_coords) {
       output_string_[(coords.first * maze_cols_ * 2) + (coords.second * 2)] = '*';
+      slides_.set_blocked(coords.first, coords.second, true);
     }
 
+    keys_coords_ = update_in_.keys_coords;
+
     for (auto coords : update_in_.players_coords) {
       linear_pos = (coords.first * maze_cols_ * 2) + (coords.second * 2);
       player_num++;
@@ -24,6 +24,7 @@
 #include <boost/thread.hpp>
 
 #include "../protocol.hh"
+#include "../slide_table.hh"
 #include "client_globals.hh"
 #include "client_connections.hh"
 
@@ -46,6 +47,10 @@ namespace client {
       signed char                       maze_rows_;
       signed char                       maze_cols_;
 
+      // Slide lengths of the maze, patched by the gates & keys of the updates:
+      game::slide_table                 slides_;
+      std::vector<std::pair<signed char, signed char>> keys_coords_;
+
       protocol::update                  update_in_;
       boost::condition_variable         update_in_new_;
       boost::mutex                      update_in_mutex_;
@@ -63,13 +68,16 @@ namespace client {
       game_instance(const std::string IP_address, const std::string port, const std::string auth_key,
                     const std::string maze_scheme, const std::string maze_rows, const std::string maze_cols,
                     boost::condition_variable &mediator_cv, boost::mutex &mediator_mutex,
-                    protocol::message &mediator_message_in, bool &mediator_message_flag);
+                    protocol::message &mediator_message_in, bool &mediator_message_flag,
+                    client::tcp_connection *p_lobby_connect = NULL);
      ~game_instance();
       
       bool run();
       void stop();
 
       void send_command(const protocol::command &cmd);
+      std::pair<signed char, signed char> slide_end(std::pair<signed char, signed char> coords,
+                                                    protocol::E_user_command direction);
       
       std::string get_rows();
       std::string get_cols();
@@ -682,7 +682,8 @@ namespace client {
 
     p_game_instance_ = new game_instance(std::get<IPv4_ADDRESS>(settings_), message_in_.data[0], message_in_.data[1],
                                          message_in_.data[2], message_in_.data[3], message_in_.data[4],
-                                         action_req_, action_req_mutex_, message_in_, new_message_flag_);
+                                         action_req_, action_req_mutex_, message_in_, new_message_flag_,
+                                         (p_tcp_connect_->multiplexed() == true) ? p_tcp_connect_ : NULL);
 
     if (p_game_instance_->run() == false) {
       display_error("Connection to server's game instance failed");
@@ -731,7 +732,8 @@ namespace client {
 
     p_game_instance_ = new game_instance(std::get<IPv4_ADDRESS>(settings_), message_in_.data[0], message_in_.data[1],
                                          message_in_.data[2], message_in_.data[3], message_in_.data[4],
-                                         action_req_, action_req_mutex_, message_in_, new_message_flag_);
+                                         action_req_, action_req_mutex_, message_in_, new_message_flag_,
+                                         (p_tcp_connect_->multiplexed() == true) ? p_tcp_connect_ : NULL);
 
     if (p_game_instance_->run() == false) {
       display_error("Connection to server's game instance failed");
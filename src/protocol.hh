@@ -39,25 +39,51 @@ namespace protocol {
     POSSIBLE,
     NOT_POSSIBLE,
   };
+
+  enum E_update_type {
+    KEYFRAME = 0,
+    DELTA,
+  };
   
   /**
-   * Update message send to client's game instance: 
+   * Update message send to client's game instance. KEYFRAME contains the whole state of the game. DELTA contains only
+   * the changes since the previous update sent to the client, it's used only when negotiated during the HANDSHAKE:
+   * @li opened_gates_coords - gates opened since the previous update
+   * @li keys_coords & taken_keys_coords - keys placed & taken since the previous update
+   * @li players_coords & guardians_coords - new coordinates of the players & guardians with indexes listed in the
+   *     players_moved & guardians_moved respectively
+   *
+   * @note The last_move is serialized last, so the rest of the update can be encoded only once for all the players.
    */
   struct update {
+    enum E_update_type                                type {KEYFRAME};
     enum E_move_result                                last_move;
     std::vector<std::pair<signed char, signed char>>  opened_gates_coords;
     std::vector<std::pair<signed char, signed char>>  keys_coords;
     std::vector<std::pair<signed char, signed char>>  players_coords;
     std::vector<std::pair<signed char, signed char>>  guardians_coords;
 
+    std::vector<std::pair<signed char, signed char>>  taken_keys_coords;
+    std::vector<unsigned short>                       players_moved;
+    std::vector<unsigned short>                       guardians_moved;
+
     template <typename Archive>
     void serialize(Archive &ar, const unsigned int version __attribute__((unused)))
     {{{
-      ar & last_move;
+      ar & type;
       ar & keys_coords;
       ar & opened_gates_coords;
       ar & players_coords;
       ar & guardians_coords;
+
+      if (type == DELTA) {
+        ar & taken_keys_coords;
+        ar & players_moved;
+        ar & guardians_moved;
+      }
+
+      ar & last_move;
+
       return;
     }}}
   };
@@ -74,6 +100,7 @@ namespace protocol {
     TAKE_OPEN,
     START_CONTINUE,
     PAUSE,
+    KEYFRAME_REQUEST,               // Requests the KEYFRAME update, doesn't affect the player.
   };
   
   // Command issued by the player:
@@ -253,7 +280,7 @@ namespace protocol {
           break;
 
         default :
-          assert(false);    // You forgot to update serialization after updating the message!
+          // Unknown type received from the network, there's no subtype & the message is refused by receiver:
           break;
       }
 
@@ -263,6 +290,73 @@ namespace protocol {
       return;
     }}}
   };
+
+  // // // // // // // // // // // // // // // //
+
+  // Capabilities requested by client within the SYN QUERY data and confirmed by server within the SYN ACK data:
+  #define PROTOCOL_MUX "MUX"        // Game updates & commands are multiplexed over the lobby connection.
+  #define PROTOCOL_BINARY "BIN"     // Binary format (binary_archive.hh) is used after the HANDSHAKE.
+  #define PROTOCOL_DELTA "DELTA"    // Game updates are sent as DELTA updates with periodic KEYFRAME updates.
+
+  // Parameters of the LIST_MAZES QUERY, given as "key=value" strings within the data. Without any parameters all the
+  // mazes' names are listed. With the parameters the ACK data holds "total=N" (number of all the matching mazes) and
+  // then one "name;rows;cols;keys;gates;guardians;reachable;bytes" string per maze of the requested page (only "name"
+  // for the maze which isn't valid - such mazes are never matched by the metadata parameters):
+  #define LIST_MAZES_PAGE "page"                      // Number of the page, starting from 0.
+  #define LIST_MAZES_PAGE_SIZE "page-size"            // Number of mazes per page, 1 - LIST_MAZES_PAGE_MAX.
+  #define LIST_MAZES_NAME "name"                      // Part of the maze's name.
+  #define LIST_MAZES_MIN_SIZE "min-size"              // Minimal number of both rows & columns.
+  #define LIST_MAZES_MAX_SIZE "max-size"              // Maximal number of both rows & columns.
+  #define LIST_MAZES_MAX_GUARDIANS "max-guardians"
+  #define LIST_MAZES_REACHABLE "reachable"            // 1 - only the mazes solvable by the 1st player.
+
+  #define LIST_MAZES_PAGE_DEFAULT 20U
+  #define LIST_MAZES_PAGE_MAX 100U
+
+  enum E_channel {
+    LOBBY = 0,
+    GAME_UPDATE,
+    GAME_COMMAND,
+  };
+
+  /**
+   *  Frame used instead of plain messages when the multiplexing has been negotiated during the HANDSHAKE. The channel
+   *  tag determines which of the structures is carried by the frame: lobby message (both directions), game update
+   *  (server to client) or game command (client to server).
+   */
+  struct frame {
+    enum E_channel channel;
+
+    message msg;
+    update  upd;
+    command cmd;
+
+    template <typename Archive>
+    void serialize(Archive &ar, const unsigned int version __attribute__((unused)))
+    {{{
+      ar & channel;
+
+      switch (channel) {
+        case LOBBY :
+          ar & msg;
+          break;
+
+        case GAME_UPDATE :
+          ar & upd;
+          break;
+
+        case GAME_COMMAND :
+          ar & cmd;
+          break;
+
+        default :
+          // Unknown channel received from the network, the payload is left out & the frame is dropped by receiver:
+          break;
+      }
+
+      return;
+    }}}
+  };
 }
 
 /* ****************************************************************************************************************** *
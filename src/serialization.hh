@@ -26,10 +26,13 @@
 #include <boost/shared_ptr.hpp>
 #include <boost/tuple/tuple.hpp>
 #include <iomanip>
+#include <memory>
 #include <string>
 #include <sstream>
 #include <vector>
 
+#include "binary_archive.hh"
+
 
 /* ****************************************************************************************************************** *
  ~ ~~~[ SERIALIZATION IMPLEMENTATION ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ ~
@@ -40,14 +43,25 @@ namespace protocol {
    *  Class for serialization over TCP. Each message sent using this connection consists of:
    *  @li An 8-byte header containing the length of the serialized data in hexadecimal.
    *  @li The serialized data. 
+   *
+   *  When the binary format has been negotiated, each message consists of:
+   *  @li A 4-byte header containing the length of the encoded data in little endian.
+   *  @li The data encoded by protocol::binary_oarchive.
    */
   class tcp_serialization {
       boost::asio::ip::tcp::socket &socket_;    // The socket to be used passed within constructor.
-      enum { header_length = 8 };               // The size of a fixed length header.
+      enum {
+        header_length = 8,                      // The size of a fixed length header.
+        binary_header_length = 4,               // The size of a fixed length header of binary format.
+      };
       std::string outbound_header_;             // Holds an outbound header.
       std::string outbound_data_;               // Holds the outbound data.
+      std::vector<char> outbound_buffer_;       // Holds the outbound header & data of binary format.
+      std::vector<char> outbound_suffix_;       // Holds the outbound suffix of shared data.
+      std::shared_ptr<const std::vector<char>> ps_outbound_shared_;   // Holds the shared data until they're sent.
       char inbound_header_[header_length];      // Holds an inbound header.
       std::vector<char> inbound_data_;          // Holds the inbound data.
+      bool binary_ {false};                     // Binary format is used instead of text archives.
 
     public:
       tcp_serialization(boost::asio::ip::tcp::socket &s) : socket_(s) {}
@@ -58,6 +72,23 @@ namespace protocol {
       }}}
 
 
+      /**
+       *  Switches between the text archives and the binary format for all next reads & writes. Both sides of the
+       *  connection have to switch at the same point of the communication.
+       */
+      void binary(bool enabled)
+      {{{
+        binary_ = enabled;
+        return;
+      }}}
+
+
+      bool binary() const
+      {{{
+        return binary_;
+      }}}
+
+
       /**
        *  Asynchronously writes a data structure to the socket.
        *  Requires a handler which will be called upon finished successful data write.
@@ -65,6 +96,21 @@ namespace protocol {
       template <typename T, typename Handler>
       void async_write(const T& t, Handler handler)
       {{{
+        if (binary_ == true) {
+          // Encoding the data right behind the space reserved for header, reusing the buffer's memory:
+          outbound_buffer_.resize(binary_header_length);
+          protocol::binary_oarchive archive(outbound_buffer_);
+          archive << t;
+
+          std::size_t data_size = outbound_buffer_.size() - binary_header_length;
+
+          for (unsigned i = 0; i < binary_header_length; i++) {
+            outbound_buffer_[i] = static_cast<char>(data_size >> (8 * i));
+          }
+
+          boost::asio::async_write(socket_, boost::asio::buffer(outbound_buffer_), handler);
+          return;
+        }
 
         // Serializing the data to get their's size:.
         std::ostringstream archive_stream;
@@ -96,6 +142,59 @@ namespace protocol {
       }}}
 
 
+      /**
+       *  Encodes the data structure in binary format, so it can be sent by async_write_shared() over multiple
+       *  connections. The encoded data of given length at the end of the structure are left out, every connection
+       *  sends its own suffix instead of them. The suffix has to be always encoded to the same length.
+       *
+       *  @return Header & encoded data without the suffix.
+       */
+      template <typename T>
+      static std::shared_ptr<const std::vector<char>> encode_shared(const T &t, std::size_t suffix_length)
+      {{{
+        std::shared_ptr<std::vector<char>> ps_data(new std::vector<char>(binary_header_length));
+
+        protocol::binary_oarchive archive(*ps_data);
+        archive << t;
+
+        std::size_t data_size = ps_data->size() - binary_header_length;
+
+        for (unsigned i = 0; i < binary_header_length; i++) {
+          (*ps_data)[i] = static_cast<char>(data_size >> (8 * i));
+        }
+
+        assert(data_size >= suffix_length);
+        ps_data->resize(ps_data->size() - suffix_length);
+
+        return ps_data;
+      }}}
+
+
+      /**
+       *  Asynchronously writes the shared data encoded by encode_shared() followed by the suffix of this connection in
+       *  single operation via "gather-write". Can be used only when the binary format is used.
+       */
+      template <typename T, typename Handler>
+      void async_write_shared(const std::shared_ptr<const std::vector<char>> &ps_data, const T &suffix,
+                              Handler handler)
+      {{{
+        assert(binary_ == true);
+
+        ps_outbound_shared_ = ps_data;  // Keep the shared data alive until they're written.
+
+        outbound_suffix_.clear();
+        protocol::binary_oarchive archive(outbound_suffix_);
+        archive << suffix;
+
+        std::vector<boost::asio::const_buffer> buffers;
+        buffers.push_back(boost::asio::buffer(*ps_outbound_shared_));
+        buffers.push_back(boost::asio::buffer(outbound_suffix_));
+        boost::asio::async_write(socket_, buffers, handler);
+
+        return;
+      }}}
+
+
       /**
        *  Asynchronous read of data structure from the socket.
        *  Requires a handler which will be called upon data arriving.
@@ -107,7 +206,9 @@ namespace protocol {
         void (tcp_serialization::*f)(const boost::system::error_code&, T&, boost::tuple<Handler>)
           = &tcp_serialization::handle_read_header<T, Handler>;
 
-        boost::asio::async_read(socket_, boost::asio::buffer(inbound_header_),
+        std::size_t length = (binary_ == true) ? binary_header_length : header_length;
+
+        boost::asio::async_read(socket_, boost::asio::buffer(inbound_header_, length),
                                 boost::bind(f, this, boost::asio::placeholders::error, boost::ref(t),
                                             boost::make_tuple(handler)));
 
@@ -126,14 +227,22 @@ namespace protocol {
         }
         else {
           // Determine the length of the serialized data:
-          std::istringstream is(std::string(inbound_header_, header_length));
           std::size_t inbound_data_size = 0;
 
-          if (!(is >> std::hex >> inbound_data_size)) {
-            // Header doesn't seem to be valid. Inform the caller:
-            boost::system::error_code error(boost::asio::error::invalid_argument);
-            boost::get<0>(handler)(error);
-            return;
+          if (binary_ == true) {
+            for (unsigned i = 0; i < binary_header_length; i++) {
+              inbound_data_size |= static_cast<std::size_t>(static_cast<unsigned char>(inbound_header_[i])) << (8 * i);
+            }
+          }
+          else {
+            std::istringstream is(std::string(inbound_header_, header_length));
+
+            if (!(is >> std::hex >> inbound_data_size)) {
+              // Header doesn't seem to be valid. Inform the caller:
+              boost::system::error_code error(boost::asio::error::invalid_argument);
+              boost::get<0>(handler)(error);
+              return;
+            }
           }
 
           // Starting an asynchronous call to receive the data:
@@ -162,10 +271,17 @@ namespace protocol {
         else {
           // Extract the data structure from the data just received:
           try {
-            std::string archive_data(&inbound_data_[0], inbound_data_.size());
-            std::istringstream archive_stream(archive_data);
-            boost::archive::text_iarchive archive(archive_stream);
-            archive >> t;
+            if (binary_ == true) {
+              // Decoding in place, without copying the data:
+              protocol::binary_iarchive archive(inbound_data_.data(), inbound_data_.size());
+              archive >> t;
+            }
+            else {
+              std::string archive_data(&inbound_data_[0], inbound_data_.size());
+              std::istringstream archive_stream(archive_data);
+              boost::archive::text_iarchive archive(archive_stream);
+              archive >> t;
+            }
           }
           catch (std::exception& e) {
             // Unable to decode data:
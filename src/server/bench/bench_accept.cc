@@ -0,0 +1,258 @@
+/**
+ * @file      bench_accept.cc
+ * @author    Dee'Kej (David Kaspar - xkaspa34)
+ * @version   0.1
+ * @brief     Benchmark of the rate of connections (and requests) accepted by the running server daemon.
+ *
+ * @detailed  Opens the given number of connections to the server, keeping the given number of them open at once.
+ *            Every connection does the HANDSHAKE, sends the given number of HELLO requests (each waiting for its
+ *            response) and closes. Run it against the daemon started with --io-threads 0 (thread per connection) and
+ *            with --io-threads N (shared acceptor) to compare both models.
+ */
+
+/* ****************************************************************************************************************** *
+ * ***[ START OF BENCH_ACCEPT.CC ]*********************************************************************************** *
+ * ****************************************************************************************************************** */
+
+
+/* ****************************************************************************************************************** *
+ ~ ~~~[ HEADER FILES ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ ~
+ * ****************************************************************************************************************** */
+
+// C++ header files:
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Boost header files:
+#include <boost/asio.hpp>
+#include <boost/bind.hpp>
+#include <boost/program_options.hpp>
+
+// Program header files:
+#include "../../protocol.hh"
+#include "../../serialization.hh"
+
+
+/* ****************************************************************************************************************** *
+ ~ ~~~[ GLOBAL VARIABLES ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ ~
+ * ****************************************************************************************************************** */
+
+const std::string HELP_STRING =
+"This is the benchmark of connections accepted by the server daemon of MAZE-GAME application,\n"
+"which is the part from project of ICP course @ BUT FIT, Czech Republic, 2014.\n\n"
+"Usage:         bench_accept [options]\n\n"
+"Optional arguments";
+
+namespace asio = boost::asio;
+using     tcp = boost::asio::ip::tcp;
+
+
+/* ****************************************************************************************************************** *
+ ~ ~~~[ SESSION CLASS ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ ~
+ * ****************************************************************************************************************** */
+
+/**
+ * One client opening the connections to the server one after another, until all the connections are opened.
+ */
+class session {
+    tcp::socket                         socket_;
+    protocol::tcp_serialization         tcp_connect_;
+    tcp::endpoint                       endpoint_;
+
+    std::vector<protocol::message>      messages_;
+    unsigned                            requests_;
+    unsigned                            requests_left_ {0};
+
+    unsigned long                       &connects_left_;
+    unsigned long                       &failures_;
+
+  public:
+    session(asio::io_service &io_service, tcp::endpoint endpoint, unsigned requests, unsigned long &connects_left,
+            unsigned long &failures) :
+      socket_{io_service}, tcp_connect_{socket_}, endpoint_{endpoint}, requests_{requests},
+      connects_left_(connects_left), failures_(failures)
+    {{{
+      return;
+    }}}
+
+    /**
+     * Opens the next connection, if there's any left.
+     */
+    void start()
+    {{{
+      if (connects_left_ == 0) {
+        return;
+      }
+
+      connects_left_--;
+      requests_left_ = requests_;
+
+      socket_.async_connect(endpoint_, boost::bind(&session::handle_connect, this, asio::placeholders::error));
+      return;
+    }}}
+
+  private:
+    void handle_connect(const boost::system::error_code &error)
+    {{{
+      if (error) {
+        return failed();
+      }
+
+      send(true);
+      return;
+    }}}
+
+
+    /**
+     * Sends the HANDSHAKE or HELLO request, its response is received afterwards.
+     */
+    void send(bool handshake)
+    {{{
+      messages_.assign(1, protocol::message());
+
+      if (handshake == true) {
+        messages_[0].type = protocol::CTRL;
+        messages_[0].ctrl_type = protocol::SYN;
+      }
+      else {
+        messages_[0].type = protocol::INFO;
+        messages_[0].info_type = protocol::HELLO;
+      }
+
+      messages_[0].status = protocol::QUERY;
+
+      tcp_connect_.async_write(messages_, boost::bind(&session::handle_write, this, asio::placeholders::error));
+      return;
+    }}}
+
+
+    void handle_write(const boost::system::error_code &error)
+    {{{
+      if (error) {
+        return failed();
+      }
+
+      tcp_connect_.async_read(messages_, boost::bind(&session::handle_read, this, asio::placeholders::error));
+      return;
+    }}}
+
+
+    void handle_read(const boost::system::error_code &error)
+    {{{
+      if (error || messages_.size() != 1 || messages_[0].status != protocol::ACK) {
+        return failed();
+      }
+
+      if (requests_left_ > 0) {
+        requests_left_--;
+        send(false);
+        return;
+      }
+
+      close();
+      start();
+      return;
+    }}}
+
+
+    void failed()
+    {{{
+      failures_++;
+      close();
+      start();
+      return;
+    }}}
+
+
+    void close()
+    {{{
+      boost::system::error_code ignored_error;
+      socket_.shutdown(tcp::socket::shutdown_both, ignored_error);
+      socket_.close(ignored_error);
+      return;
+    }}}
+};
+
+
+/* ****************************************************************************************************************** *
+ ~ ~~~[ MAIN FUNCTION ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ ~
+ * ****************************************************************************************************************** */
+
+int main(int argc, char *argv[])
+{{{
+  std::string     host;
+  unsigned short  port;
+  unsigned long   connects;
+  unsigned        clients;
+  unsigned        requests;
+
+  try {
+    namespace params = boost::program_options;
+
+    params::options_description help(HELP_STRING, 120);
+    help.add_options() ("help,h", "show this message and exit");
+    help.add_options() ("host", params::value<std::string>(&host)->default_value("127.0.0.1"),
+                        "address of the server daemon (default: 127.0.0.1)");
+    help.add_options() ("port,p", params::value<unsigned short>(&port)->default_value(49429),
+                        "port of the server daemon (default: 49429)");
+    help.add_options() ("connections,n", params::value<unsigned long>(&connects)->default_value(10000),
+                        "number of connections opened in total (default: 10000)");
+    help.add_options() ("clients,c", params::value<unsigned>(&clients)->default_value(16),
+                        "number of connections opened at once (default: 16)");
+    help.add_options() ("requests,r", params::value<unsigned>(&requests)->default_value(0),
+                        "number of HELLO requests sent over every connection (default: 0)");
+
+    params::variables_map options;
+    params::store(params::parse_command_line(argc, argv, help), options);
+    params::notify(options);
+
+    if (options.count("help")) {
+      std::cout << help << std::endl;
+      return 0;
+    }
+
+    asio::io_service io_service;
+    tcp::endpoint endpoint(asio::ip::address::from_string(host), port);
+    std::vector<std::unique_ptr<session>> sessions;
+    unsigned long connects_left {connects};
+    unsigned long failures {0};
+
+    for (unsigned i = 0; i < clients; i++) {
+      sessions.emplace_back(new session(io_service, endpoint, requests, connects_left, failures));
+    }
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    std::vector<std::unique_ptr<session>>::iterator it_session;
+
+    for (it_session = sessions.begin(); it_session != sessions.end(); it_session++) {
+      (*it_session)->start();
+    }
+
+    io_service.run();
+
+    std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+    double seconds = std::chrono::duration<double>(end - start).count();
+
+    std::cout << "Connections:     " << connects - failures << " of " << connects << std::endl;
+    std::cout << "Time:            " << static_cast<unsigned long>(seconds * 1000) << " ms" << std::endl;
+    std::cout << "Connections/s:   " << static_cast<unsigned long>((connects - failures) / seconds) << std::endl;
+
+    if (requests > 0) {
+      std::cout << "Requests/s:      " << static_cast<unsigned long>((connects - failures) * requests / seconds)
+                << std::endl;
+    }
+
+    return (failures == 0) ? 0 : 1;
+  }
+  catch (std::exception &e) {
+    std::cerr << "bench_accept: " << e.what() << std::endl;
+    return 1;
+  }
+}}}
+
+/* ****************************************************************************************************************** *
+ * ***[ END OF BENCH_ACCEPT.CC ]************************************************************************************* *
+ * ****************************************************************************************************************** */
@@ -0,0 +1,207 @@
+/**
+ * @file      bench_codec.cc
+ * @author    Dee'Kej (David Kaspar - xkaspa34)
+ * @version   0.1
+ * @brief     Microbenchmark of encoding & decoding of the protocol's structures by the text & binary archives.
+ *
+ * @detailed  Every structure (lobby message, game update and game command) is encoded and decoded the same way the
+ *            protocol::tcp_serialization does it: by the Boost's text archives through the string streams, and by the
+ *            binary archives into the reused buffer & in place from it. The size of the encoded data and the time of
+ *            one encoding/decoding is printed for both formats.
+ */
+
+/* ****************************************************************************************************************** *
+ * ***[ START OF BENCH_CODEC.CC ]************************************************************************************ *
+ * ****************************************************************************************************************** */
+
+
+/* ****************************************************************************************************************** *
+ ~ ~~~[ HEADER FILES ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ ~
+ * ****************************************************************************************************************** */
+
+// C++ header files:
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Boost header files:
+#include <boost/archive/text_iarchive.hpp>
+#include <boost/archive/text_oarchive.hpp>
+#include <boost/program_options.hpp>
+
+// Program header files:
+#include "../../binary_archive.hh"
+#include "../../protocol.hh"
+
+
+/* ****************************************************************************************************************** *
+ ~ ~~~[ GLOBAL VARIABLES ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ ~
+ * ****************************************************************************************************************** */
+
+const std::string HELP_STRING =
+"This is the benchmark of the protocol's formats of MAZE-GAME application,\n"
+"which is the part from project of ICP course @ BUT FIT, Czech Republic, 2014.\n\n"
+"Usage:         bench_codec [options]\n\n"
+"Optional arguments";
+
+using bench_clock = std::chrono::steady_clock;
+
+
+/* ****************************************************************************************************************** *
+ ~ ~~~[ AUXILIARY FUNCTIONS ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ ~
+ * ****************************************************************************************************************** */
+
+/**
+ * @return  Time in ns of one iteration since the given start.
+ */
+double ns_per_iteration(bench_clock::time_point start, unsigned long iterations)
+{{{
+  return std::chrono::duration<double, std::nano>(bench_clock::now() - start).count() / iterations;
+}}}
+
+
+/**
+ * Encodes & decodes the given structure by both formats and prints the results.
+ */
+template <typename T>
+void measure(const std::string &name, const T &t, unsigned long iterations)
+{{{
+  std::string text_data;
+  std::vector<char> binary_data;
+  T decoded;
+
+  // Text archives, the same way as the tcp_serialization is using them:
+  bench_clock::time_point start = bench_clock::now();
+
+  for (unsigned long i = 0; i < iterations; i++) {
+    std::ostringstream archive_stream;
+    boost::archive::text_oarchive archive(archive_stream);
+    archive << t;
+    text_data = archive_stream.str();
+  }
+
+  double text_encode = ns_per_iteration(start, iterations);
+  start = bench_clock::now();
+
+  for (unsigned long i = 0; i < iterations; i++) {
+    std::istringstream archive_stream(text_data);
+    boost::archive::text_iarchive archive(archive_stream);
+    archive >> decoded;
+  }
+
+  double text_decode = ns_per_iteration(start, iterations);
+
+  // Binary archives with the reused buffer & decoding in place:
+  start = bench_clock::now();
+
+  for (unsigned long i = 0; i < iterations; i++) {
+    binary_data.clear();
+    protocol::binary_oarchive archive(binary_data);
+    archive << t;
+  }
+
+  double binary_encode = ns_per_iteration(start, iterations);
+  start = bench_clock::now();
+
+  for (unsigned long i = 0; i < iterations; i++) {
+    protocol::binary_iarchive archive(binary_data.data(), binary_data.size());
+    archive >> decoded;
+  }
+
+  double binary_decode = ns_per_iteration(start, iterations);
+
+  std::cout << std::fixed << std::setprecision(0)
+            << std::left << std::setw(10) << name << std::right
+            << "  text: " << std::setw(5) << text_data.size() << " B  " << std::setw(7) << text_encode
+            << " ns encode  " << std::setw(7) << text_decode << " ns decode"
+            << "    binary: " << std::setw(5) << binary_data.size() << " B  " << std::setw(6) << binary_encode
+            << " ns encode  " << std::setw(6) << binary_decode << " ns decode" << std::endl;
+
+  return;
+}}}
+
+
+/* ****************************************************************************************************************** *
+ ~ ~~~[ MAIN FUNCTION ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ ~
+ * ****************************************************************************************************************** */
+
+int main(int argc, char *argv[])
+{{{
+  unsigned long iterations;
+
+  try {
+    namespace params = boost::program_options;
+
+    params::options_description help(HELP_STRING, 120);
+    help.add_options() ("help,h", "show this message and exit");
+    help.add_options() ("iterations,n", params::value<unsigned long>(&iterations)->default_value(100000),
+                        "number of encodings & decodings of every structure (default: 100000)");
+
+    params::variables_map options;
+    params::store(params::parse_command_line(argc, argv, help), options);
+    params::notify(options);
+
+    if (options.count("help") || iterations == 0) {
+      std::cout << help << std::endl;
+      return 0;
+    }
+
+    // Lobby message listing the mazes:
+    protocol::message msg;
+
+    msg.type = protocol::CTRL;
+    msg.ctrl_type = protocol::LIST_MAZES;
+    msg.status = protocol::ACK;
+
+    for (unsigned i = 0; i < 20; i++) {
+      msg.data.push_back("maze_" + std::to_string(i) + ".maze");
+    }
+
+    // KEYFRAME update of the game with 4 players & 8 guardians:
+    protocol::update upd;
+
+    upd.type = protocol::KEYFRAME;
+    upd.last_move = protocol::POSSIBLE;
+
+    for (signed char i = 0; i < 4; i++) {
+      upd.players_coords.push_back(std::make_pair(i, static_cast<signed char>(i + 1)));
+      upd.keys_coords.push_back(std::make_pair(static_cast<signed char>(i + 10), i));
+      upd.opened_gates_coords.push_back(std::make_pair(i, static_cast<signed char>(i + 20)));
+    }
+
+    for (signed char i = 0; i < 8; i++) {
+      upd.guardians_coords.push_back(std::make_pair(static_cast<signed char>(2 * i), static_cast<signed char>(i)));
+    }
+
+    // DELTA update with one guardian moved:
+    protocol::update delta;
+
+    delta.type = protocol::DELTA;
+    delta.last_move = protocol::POSSIBLE;
+    delta.guardians_coords.push_back(std::make_pair(3, 4));
+    delta.guardians_moved.push_back(2);
+
+    // Game command:
+    protocol::command cmd;
+
+    cmd.cmd = protocol::LEFT;
+
+    measure("message", msg, iterations);
+    measure("keyframe", upd, iterations);
+    measure("delta", delta, iterations);
+    measure("command", cmd, iterations);
+
+    return 0;
+  }
+  catch (std::exception &e) {
+    std::cerr << "bench_codec: " << e.what() << std::endl;
+    return 1;
+  }
+}}}
+
+/* ****************************************************************************************************************** *
+ * ***[ END OF BENCH_CODEC.CC ]************************************************************************************** *
+ * ****************************************************************************************************************** */
@@ -0,0 +1,153 @@
+/**
+ * @file      bench_create.cc
+ * @author    Dee'Kej (David Kaspar - xkaspa34)
+ * @version   0.1
+ * @brief     Benchmark of the maze creation done upon the CREATE_GAME.
+ *
+ * @detailed  The new maze of the given name is created repeatedly, first by parsing the maze file every time (as it was
+ *            done before the mazes_manager cached the templates of the mazes), then by the mazes_manager::load_maze().
+ *            The latency of one creation is printed for both, together with the hits & misses of the templates cache.
+ */
+
+/* ****************************************************************************************************************** *
+ * ***[ START OF BENCH_CREATE.CC ]*********************************************************************************** *
+ * ****************************************************************************************************************** */
+
+
+/* ****************************************************************************************************************** *
+ ~ ~~~[ HEADER FILES ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ ~
+ * ****************************************************************************************************************** */
+
+// C++ header files:
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <tuple>
+
+// Boost header files:
+#include <boost/filesystem.hpp>
+#include <boost/program_options.hpp>
+
+// Program header files:
+#include "../mazed_globals.hh"
+#include "../mazed_maze_file.hh"
+#include "../mazed_mazes_manager.hh"
+
+
+/* ****************************************************************************************************************** *
+ ~ ~~~[ GLOBAL VARIABLES ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ ~
+ * ****************************************************************************************************************** */
+
+const std::string HELP_STRING =
+"This is the benchmark of the maze creation of MAZE-GAME application,\n"
+"which is the part from project of ICP course @ BUT FIT, Czech Republic, 2014.\n\n"
+"Usage:         bench_create [options] MAZE\n\n"
+"Optional arguments";
+
+
+/* ****************************************************************************************************************** *
+ ~ ~~~[ MAIN FUNCTION ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ ~
+ * ****************************************************************************************************************** */
+
+int main(int argc, char *argv[])
+{{{
+  unsigned long creates_num;
+  std::string   mazes_folder;
+  std::string   mazes_ext;
+  std::string   maze_name;
+
+  try {
+    namespace params = boost::program_options;
+
+    params::options_description help(HELP_STRING, 120);
+    help.add_options() ("help,h", "show this message and exit");
+    help.add_options() ("creates,n", params::value<unsigned long>(&creates_num)->default_value(10000),
+                        "number of the mazes created (default: 10000)");
+    help.add_options() ("mazes-folder,m", params::value<std::string>(&mazes_folder)->default_value("examples"),
+                        "folder with the mazes (default: examples)");
+    help.add_options() ("mazes-ext", params::value<std::string>(&mazes_ext)->default_value(".maze"),
+                        "extension of the mazes (default: .maze)");
+
+    params::options_description hidden;
+    hidden.add_options() ("maze", params::value<std::string>(&maze_name));
+
+    params::options_description all;
+    all.add(help).add(hidden);
+
+    params::positional_options_description positional;
+    positional.add("maze", 1);
+
+    params::variables_map options;
+    params::store(params::command_line_parser(argc, argv).options(all).positional(positional).run(), options);
+    params::notify(options);
+
+    if (options.count("help") || maze_name.empty() == true) {
+      std::cout << help << std::endl;
+      return (maze_name.empty() == true && !options.count("help")) ? 1 : 0;
+    }
+
+    mazed::settings_tuple settings;
+
+    std::get<mazed::DAEMON_FOLDER>(settings) = boost::filesystem::current_path();
+    std::get<mazed::MAZES_FOLDER>(settings) = mazes_folder;
+    std::get<mazed::MAZES_EXTENSION>(settings) = mazes_ext;
+    std::get<mazed::SAVES_FOLDER>(settings) = mazes_folder;
+    std::get<mazed::SAVES_EXTENSION>(settings) = ".save";
+
+    mazed::mazes_manager manager(settings);
+    std::string maze_path = (boost::filesystem::path(mazes_folder) / maze_name).string();
+    std::unique_ptr<game::maze> pu_maze;
+
+    // Parsing the maze file for every new maze:
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    for (unsigned long i = 0; i < creates_num; i++) {
+      std::ifstream maze_file(maze_path);
+      std::shared_ptr<const game::maze_layout> ps_layout(mazed::maze_file::parse(maze_file));
+
+      if (!ps_layout) {
+        std::cerr << "bench_create: " << maze_path << ": not a valid maze" << std::endl;
+        return 1;
+      }
+
+      pu_maze.reset(new game::maze(ps_layout));
+    }
+
+    std::chrono::steady_clock::time_point parsed_end = std::chrono::steady_clock::now();
+
+    // Sharing the cached template of the maze:
+    for (unsigned long i = 0; i < creates_num; i++) {
+      pu_maze.reset(manager.load_maze(maze_name));
+
+      if (!pu_maze) {
+        std::cerr << "bench_create: " << maze_name << ": maze couldn't be loaded" << std::endl;
+        return 1;
+      }
+    }
+
+    std::chrono::steady_clock::time_point cached_end = std::chrono::steady_clock::now();
+    std::pair<unsigned long, unsigned long> stats = manager.templates_stats();
+
+    std::cout << "Mazes created:   " << creates_num << std::endl;
+    std::cout << "Parsed mazes:    "
+              << std::chrono::duration_cast<std::chrono::nanoseconds>(parsed_end - start).count() / creates_num
+              << " ns/create" << std::endl;
+    std::cout << "Cached mazes:    "
+              << std::chrono::duration_cast<std::chrono::nanoseconds>(cached_end - parsed_end).count() / creates_num
+              << " ns/create" << std::endl;
+    std::cout << "Cache hits:      " << stats.first << std::endl;
+    std::cout << "Cache misses:    " << stats.second << std::endl;
+
+    return 0;
+  }
+  catch (std::exception &e) {
+    std::cerr << "bench_create: " << e.what() << std::endl;
+    return 1;
+  }
+}}}
+
+/* ****************************************************************************************************************** *
+ * ***[ END OF BENCH_CREATE.CC ]************************************************************************************* *
+ * ****************************************************************************************************************** */
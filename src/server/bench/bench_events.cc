@@ -0,0 +1,228 @@
+/**
+ * @file      bench_events.cc
+ * @author    Dee'Kej (David Kaspar - xkaspa34)
+ * @version   0.1
+ * @brief     Benchmark of the distance fields' repair in the event-heavy games.
+ *
+ * @detailed  The gates & keys of the given maze are toggled at random (as being opened, taken & dropped) and the
+ *            distance fields towards the players' starts are updated after every event. The fields are repaired
+ *            around the changed block first, as the game::maze does, then computed again from scratch for the same
+ *            sequence of events. The time per event is printed for both, and the final fields have to be equal.
+ */
+
+/* ****************************************************************************************************************** *
+ * ***[ START OF BENCH_EVENTS.CC ]*********************************************************************************** *
+ * ****************************************************************************************************************** */
+
+
+/* ****************************************************************************************************************** *
+ ~ ~~~[ HEADER FILES ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ ~
+ * ****************************************************************************************************************** */
+
+// C++ header files:
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Boost header files:
+#include <boost/program_options.hpp>
+
+// Program header files:
+#include "../mazed_game_bitboard.hh"
+#include "../mazed_game_distance_fields.hh"
+#include "../mazed_game_maze.hh"
+#include "../mazed_maze_file.hh"
+
+
+/* ****************************************************************************************************************** *
+ ~ ~~~[ GLOBAL VARIABLES ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ ~
+ * ****************************************************************************************************************** */
+
+const std::string HELP_STRING =
+"This is the benchmark of the distance fields' repair of MAZE-GAME application,\n"
+"which is the part from project of ICP course @ BUT FIT, Czech Republic, 2014.\n\n"
+"Usage:         bench_events [options] MAZE_FILE\n\n"
+"Optional arguments";
+
+
+/* ****************************************************************************************************************** *
+ ~ ~~~[ AUXILIARY FUNCTIONS ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ ~
+ * ****************************************************************************************************************** */
+
+/**
+ * Toggles the blocks given by the same random sequence for every run and updates the fields after every event.
+ *
+ * @param[in]   repaired    true - the cached fields are repaired, false - they're computed again from scratch.
+ * @param[out]  results     Final fields towards the targets.
+ * @return      Duration of all the events.
+ */
+std::chrono::steady_clock::duration events_run(game::bitboard blocked, signed char rows_num, signed char cols_num,
+                                               const std::vector<std::pair<signed char, signed char>> &cells,
+                                               const std::vector<std::pair<signed char, signed char>> &targets,
+                                               unsigned long events_num, bool repaired,
+                                               std::vector<game::distance_fields::field> &results)
+{{{
+  std::vector<std::pair<signed char, signed char>>::const_iterator it_targets;
+  std::unique_ptr<game::distance_fields> pu_fields(new game::distance_fields(rows_num, cols_num));
+  unsigned random {2463534242U};                    // Xorshift, so the events are same for every run.
+
+  for (it_targets = targets.begin(); it_targets != targets.end(); it_targets++) {
+    pu_fields->get(blocked, *it_targets);
+  }
+
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+  for (unsigned long i = 0; i < events_num; i++) {
+    random ^= random << 13;
+    random ^= random >> 17;
+    random ^= random << 5;
+
+    const std::pair<signed char, signed char> &coords = cells[random % cells.size()];
+
+    if (blocked.test(coords.first, coords.second) == true) {
+      blocked.reset(coords.first, coords.second);
+    }
+    else {
+      blocked.set(coords.first, coords.second);
+    }
+
+    if (repaired == true) {
+      pu_fields->repair(blocked, coords);
+    }
+    else {
+      pu_fields.reset(new game::distance_fields(rows_num, cols_num));
+    }
+
+    for (it_targets = targets.begin(); it_targets != targets.end(); it_targets++) {
+      pu_fields->get(blocked, *it_targets);
+    }
+  }
+
+  std::chrono::steady_clock::duration elapsed = std::chrono::steady_clock::now() - start;
+
+  results.clear();
+
+  for (it_targets = targets.begin(); it_targets != targets.end(); it_targets++) {
+    results.push_back(*pu_fields->get(blocked, *it_targets));
+  }
+
+  return elapsed;
+}}}
+
+
+/* ****************************************************************************************************************** *
+ ~ ~~~[ MAIN FUNCTION ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ ~
+ * ****************************************************************************************************************** */
+
+int main(int argc, char *argv[])
+{{{
+  unsigned long events_num;
+  std::string   maze_path;
+
+  try {
+    namespace params = boost::program_options;
+
+    params::options_description help(HELP_STRING, 120);
+    help.add_options() ("help,h", "show this message and exit");
+    help.add_options() ("events,n", params::value<unsigned long>(&events_num)->default_value(100000),
+                        "number of the gates & keys toggled (default: 100000)");
+
+    params::options_description hidden;
+    hidden.add_options() ("maze", params::value<std::string>(&maze_path));
+
+    params::options_description all;
+    all.add(help).add(hidden);
+
+    params::positional_options_description positional;
+    positional.add("maze", 1);
+
+    params::variables_map options;
+    params::store(params::command_line_parser(argc, argv).options(all).positional(positional).run(), options);
+    params::notify(options);
+
+    if (options.count("help") || maze_path.empty() == true || events_num == 0) {
+      std::cout << help << std::endl;
+      return (maze_path.empty() == true && !options.count("help")) ? 1 : 0;
+    }
+
+    std::ifstream maze_file(maze_path);
+    std::shared_ptr<const game::maze_layout> ps_layout(mazed::maze_file::parse(maze_file));
+
+    if (!ps_layout) {
+      std::cerr << "bench_events: " << maze_path << ": not a valid maze" << std::endl;
+      return 1;
+    }
+
+    game::maze maze(ps_layout);
+    game::bitboard blocked;
+    std::vector<std::pair<signed char, signed char>> cells;
+    std::vector<std::pair<signed char, signed char>> targets;
+    signed char rows_num = ps_layout->get_rows();
+    signed char cols_num = ps_layout->get_cols();
+
+    // Blocked as the game::maze does it, only the gates & keys are changing:
+    for (signed char row = 0; row < rows_num; row++) {
+      for (signed char col = 0; col < cols_num; col++) {
+        switch (maze.block_get(row, col)) {
+          case game::block::GATE_CLOSED :
+          case game::block::KEY :
+            cells.push_back(std::make_pair(row, col));
+            blocked.set(row, col);
+            break;
+
+          case game::block::WALL :
+            blocked.set(row, col);
+            break;
+
+          default :
+            break;
+        }
+      }
+    }
+
+    if (cells.empty() == true) {
+      std::cerr << "bench_events: " << maze_path << ": maze has no gates nor keys" << std::endl;
+      return 1;
+    }
+
+    for (unsigned i = 0; i < GAME_MAX_PLAYERS; i++) {
+      targets.push_back(ps_layout->get_start_coords(i));
+    }
+
+    std::vector<game::distance_fields::field> repaired_fields;
+    std::vector<game::distance_fields::field> computed_fields;
+
+    std::chrono::steady_clock::duration repaired_time = events_run(blocked, rows_num, cols_num, cells, targets,
+                                                                    events_num, true, repaired_fields);
+    std::chrono::steady_clock::duration computed_time = events_run(blocked, rows_num, cols_num, cells, targets,
+                                                                    events_num, false, computed_fields);
+
+    if (repaired_fields != computed_fields) {
+      std::cerr << "bench_events: repaired fields differ from the computed ones" << std::endl;
+      return 1;
+    }
+
+    long repaired_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(repaired_time).count() / events_num;
+    long computed_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(computed_time).count() / events_num;
+
+    std::cout << "Events:          " << events_num << " (" << cells.size() << " gates & keys, " << targets.size()
+              << " fields)" << std::endl;
+    std::cout << "Repaired fields: " << repaired_ns << " ns/event" << std::endl;
+    std::cout << "Full recompute:  " << computed_ns << " ns/event" << std::endl;
+    std::cout << "Speedup:         " << static_cast<double>(computed_ns) / ((repaired_ns > 0) ? repaired_ns : 1)
+              << "x" << std::endl;
+
+    return 0;
+  }
+  catch (std::exception &e) {
+    std::cerr << "bench_events: " << e.what() << std::endl;
+    return 1;
+  }
+}}}
+
+/* ****************************************************************************************************************** *
+ * ***[ END OF BENCH_EVENTS.CC ]************************************************************************************* *
+ * ****************************************************************************************************************** */
@@ -0,0 +1,161 @@
+/**
+ * @file      bench_guardians.cc
+ * @author    Dee'Kej (David Kaspar - xkaspa34)
+ * @version   0.1
+ * @brief     Benchmark of the guardians' movement within the maze.
+ *
+ * @detailed  The maze is parsed & all its players walk randomly from their starting blocks, while every guardian of
+ *            the maze is moved towards the nearest player after every step of the players by the same call as used by
+ *            the game instance - maze::guardians_move(). The number of guardians moved per millisecond is printed.
+ */
+
+/* ****************************************************************************************************************** *
+ * ***[ START OF BENCH_GUARDIANS.CC ]******************************************************************************** *
+ * ****************************************************************************************************************** */
+
+
+/* ****************************************************************************************************************** *
+ ~ ~~~[ HEADER FILES ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ ~
+ * ****************************************************************************************************************** */
+
+// C++ header files:
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Boost header files:
+#include <boost/program_options.hpp>
+
+// Program header files:
+#include "../mazed_game_maze.hh"
+#include "../mazed_maze_file.hh"
+
+
+/* ****************************************************************************************************************** *
+ ~ ~~~[ GLOBAL VARIABLES ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ ~
+ * ****************************************************************************************************************** */
+
+const std::string HELP_STRING =
+"This is the benchmark of the guardians' movement of MAZE-GAME application,\n"
+"which is the part from project of ICP course @ BUT FIT, Czech Republic, 2014.\n\n"
+"Usage:         bench_guardians [options] MAZE_FILE\n\n"
+"Optional arguments";
+
+
+/* ****************************************************************************************************************** *
+ ~ ~~~[ MAIN FUNCTION ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ ~
+ * ****************************************************************************************************************** */
+
+int main(int argc, char *argv[])
+{{{
+  unsigned long ticks_num;
+  std::string   maze_path;
+
+  try {
+    namespace params = boost::program_options;
+
+    params::options_description help(HELP_STRING, 120);
+    help.add_options() ("help,h", "show this message and exit");
+    help.add_options() ("ticks,n", params::value<unsigned long>(&ticks_num)->default_value(1000000),
+                        "number of the ticks simulated (default: 1000000)");
+
+    params::options_description hidden;
+    hidden.add_options() ("maze", params::value<std::string>(&maze_path));
+
+    params::options_description all;
+    all.add(help).add(hidden);
+
+    params::positional_options_description positional;
+    positional.add("maze", 1);
+
+    params::variables_map options;
+    params::store(params::command_line_parser(argc, argv).options(all).positional(positional).run(), options);
+    params::notify(options);
+
+    if (options.count("help") || maze_path.empty() == true) {
+      std::cout << help << std::endl;
+      return (maze_path.empty() == true && !options.count("help")) ? 1 : 0;
+    }
+
+    std::ifstream maze_file(maze_path);
+    std::shared_ptr<const game::maze_layout> ps_layout(mazed::maze_file::parse(maze_file));
+
+    if (!ps_layout) {
+      std::cerr << "bench_guardians: " << maze_path << ": not a valid maze" << std::endl;
+      return 1;
+    }
+
+    game::maze maze(ps_layout);
+    std::vector<std::pair<signed char, signed char>> players;
+    signed char rows_num = ps_layout->get_rows();
+    signed char cols_num = ps_layout->get_cols();
+
+    for (unsigned i = 0; i < GAME_MAX_PLAYERS; i++) {
+      players.push_back(ps_layout->get_start_coords(i));
+    }
+
+    std::vector<std::pair<signed char, signed char>>::iterator it_players;
+    unsigned random {2463534242U};                  // Xorshift, so the directions are same for every run.
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    for (unsigned long i = 0; i < ticks_num; i++) {
+      for (it_players = players.begin(); it_players != players.end(); it_players++) {
+        random ^= random << 13;
+        random ^= random >> 17;
+        random ^= random << 5;
+
+        game::E_move direction = static_cast<game::E_move>(game::LEFT + (random & 3));
+
+        if (maze.is_move_possible(*it_players, direction) == false) {
+          continue;
+        }
+
+        switch (direction) {
+          case game::LEFT :
+            (*it_players).second = ((*it_players).second - 1) % cols_num;
+            break;
+
+          case game::RIGHT :
+            (*it_players).second = ((*it_players).second + 1) % cols_num;
+            break;
+
+          case game::UP :
+            (*it_players).first = ((*it_players).first - 1) % rows_num;
+            break;
+
+          case game::DOWN :
+            (*it_players).first = ((*it_players).first + 1) % rows_num;
+            break;
+
+          default :
+            break;
+        }
+      }
+
+      maze.guardians_move(players);
+    }
+
+    std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+    double milliseconds = std::chrono::duration<double, std::milli>(end - start).count();
+    unsigned long moved = ticks_num * ps_layout->get_guardians_num();
+
+    std::cout << "Ticks:           " << ticks_num << " (" << players.size() << " players, "
+              << ps_layout->get_guardians_num() << " guardians)" << std::endl;
+    std::cout << "Time:            " << static_cast<unsigned long>(milliseconds) << " ms" << std::endl;
+    std::cout << "Guardians/ms:    " << static_cast<unsigned long>(moved / milliseconds) << std::endl;
+
+    return 0;
+  }
+  catch (std::exception &e) {
+    std::cerr << "bench_guardians: " << e.what() << std::endl;
+    return 1;
+  }
+}}}
+
+/* ****************************************************************************************************************** *
+ * ***[ END OF BENCH_GUARDIANS.CC ]********************************************************************************** *
+ * ****************************************************************************************************************** */
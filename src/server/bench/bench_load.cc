@@ -0,0 +1,252 @@
+/**
+ * @file      bench_load.cc
+ * @author    Dee'Kej (David Kaspar - xkaspa34)
+ * @version   0.1
+ * @brief     Benchmark of the saved game loading done upon the LOAD_GAME.
+ *
+ * @detailed  The game of the given maze is saved once with half of its gates open, its keys & guardians at their
+ *            places and the players at their starts. The save is then loaded repeatedly the same way as the
+ *            mazes_manager::load_game() does it, without the reading of the file: the save is decoded, the new maze is
+ *            created from the cached template and the saved state is restored into it. The latency of every step and
+ *            of the whole load is printed.
+ */
+
+/* ****************************************************************************************************************** *
+ * ***[ START OF BENCH_LOAD.CC ]************************************************************************************* *
+ * ****************************************************************************************************************** */
+
+
+/* ****************************************************************************************************************** *
+ ~ ~~~[ HEADER FILES ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ ~
+ * ****************************************************************************************************************** */
+
+// C++ header files:
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <tuple>
+
+// Boost header files:
+#include <boost/filesystem.hpp>
+#include <boost/program_options.hpp>
+
+// Program header files:
+#include "../mazed_globals.hh"
+#include "../mazed_game_maze.hh"
+#include "../mazed_game_snapshot.hh"
+#include "../mazed_maze_file.hh"
+#include "../mazed_mazes_manager.hh"
+#include "../mazed_save_file.hh"
+
+
+/* ****************************************************************************************************************** *
+ ~ ~~~[ GLOBAL VARIABLES ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ ~
+ * ****************************************************************************************************************** */
+
+const std::string HELP_STRING =
+"This is the benchmark of the saved game loading of MAZE-GAME application,\n"
+"which is the part from project of ICP course @ BUT FIT, Czech Republic, 2014.\n\n"
+"Usage:         bench_load [options] MAZE\n\n"
+"Optional arguments";
+
+
+/* ****************************************************************************************************************** *
+ ~ ~~~[ AUXILIARY FUNCTIONS ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ ~
+ * ****************************************************************************************************************** */
+
+/**
+ * Takes the snapshot of the new game of the maze. The keys & gates are read from the maze, the guardians from the maze
+ * file, where every block is written as 2 characters below the line of dashes.
+ */
+game::snapshot snapshot_create(const std::shared_ptr<const game::maze_layout> &ps_layout, const std::string &maze_name,
+                               const std::string &maze_path)
+{{{
+  game::snapshot state;
+  game::maze maze(ps_layout);
+  bool gate_open {false};
+
+  state.maze_name = maze_name;
+  state.maze_fingerprint = ps_layout->get_fingerprint();
+  state.game_owner = "owner";
+  state.game_speed = 500;
+  state.ticks = 1000;
+
+  for (signed char row = 0; row < maze.get_rows(); row++) {
+    for (signed char col = 0; col < maze.get_cols(); col++) {
+      switch (maze.block_get(row, col)) {
+        case game::block::KEY :
+          state.keys.push_back(std::make_pair(row, col));
+          break;
+
+        case game::block::GATE_CLOSED :
+          if (gate_open == true) {
+            state.gates_open.push_back(std::make_pair(row, col));
+          }
+
+          gate_open = !gate_open;
+          break;
+
+        default :
+          break;
+      }
+    }
+  }
+
+  std::ifstream maze_file(maze_path);
+  std::string line;
+  signed char row {-1};
+
+  while (std::getline(maze_file, line)) {
+    if (row < 0) {
+      row = (line.empty() == false && line[0] == '-') ? 0 : -1;
+      continue;
+    }
+
+    for (std::size_t i = 0; i < line.size(); i += 2) {
+      if (line[i] == '@') {
+        state.guardians.push_back(std::make_pair(row, static_cast<signed char>(i / 2)));
+      }
+    }
+
+    row++;
+  }
+
+  for (unsigned i = 0; i < GAME_MAX_PLAYERS; i++) {
+    game::snapshot::player_state &player = state.players[i];
+
+    player.present = true;
+    player.nick = "player-" + std::to_string(i + 1);
+    player.coords = ps_layout->get_start_coords(i);
+    player.lifes = 3;
+    player.has_key = (i % 2 == 0);
+  }
+
+  return state;
+}}}
+
+
+/* ****************************************************************************************************************** *
+ ~ ~~~[ MAIN FUNCTION ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ ~
+ * ****************************************************************************************************************** */
+
+int main(int argc, char *argv[])
+{{{
+  unsigned long loads_num;
+  std::string   mazes_folder;
+  std::string   mazes_ext;
+  std::string   maze_name;
+
+  try {
+    namespace params = boost::program_options;
+
+    params::options_description help(HELP_STRING, 120);
+    help.add_options() ("help,h", "show this message and exit");
+    help.add_options() ("loads,n", params::value<unsigned long>(&loads_num)->default_value(100000),
+                        "number of the games loaded (default: 100000)");
+    help.add_options() ("mazes-folder,m", params::value<std::string>(&mazes_folder)->default_value("examples"),
+                        "folder with the mazes (default: examples)");
+    help.add_options() ("mazes-ext", params::value<std::string>(&mazes_ext)->default_value(".maze"),
+                        "extension of the mazes (default: .maze)");
+
+    params::options_description hidden;
+    hidden.add_options() ("maze", params::value<std::string>(&maze_name));
+
+    params::options_description all;
+    all.add(help).add(hidden);
+
+    params::positional_options_description positional;
+    positional.add("maze", 1);
+
+    params::variables_map options;
+    params::store(params::command_line_parser(argc, argv).options(all).positional(positional).run(), options);
+    params::notify(options);
+
+    if (options.count("help") || maze_name.empty() == true || loads_num == 0) {
+      std::cout << help << std::endl;
+      return (maze_name.empty() == true && !options.count("help")) ? 1 : 0;
+    }
+
+    mazed::settings_tuple settings;
+
+    std::get<mazed::DAEMON_FOLDER>(settings) = boost::filesystem::current_path();
+    std::get<mazed::MAZES_FOLDER>(settings) = mazes_folder;
+    std::get<mazed::MAZES_EXTENSION>(settings) = mazes_ext;
+    std::get<mazed::SAVES_FOLDER>(settings) = mazes_folder;
+    std::get<mazed::SAVES_EXTENSION>(settings) = ".save";
+
+    mazed::mazes_manager manager(settings);
+    std::string maze_path = (boost::filesystem::path(mazes_folder) / maze_name).string();
+    std::ifstream maze_file(maze_path);
+    std::shared_ptr<const game::maze_layout> ps_layout(mazed::maze_file::parse(maze_file));
+
+    if (!ps_layout) {
+      std::cerr << "bench_load: " << maze_path << ": not a valid maze" << std::endl;
+      return 1;
+    }
+
+    std::string content = mazed::save_file::encode(snapshot_create(ps_layout, maze_name, maze_path));
+
+    std::unique_ptr<game::maze> pu_maze(manager.load_maze(maze_name));   // Caches the template of the maze.
+    std::chrono::steady_clock::duration decode_time {0};
+    std::chrono::steady_clock::duration create_time {0};
+    std::chrono::steady_clock::duration restore_time {0};
+
+    for (unsigned long i = 0; i < loads_num; i++) {
+      std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+      game::snapshot state;
+
+      if (mazed::save_file::decode(content, state) == false) {
+        std::cerr << "bench_load: save couldn't be decoded" << std::endl;
+        return 1;
+      }
+
+      std::chrono::steady_clock::time_point decoded = std::chrono::steady_clock::now();
+
+      pu_maze.reset(manager.load_maze(state.maze_name));
+
+      std::chrono::steady_clock::time_point created = std::chrono::steady_clock::now();
+
+      if (!pu_maze || pu_maze->restore(state) == false) {
+        std::cerr << "bench_load: " << maze_name << ": save couldn't be restored" << std::endl;
+        return 1;
+      }
+
+      std::chrono::steady_clock::time_point restored = std::chrono::steady_clock::now();
+
+      decode_time += decoded - start;
+      create_time += created - decoded;
+      restore_time += restored - created;
+    }
+
+    std::pair<unsigned long, unsigned long> stats = manager.templates_stats();
+
+    std::cout << "Games loaded:    " << loads_num << " (" << content.size() << " B save)" << std::endl;
+    std::cout << "Save decoding:   "
+              << std::chrono::duration_cast<std::chrono::nanoseconds>(decode_time).count() / loads_num
+              << " ns/load" << std::endl;
+    std::cout << "Maze creation:   "
+              << std::chrono::duration_cast<std::chrono::nanoseconds>(create_time).count() / loads_num
+              << " ns/load" << std::endl;
+    std::cout << "State restoring: "
+              << std::chrono::duration_cast<std::chrono::nanoseconds>(restore_time).count() / loads_num
+              << " ns/load" << std::endl;
+    std::cout << "Whole load:      "
+              << std::chrono::duration_cast<std::chrono::nanoseconds>(decode_time + create_time +
+                                                                      restore_time).count() / loads_num
+              << " ns/load" << std::endl;
+    std::cout << "Cache hits:      " << stats.first << std::endl;
+    std::cout << "Cache misses:    " << stats.second << std::endl;
+
+    return 0;
+  }
+  catch (std::exception &e) {
+    std::cerr << "bench_load: " << e.what() << std::endl;
+    return 1;
+  }
+}}}
+
+/* ****************************************************************************************************************** *
+ * ***[ END OF BENCH_LOAD.CC ]*************************************************************************************** *
+ * ****************************************************************************************************************** */
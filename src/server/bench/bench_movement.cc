@@ -0,0 +1,197 @@
+/**
+ * @file      bench_movement.cc
+ * @author    Dee'Kej (David Kaspar - xkaspa34)
+ * @version   0.1
+ * @brief     Benchmark of the player's movement within the maze.
+ *
+ * @detailed  The maze is parsed & the player walks randomly from its starting block, doing the same steps as the
+ *            player::update_coords() - the check of the move within the slide table & leaving/entering the blocks of
+ *            the maze. The number of moves per second & the number of heap allocations done during the movement are
+ *            printed, the allocations are counted by the replaced malloc().
+ */
+
+/* ****************************************************************************************************************** *
+ * ***[ START OF BENCH_MOVEMENT.CC ]********************************************************************************* *
+ * ****************************************************************************************************************** */
+
+
+/* ****************************************************************************************************************** *
+ ~ ~~~[ HEADER FILES ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ ~
+ * ****************************************************************************************************************** */
+
+// C++ header files:
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+
+// Boost header files:
+#include <boost/program_options.hpp>
+
+// Program header files:
+#include "../mazed_game_maze.hh"
+#include "../mazed_maze_file.hh"
+
+
+/* ****************************************************************************************************************** *
+ ~ ~~~[ GLOBAL VARIABLES ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ ~
+ * ****************************************************************************************************************** */
+
+const std::string HELP_STRING =
+"This is the benchmark of the player's movement of MAZE-GAME application,\n"
+"which is the part from project of ICP course @ BUT FIT, Czech Republic, 2014.\n\n"
+"Usage:         bench_movement [options] MAZE_FILE\n\n"
+"Optional arguments";
+
+unsigned long allocations {0};          // Counted by the replaced malloc().
+
+
+/* ****************************************************************************************************************** *
+ ~ ~~~[ ALLOCATION COUNTING ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ ~
+ * ****************************************************************************************************************** */
+
+extern "C" void *__libc_malloc(std::size_t size);
+
+/**
+ * Replaces the malloc() of the glibc, which is used by the operator new as well.
+ */
+extern "C" void *malloc(std::size_t size)
+{{{
+  allocations++;
+  return __libc_malloc(size);
+}}}
+
+
+/* ****************************************************************************************************************** *
+ ~ ~~~[ AUXILIARY FUNCTIONS ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ ~
+ * ****************************************************************************************************************** */
+
+/**
+ * Moves the player the same way as the player::update_coords() does, if the move is possible.
+ *
+ * @return  true if the player has moved, false otherwise.
+ */
+inline bool move(game::maze &maze, std::pair<signed char, signed char> &coords, game::E_move direction,
+                 signed char rows_num, signed char cols_num)
+{{{
+  if (maze.is_move_possible(coords, direction) == false) {
+    return false;
+  }
+
+  maze.player_leave(coords.first, coords.second, 0);
+
+  switch (direction) {
+    case game::LEFT :
+      coords.second = (coords.second - 1) % cols_num;
+      break;
+
+    case game::RIGHT :
+      coords.second = (coords.second + 1) % cols_num;
+      break;
+
+    case game::UP :
+      coords.first = (coords.first - 1) % rows_num;
+      break;
+
+    case game::DOWN :
+      coords.first = (coords.first + 1) % rows_num;
+      break;
+
+    default :
+      break;
+  }
+
+  maze.player_enter(coords.first, coords.second, 0);
+
+  return true;
+}}}
+
+
+/* ****************************************************************************************************************** *
+ ~ ~~~[ MAIN FUNCTION ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ ~
+ * ****************************************************************************************************************** */
+
+int main(int argc, char *argv[])
+{{{
+  unsigned long moves_num;
+  std::string   maze_path;
+
+  try {
+    namespace params = boost::program_options;
+
+    params::options_description help(HELP_STRING, 120);
+    help.add_options() ("help,h", "show this message and exit");
+    help.add_options() ("moves,n", params::value<unsigned long>(&moves_num)->default_value(10000000),
+                        "number of the moves attempted (default: 10000000)");
+
+    params::options_description hidden;
+    hidden.add_options() ("maze", params::value<std::string>(&maze_path));
+
+    params::options_description all;
+    all.add(help).add(hidden);
+
+    params::positional_options_description positional;
+    positional.add("maze", 1);
+
+    params::variables_map options;
+    params::store(params::command_line_parser(argc, argv).options(all).positional(positional).run(), options);
+    params::notify(options);
+
+    if (options.count("help") || maze_path.empty() == true) {
+      std::cout << help << std::endl;
+      return (maze_path.empty() == true && !options.count("help")) ? 1 : 0;
+    }
+
+    std::ifstream maze_file(maze_path);
+    std::shared_ptr<const game::maze_layout> ps_layout(mazed::maze_file::parse(maze_file));
+
+    if (!ps_layout) {
+      std::cerr << "bench_movement: " << maze_path << ": not a valid maze" << std::endl;
+      return 1;
+    }
+
+    game::maze maze(ps_layout);
+    std::pair<signed char, signed char> coords = ps_layout->get_start_coords(0);
+    signed char rows_num = ps_layout->get_rows();
+    signed char cols_num = ps_layout->get_cols();
+
+    maze.player_enter(coords.first, coords.second, 0);
+
+    unsigned long moved {0};
+    unsigned random {2463534242U};                  // Xorshift, so the directions are same for every run.
+    unsigned long allocations_start = allocations;
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    for (unsigned long i = 0; i < moves_num; i++) {
+      random ^= random << 13;
+      random ^= random >> 17;
+      random ^= random << 5;
+
+      game::E_move direction = static_cast<game::E_move>(game::LEFT + (random & 3));
+      moved += (move(maze, coords, direction, rows_num, cols_num) == true) ? 1 : 0;
+    }
+
+    std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+    unsigned long allocations_done = allocations - allocations_start;
+    double seconds = std::chrono::duration<double>(end - start).count();
+
+    std::cout << "Moves attempted: " << moves_num << " (" << moved << " done)" << std::endl;
+    std::cout << "Time:            " << std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count()
+              << " ms" << std::endl;
+    std::cout << "Moves/s:         " << static_cast<unsigned long>(moves_num / seconds) << std::endl;
+    std::cout << "Allocations:     " << allocations_done << std::endl;
+
+    return (allocations_done == 0) ? 0 : 1;
+  }
+  catch (std::exception &e) {
+    std::cerr << "bench_movement: " << e.what() << std::endl;
+    return 1;
+  }
+}}}
+
+/* ****************************************************************************************************************** *
+ * ***[ END OF BENCH_MOVEMENT.CC ]*********************************************************************************** *
+ * ****************************************************************************************************************** */
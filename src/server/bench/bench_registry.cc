@@ -0,0 +1,227 @@
+/**
+ * @file      bench_registry.cc
+ * @author    Dee'Kej (David Kaspar - xkaspa34)
+ * @version   0.1
+ * @brief     Contention benchmark of the games_registry.
+ *
+ * @detailed  The creators add a game, change its players & status and remove it again (as the CREATE_GAME, JOIN_GAME
+ *            & TERMINATE_GAME do), while the listers build the list of the running games (as the LIST_RUNNING does).
+ *            The registry holds the given number of games, which are listed all the time. The cycles of the creators
+ *            and the listings of the listers per second are printed, in total and per thread. Run it with 1 - N
+ *            creators and with --shards 1 & the default GAMES_SHARDS to compare the sharded & the single registry.
+ */
+
+/* ****************************************************************************************************************** *
+ * ***[ START OF BENCH_REGISTRY.CC ]********************************************************************************* *
+ * ****************************************************************************************************************** */
+
+
+/* ****************************************************************************************************************** *
+ ~ ~~~[ HEADER FILES ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ ~
+ * ****************************************************************************************************************** */
+
+// C++ header files:
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Boost header files:
+#include <boost/bind.hpp>
+#include <boost/program_options.hpp>
+#include <boost/thread.hpp>
+
+// Program header files:
+#include "../mazed_games_registry.hh"
+
+
+/* ****************************************************************************************************************** *
+ ~ ~~~[ GLOBAL VARIABLES ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ ~
+ * ****************************************************************************************************************** */
+
+const std::string HELP_STRING =
+"This is the contention benchmark of the running games' registry of MAZE-GAME application,\n"
+"which is the part from project of ICP course @ BUT FIT, Czech Republic, 2014.\n\n"
+"Usage:         bench_registry [options]\n\n"
+"Optional arguments";
+
+std::atomic<bool>           bench_done {false};
+std::atomic<unsigned long>  cycles_done {0};
+std::atomic<unsigned long>  listings_done {0};
+
+
+/* ****************************************************************************************************************** *
+ ~ ~~~[ AUXILIARY FUNCTIONS ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ ~
+ * ****************************************************************************************************************** */
+
+/**
+ * Releases the placeholder of the game instance, which is never constructed - the registry doesn't use it.
+ */
+struct instance_deleter {
+  void operator()(game::instance *p_instance)
+  {{{
+    delete reinterpret_cast<char *>(p_instance);
+    return;
+  }}}
+};
+
+
+std::shared_ptr<game::instance> instance_create()
+{{{
+  return std::shared_ptr<game::instance>(reinterpret_cast<game::instance *>(new char), instance_deleter());
+}}}
+
+
+/**
+ * Adds, changes & removes the games until the benchmark is done.
+ */
+void creator(mazed::games_registry *p_registry)
+{{{
+  std::shared_ptr<game::instance> ps_instance = instance_create();
+  unsigned long cycles {0};
+
+  while (bench_done == false) {
+    std::string uid = p_registry->add(ps_instance, "bench.maze", std::vector<std::string> {"owner"});
+
+    p_registry->set_players(uid, std::vector<std::string> {"owner", "player"});
+    p_registry->set_status(uid, protocol::E_game_status::RUNNING);
+    p_registry->remove(uid);
+
+    cycles++;
+  }
+
+  cycles_done += cycles;
+  return;
+}}}
+
+
+/**
+ * Builds the list of the running games the same way as the LIST_RUNNING does until the benchmark is done.
+ */
+void lister(mazed::games_registry *p_registry)
+{{{
+  mazed::games_registry::games_snapshot::const_iterator it_shard;
+  mazed::games_registry::games_table::const_iterator it_game;
+  std::vector<std::string>::const_iterator it_nick;
+  unsigned long listings {0};
+
+  while (bench_done == false) {
+    mazed::games_registry::games_snapshot snapshot = p_registry->get_games();
+    std::vector<std::string> games;
+
+    for (it_shard = snapshot.begin(); it_shard != snapshot.end(); it_shard++) {
+      for (it_game = (*it_shard)->begin(); it_game != (*it_shard)->end(); it_game++) {
+        if ((*it_game).uid == 0) {
+          continue;
+        }
+
+        const protocol::game_info &info = *(*it_game).ps_info;
+        std::string game = info.UID + ";" + info.maze_name + ";" + std::to_string(info.status) + ";" +
+                           std::to_string(info.used_slots);
+
+        for (it_nick = info.players.begin(); it_nick != info.players.end(); it_nick++) {
+          game += ";" + *it_nick;
+        }
+
+        games.push_back(game);
+      }
+    }
+
+    listings++;
+  }
+
+  listings_done += listings;
+  return;
+}}}
+
+
+/* ****************************************************************************************************************** *
+ ~ ~~~[ MAIN FUNCTION ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ ~
+ * ****************************************************************************************************************** */
+
+int main(int argc, char *argv[])
+{{{
+  unsigned creators_num;
+  unsigned listers_num;
+  unsigned games_num;
+  unsigned shards_num;
+  unsigned seconds;
+
+  try {
+    namespace params = boost::program_options;
+
+    params::options_description help(HELP_STRING, 120);
+    help.add_options() ("help,h", "show this message and exit");
+    help.add_options() ("creators,c", params::value<unsigned>(&creators_num)->default_value(4),
+                        "number of the threads creating & terminating the games (default: 4)");
+    help.add_options() ("listers,l", params::value<unsigned>(&listers_num)->default_value(4),
+                        "number of the threads listing the games (default: 4)");
+    help.add_options() ("games,g", params::value<unsigned>(&games_num)->default_value(100),
+                        "number of the games running all the time (default: 100)");
+    help.add_options() ("shards,s", params::value<unsigned>(&shards_num)->default_value(GAMES_SHARDS),
+                        "number of the registry's shards (default: GAMES_SHARDS)");
+    help.add_options() ("time,t", params::value<unsigned>(&seconds)->default_value(5),
+                        "duration of the benchmark in seconds (default: 5)");
+
+    params::variables_map options;
+    params::store(params::parse_command_line(argc, argv, help), options);
+    params::notify(options);
+
+    if (options.count("help") || seconds == 0 || shards_num == 0) {
+      std::cout << help << std::endl;
+      return 0;
+    }
+
+    mazed::games_registry registry(shards_num);
+    std::shared_ptr<game::instance> ps_instance = instance_create();
+
+    for (unsigned i = 0; i < games_num; i++) {
+      registry.add(ps_instance, "bench.maze", std::vector<std::string> {"owner", "player"});
+    }
+
+    boost::thread_group threads;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    for (unsigned i = 0; i < creators_num; i++) {
+      threads.create_thread(boost::bind(creator, &registry));
+    }
+
+    for (unsigned i = 0; i < listers_num; i++) {
+      threads.create_thread(boost::bind(lister, &registry));
+    }
+
+    boost::this_thread::sleep(boost::posix_time::seconds(seconds));
+    bench_done = true;
+    threads.join_all();
+
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << "Threads:         " << creators_num << " creators, " << listers_num << " listers ("
+              << boost::thread::hardware_concurrency() << " cores)" << std::endl;
+    std::cout << "Games running:   " << games_num << " (" << registry.get_shards_num() << " shards)" << std::endl;
+    std::cout << "Cycles/s:        " << static_cast<unsigned long>(cycles_done / elapsed);
+
+    if (creators_num > 0) {
+      std::cout << " (" << static_cast<unsigned long>(cycles_done / elapsed / creators_num) << " per creator)";
+    }
+
+    std::cout << std::endl << "Listings/s:      " << static_cast<unsigned long>(listings_done / elapsed);
+
+    if (listers_num > 0) {
+      std::cout << " (" << static_cast<unsigned long>(listings_done / elapsed / listers_num) << " per lister)";
+    }
+
+    std::cout << std::endl;
+    return 0;
+  }
+  catch (std::exception &e) {
+    std::cerr << "bench_registry: " << e.what() << std::endl;
+    return 1;
+  }
+}}}
+
+/* ****************************************************************************************************************** *
+ * ***[ END OF BENCH_REGISTRY.CC ]*********************************************************************************** *
+ * ****************************************************************************************************************** */
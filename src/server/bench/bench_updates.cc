@@ -0,0 +1,471 @@
+/**
+ * @file      bench_updates.cc
+ * @author    Dee'Kej (David Kaspar - xkaspa34)
+ * @version   0.1
+ * @brief     Benchmark of the game updates received from the running server daemon with & without DELTA updates.
+ *
+ * @detailed  Two clients create their own game of the given maze at once, both with the game channel multiplexed and
+ *            the binary format, but only one of them negotiates the DELTA updates. Both games are started and left
+ *            idle (only the guardians move) for the given time, while the updates received are counted. The number of
+ *            updates, the bytes per update and the time spent by decoding of the updates is printed for both clients.
+ *
+ *            With the --players option the pacing of the updates is measured instead: the 1st client creates the game
+ *            and the others join it (the server should run no other games). Once all the players got their 1st update,
+ *            the arrival time of every update is recorded, and the inter-arrival time of the updates, the size of their
+ *            bursts and the spread of each tick (delay of the last player's update after the 1st one) are printed.
+ *            Run it against the server started with --pacing 0 and then with e.g. --pacing 50 to compare them. For the
+ *            shaped link, the loopback is shaped by netem before the runs and restored afterwards:
+ *
+ *              tc qdisc add dev lo root netem delay 5ms rate 1mbit limit 100
+ *              bench_updates --players 4 -t 20 leaf_1
+ *              tc qdisc del dev lo root
+ */
+
+/* ****************************************************************************************************************** *
+ * ***[ START OF BENCH_UPDATES.CC ]********************************************************************************** *
+ * ****************************************************************************************************************** */
+
+
+/* ****************************************************************************************************************** *
+ ~ ~~~[ HEADER FILES ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ ~
+ * ****************************************************************************************************************** */
+
+// C++ header files:
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Boost header files:
+#include <boost/asio.hpp>
+#include <boost/bind.hpp>
+#include <boost/program_options.hpp>
+
+// Program header files:
+#include "../../binary_archive.hh"
+#include "../../protocol.hh"
+#include "../../serialization.hh"
+#include "../mazed_game_globals.hh"
+
+
+/* ****************************************************************************************************************** *
+ ~ ~~~[ GLOBAL VARIABLES ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ ~
+ * ****************************************************************************************************************** */
+
+const std::string HELP_STRING =
+"This is the benchmark of the game updates of MAZE-GAME application,\n"
+"which is the part from project of ICP course @ BUT FIT, Czech Republic, 2014.\n\n"
+"Usage:         bench_updates [options] MAZE\n\n"
+"Optional arguments";
+
+namespace asio = boost::asio;
+using     tcp = boost::asio::ip::tcp;
+
+
+/**
+ * Arrival times of the updates received by all the players of one game, for the pacing metrics.
+ */
+struct pacing_stats {
+  unsigned                                                                    players_num {0};
+  unsigned                                                                    players_ready {0};
+  std::vector<std::pair<std::chrono::steady_clock::time_point, unsigned>>    arrivals;    // Time & player's index.
+};
+
+
+/* ****************************************************************************************************************** *
+ ~ ~~~[ SESSION CLASS ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ ~
+ * ****************************************************************************************************************** */
+
+/**
+ * Client creating & starting its own game, counting the game updates received afterwards.
+ */
+class session {
+    tcp::socket                         socket_;
+    protocol::tcp_serialization         tcp_connect_;
+    std::string                         maze_;
+    bool                                delta_;
+    bool                                join_;
+    unsigned                            index_;
+    pacing_stats                        *p_stats_;
+    bool                                ready_ {false};
+    tcp::endpoint                       endpoint_;
+
+    std::vector<protocol::message>      messages_;
+    protocol::frame                     frame_;
+    std::vector<char>                   encoded_;
+
+  public:
+    bool                                failed {false};
+    unsigned long                       keyframes {0};
+    unsigned long                       deltas {0};
+    unsigned long                       bytes {0};
+    std::chrono::nanoseconds            decode_time {0};
+
+    session                             *p_next {NULL};     // Started once this client is in the game.
+
+    session(asio::io_service &io_service, const std::string &maze, bool delta, bool join = false,
+            unsigned index = 0, pacing_stats *p_stats = NULL) :
+      socket_{io_service}, tcp_connect_{socket_}, maze_{maze}, delta_{delta}, join_{join}, index_{index},
+      p_stats_{p_stats}
+    {{{
+      return;
+    }}}
+
+    void start(tcp::endpoint endpoint)
+    {{{
+      endpoint_ = endpoint;
+      socket_.async_connect(endpoint, boost::bind(&session::handle_connect, this, asio::placeholders::error));
+      return;
+    }}}
+
+    void stop()
+    {{{
+      boost::system::error_code ignored_error;
+      socket_.shutdown(tcp::socket::shutdown_both, ignored_error);
+      socket_.close(ignored_error);
+      return;
+    }}}
+
+  private:
+    void handle_connect(const boost::system::error_code &error)
+    {{{
+      if (error) {
+        return fail(error.message());
+      }
+
+      messages_.assign(1, protocol::message());
+      messages_[0].type = protocol::CTRL;
+      messages_[0].ctrl_type = protocol::SYN;
+      messages_[0].status = protocol::QUERY;
+      messages_[0].data = {PROTOCOL_MUX, PROTOCOL_BINARY};
+
+      if (delta_ == true) {
+        messages_[0].data.push_back(PROTOCOL_DELTA);
+      }
+
+      tcp_connect_.async_write(messages_, boost::bind(&session::handle_syn_sent, this, asio::placeholders::error));
+      return;
+    }}}
+
+
+    void handle_syn_sent(const boost::system::error_code &error)
+    {{{
+      if (error) {
+        return fail(error.message());
+      }
+
+      tcp_connect_.async_read(messages_, boost::bind(&session::handle_syn_ack, this, asio::placeholders::error));
+      return;
+    }}}
+
+
+    void handle_syn_ack(const boost::system::error_code &error)
+    {{{
+      if (error || messages_.size() != 1 || messages_[0].status != protocol::ACK) {
+        return fail("handshake failed");
+      }
+
+      tcp_connect_.binary(true);
+
+      frame_.channel = protocol::LOBBY;
+      frame_.msg = messages_[0];
+      frame_.msg.status = protocol::QUERY;
+
+      if (join_ == true) {
+        frame_.msg.ctrl_type = protocol::JOIN_GAME;
+        frame_.msg.data.clear();        // Joining any running game.
+      }
+      else {
+        frame_.msg.ctrl_type = protocol::CREATE_GAME;
+        frame_.msg.data = {maze_};
+      }
+
+      tcp_connect_.async_write(frame_, boost::bind(&session::handle_sent, this, asio::placeholders::error));
+      return;
+    }}}
+
+
+    void handle_sent(const boost::system::error_code &error)
+    {{{
+      if (error) {
+        return fail(error.message());
+      }
+
+      tcp_connect_.async_read(frame_, boost::bind(&session::handle_frame, this, asio::placeholders::error));
+      return;
+    }}}
+
+
+    void handle_frame(const boost::system::error_code &error)
+    {{{
+      if (error) {
+        return;                         // The benchmark has been stopped.
+      }
+
+      if (frame_.channel == protocol::LOBBY) {
+        if (frame_.msg.type != protocol::CTRL || frame_.msg.status != protocol::ACK) {
+          return fail("game couldn't be created or joined");
+        }
+
+        if (p_next != NULL) {
+          p_next->start(endpoint_);
+        }
+
+        if (join_ == true) {
+          tcp_connect_.async_read(frame_, boost::bind(&session::handle_frame, this, asio::placeholders::error));
+          return;
+        }
+
+        // Starting the game & leaving it idle:
+        frame_.channel = protocol::GAME_COMMAND;
+        frame_.cmd.cmd = protocol::START_CONTINUE;
+        tcp_connect_.async_write(frame_, boost::bind(&session::handle_sent, this, asio::placeholders::error));
+        return;
+      }
+
+      // The update is encoded again, to get the size of the update received:
+      encoded_.clear();
+      protocol::binary_oarchive archive(encoded_);
+      archive << frame_;
+
+      std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+      protocol::binary_iarchive decoder(encoded_.data(), encoded_.size());
+      decoder >> frame_;
+      decode_time += std::chrono::steady_clock::now() - start;
+
+      bytes += encoded_.size() + 4;     // Including the header.
+      (frame_.upd.type == protocol::KEYFRAME) ? keyframes++ : deltas++;
+
+      if (p_stats_ != NULL) {
+        if (ready_ == false) {
+          ready_ = true;
+          p_stats_->players_ready++;
+        }
+        else if (p_stats_->players_ready == p_stats_->players_num) {
+          p_stats_->arrivals.push_back(std::make_pair(std::chrono::steady_clock::now(), index_));
+        }
+      }
+
+      tcp_connect_.async_read(frame_, boost::bind(&session::handle_frame, this, asio::placeholders::error));
+      return;
+    }}}
+
+
+    void fail(const std::string &reason)
+    {{{
+      std::cerr << "bench_updates: " << reason << std::endl;
+      failed = true;
+      stop();
+      return;
+    }}}
+};
+
+
+/* ****************************************************************************************************************** *
+ ~ ~~~[ AUXILIARY FUNCTIONS ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ ~
+ * ****************************************************************************************************************** */
+
+void print_results(const std::string &name, const session &client)
+{{{
+  unsigned long updates = client.keyframes + client.deltas;
+
+  std::cout << name << "updates " << updates << " (" << client.keyframes << " KEYFRAME), ";
+
+  if (updates > 0) {
+    std::cout << client.bytes / updates << " B/update, "
+              << std::chrono::duration_cast<std::chrono::nanoseconds>(client.decode_time).count() / updates
+              << " ns decode/update";
+  }
+
+  std::cout << std::endl;
+  return;
+}}}
+
+
+
+/**
+ * Prints the pacing metrics of the updates received by all the players of one game. Updates arriving less than
+ * burst_gap after the previous one are counted into the same burst. The tick's updates end once some player receives
+ * its next update, the spread of the tick is the time from the 1st to the last update of the tick.
+ */
+void print_pacing(const pacing_stats &stats, long burst_gap)
+{{{
+  typedef std::vector<std::pair<std::chrono::steady_clock::time_point, unsigned>>::const_iterator arrival_iter;
+
+  if (stats.arrivals.size() < 2) {
+    std::cout << "Updates:         " << stats.arrivals.size() << ", the players never got into the game" << std::endl;
+    return;
+  }
+
+  long gap_sum = 0, gap_min = -1, gap_max = 0;
+  unsigned long bursts = 1, burst = 1, burst_max = 1;
+  unsigned long ticks = 0;
+  long spread_sum = 0, spread_max = 0;
+  std::vector<bool> tick_players(stats.players_num, false);
+  std::chrono::steady_clock::time_point tick_start = stats.arrivals.front().first;
+  std::chrono::steady_clock::time_point tick_last = tick_start;
+
+  tick_players[stats.arrivals.front().second] = true;
+
+  for (arrival_iter it = stats.arrivals.begin() + 1; it != stats.arrivals.end(); it++) {
+    long gap = std::chrono::duration_cast<std::chrono::microseconds>(it->first - (it - 1)->first).count();
+
+    gap_sum += gap;
+    gap_min = (gap_min < 0) ? gap : std::min(gap_min, gap);
+    gap_max = std::max(gap_max, gap);
+
+    if (gap < burst_gap) {
+      burst++;
+    }
+    else {
+      bursts++;
+      burst = 1;
+    }
+
+    burst_max = std::max(burst_max, burst);
+
+    if (tick_players[it->second] == true) {
+      long spread = std::chrono::duration_cast<std::chrono::microseconds>(tick_last - tick_start).count();
+
+      spread_sum += spread;
+      spread_max = std::max(spread_max, spread);
+      ticks++;
+
+      tick_players.assign(stats.players_num, false);
+      tick_start = it->first;
+    }
+
+    tick_players[it->second] = true;
+    tick_last = it->first;
+  }
+
+  unsigned long gaps = stats.arrivals.size() - 1;
+
+  std::cout << "Updates:         " << stats.arrivals.size() << " to " << stats.players_num << " players" << std::endl;
+  std::cout << "Inter-arrival:   " << gap_sum / gaps << " us mean, " << gap_min << " us min, " << gap_max
+            << " us max" << std::endl;
+  std::cout << "Bursts:          " << stats.arrivals.size() / bursts << " updates mean, " << burst_max
+            << " max (gap < " << burst_gap << " us)" << std::endl;
+
+  if (ticks > 0) {
+    std::cout << "Tick spread:     " << spread_sum / ticks << " us mean, " << spread_max << " us max" << std::endl;
+  }
+
+  return;
+}}}
+
+
+/* ****************************************************************************************************************** *
+ ~ ~~~[ MAIN FUNCTION ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ ~
+ * ****************************************************************************************************************** */
+
+int main(int argc, char *argv[])
+{{{
+  std::string     host;
+  unsigned short  port;
+  unsigned        seconds;
+  std::string     maze;
+  unsigned        players;
+  long            burst_gap;
+
+  try {
+    namespace params = boost::program_options;
+
+    params::options_description help(HELP_STRING, 120);
+    help.add_options() ("help,h", "show this message and exit");
+    help.add_options() ("host", params::value<std::string>(&host)->default_value("127.0.0.1"),
+                        "address of the server daemon (default: 127.0.0.1)");
+    help.add_options() ("port,p", params::value<unsigned short>(&port)->default_value(49429),
+                        "port of the server daemon (default: 49429)");
+    help.add_options() ("time,t", params::value<unsigned>(&seconds)->default_value(10),
+                        "time of the games in seconds (default: 10)");
+    help.add_options() ("players,n", params::value<unsigned>(&players)->default_value(0),
+                        "players of one game measuring the pacing of updates, 0 to compare KEYFRAME & DELTA updates "
+                        "(default: 0)");
+    help.add_options() ("burst-gap", params::value<long>(&burst_gap)->default_value(1000),
+                        "max gap in us between the updates of one burst (default: 1000)");
+
+    params::options_description hidden;
+    hidden.add_options() ("maze", params::value<std::string>(&maze));
+
+    params::options_description all;
+    all.add(help).add(hidden);
+
+    params::positional_options_description positional;
+    positional.add("maze", 1);
+
+    params::variables_map options;
+    params::store(params::command_line_parser(argc, argv).options(all).positional(positional).run(), options);
+    params::notify(options);
+
+    if (options.count("help") || maze.empty() == true) {
+      std::cout << help << std::endl;
+      return (maze.empty() == true && !options.count("help")) ? 1 : 0;
+    }
+
+    if (players > GAME_MAX_PLAYERS) {
+      std::cerr << "bench_updates: at most " << GAME_MAX_PLAYERS << " players can play one game" << std::endl;
+      return 1;
+    }
+
+    asio::io_service io_service;
+    tcp::endpoint endpoint(asio::ip::address::from_string(host), port);
+    asio::deadline_timer timer(io_service, boost::posix_time::seconds(seconds));
+
+    if (players > 0) {
+      pacing_stats stats;
+      std::vector<session *> clients;
+      std::vector<session *>::iterator it_client;
+      bool failed = false;
+
+      stats.players_num = players;
+
+      for (unsigned i = 0; i < players; i++) {
+        clients.push_back(new session(io_service, maze, true, i > 0, i, &stats));
+
+        if (i > 0) {
+          clients[i - 1]->p_next = clients[i];
+        }
+
+        timer.async_wait(boost::bind(&session::stop, clients[i]));
+      }
+
+      clients[0]->start(endpoint);
+      io_service.run();
+
+      print_pacing(stats, burst_gap);
+
+      for (it_client = clients.begin(); it_client != clients.end(); it_client++) {
+        failed = failed || (*it_client)->failed;
+        delete *it_client;
+      }
+
+      return (failed == true) ? 1 : 0;
+    }
+
+    session keyframes_client(io_service, maze, false);
+    session deltas_client(io_service, maze, true);
+
+    keyframes_client.start(endpoint);
+    deltas_client.start(endpoint);
+
+    timer.async_wait(boost::bind(&session::stop, &keyframes_client));
+    timer.async_wait(boost::bind(&session::stop, &deltas_client));
+
+    io_service.run();
+
+    print_results("KEYFRAME only:   ", keyframes_client);
+    print_results("DELTA:           ", deltas_client);
+
+    return (keyframes_client.failed == true || deltas_client.failed == true) ? 1 : 0;
+  }
+  catch (std::exception &e) {
+    std::cerr << "bench_updates: " << e.what() << std::endl;
+    return 1;
+  }
+}}}
+
+/* ****************************************************************************************************************** *
+ * ***[ END OF BENCH_UPDATES.CC ]************************************************************************************ *
+ * ****************************************************************************************************************** */
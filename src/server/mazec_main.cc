@@ -0,0 +1,209 @@
+/**
+ * @file      mazec_main.cc
+ * @author    Dee'Kej (David Kaspar - xkaspa34)
+ * @version   0.1
+ * @brief     Converter of the text mazes into the compiled mazes loaded by the server daemon.
+ *
+ * @detailed  Every given maze file (or every maze file within the given folder) is validated and written as the
+ *            compiled maze next to it, e.g. leaf_1.maze -> leaf_1.mazec. The mazes which can't be finished are reported
+ *            (they're compiled anyway). With the --benchmark option the time of loading all the given mazes from the
+ *            text & compiled files is measured afterwards.
+ */
+
+/* ****************************************************************************************************************** *
+ * ***[ START OF MAZEC_MAIN.CC ]************************************************************************************* *
+ * ****************************************************************************************************************** */
+
+
+/* ****************************************************************************************************************** *
+ ~ ~~~[ HEADER FILES ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ ~
+ * ****************************************************************************************************************** */
+
+// C++ header files:
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Boost header files:
+#include <boost/filesystem.hpp>
+#include <boost/program_options.hpp>
+
+// Program header files:
+#include "mazed_globals.hh"
+#include "mazed_maze_file.hh"
+
+
+/* ****************************************************************************************************************** *
+ ~ ~~~[ GLOBAL VARIABLES ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ ~
+ * ****************************************************************************************************************** */
+
+const std::string HELP_STRING =
+"This is the converter of mazes for MAZE-GAME application,\n"
+"which is the part from project of ICP course @ BUT FIT, Czech Republic, 2014.\n\n"
+"Usage:         mazec [options] MAZE|FOLDER...\n\n"
+"Optional arguments";
+
+
+/* ****************************************************************************************************************** *
+ ~ ~~~[ AUXILIARY FUNCTIONS ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ ~
+ * ****************************************************************************************************************** */
+
+namespace filesys = boost::filesystem;
+
+/**
+ * @return  Given maze files, the folders are replaced by their maze files of the given extension.
+ */
+std::vector<std::string> collect_mazes(const std::vector<std::string> &inputs, const std::string &extension)
+{{{
+  std::vector<std::string> mazes;
+  std::vector<std::string>::const_iterator it_input;
+  filesys::directory_iterator it_dir_end;
+
+  for (it_input = inputs.begin(); it_input != inputs.end(); it_input++) {
+    if (filesys::is_directory(*it_input) == false) {
+      mazes.push_back(*it_input);
+      continue;
+    }
+
+    for (filesys::directory_iterator it_dir(*it_input); it_dir != it_dir_end; it_dir++) {
+      if (filesys::is_regular_file(it_dir->path()) == true && it_dir->path().extension() == extension) {
+        mazes.push_back(it_dir->path().native());
+      }
+    }
+  }
+
+  return mazes;
+}}}
+
+
+/**
+ * Loads all the mazes from the text and from the compiled files and prints the time spent.
+ */
+void benchmark(const std::vector<std::string> &mazes)
+{{{
+  std::vector<std::string>::const_iterator it_maze;
+  std::unique_ptr<game::maze_layout> pu_layout;
+  unsigned long loaded {0};
+
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+  for (it_maze = mazes.begin(); it_maze != mazes.end(); it_maze++) {
+    std::ifstream maze_file(*it_maze);
+
+    pu_layout.reset(mazed::maze_file::parse(maze_file));
+    loaded += (pu_layout) ? 1 : 0;
+  }
+
+  std::chrono::steady_clock::time_point text_end = std::chrono::steady_clock::now();
+
+  for (it_maze = mazes.begin(); it_maze != mazes.end(); it_maze++) {
+    pu_layout.reset(mazed::maze_file::load_compiled(*it_maze + MAZEC_SUFFIX));
+    loaded += (pu_layout) ? 1 : 0;
+  }
+
+  std::chrono::steady_clock::time_point compiled_end = std::chrono::steady_clock::now();
+
+  std::cout << "Mazes loaded:    " << loaded << " of " << mazes.size() * 2 << std::endl;
+  std::cout << "Text mazes:      "
+            << std::chrono::duration_cast<std::chrono::microseconds>(text_end - start).count() << " us" << std::endl;
+  std::cout << "Compiled mazes:  "
+            << std::chrono::duration_cast<std::chrono::microseconds>(compiled_end - text_end).count() << " us"
+            << std::endl;
+
+  return;
+}}}
+
+
+/* ****************************************************************************************************************** *
+ ~ ~~~[ MAIN FUNCTION ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ ~
+ * ****************************************************************************************************************** */
+
+int main(int argc, char *argv[])
+{{{
+  std::vector<std::string> inputs;
+  std::string mazes_ext;
+  std::vector<std::string> mazes;
+
+  try {
+    namespace params = boost::program_options;
+
+    params::options_description help(HELP_STRING, 120);
+    help.add_options() ("help,h", "show this message and exit");
+    help.add_options() ("benchmark,b", "measure loading of the text & compiled mazes afterwards");
+    help.add_options() ("mazes-ext", params::value<std::string>(&mazes_ext)->default_value(".maze"),
+                        "extension of mazes within the given folders (default: *.maze)");
+
+    params::options_description hidden;
+    hidden.add_options() ("input", params::value<std::vector<std::string>>(&inputs));
+
+    params::options_description all;
+    all.add(help).add(hidden);
+
+    params::positional_options_description positional;
+    positional.add("input", -1);
+
+    params::variables_map options;
+    params::store(params::command_line_parser(argc, argv).options(all).positional(positional).run(), options);
+    params::notify(options);
+
+    if (options.count("help") || inputs.empty() == true) {
+      std::cout << help << std::endl;
+      return (inputs.empty() == true && !options.count("help")) ? mazed::exit_codes::E_WRONG_PARAMS :
+                                                                  mazed::exit_codes::NO_ERROR;
+    }
+
+    mazes = collect_mazes(inputs, mazes_ext);
+
+    int exit_code {mazed::exit_codes::NO_ERROR};
+    std::vector<std::string>::iterator it_maze;
+
+    for (it_maze = mazes.begin(); it_maze != mazes.end(); it_maze++) {
+      std::ifstream maze_file(*it_maze);
+
+      if (maze_file.fail() == true) {
+        std::cerr << "mazec: " << *it_maze << ": couldn't be opened" << std::endl;
+        exit_code = mazed::exit_codes::E_OPEN;
+        continue;
+      }
+
+      std::unique_ptr<game::maze_layout> pu_layout(mazed::maze_file::parse(maze_file));
+
+      if (!pu_layout) {
+        std::cerr << "mazec: " << *it_maze << ": not valid maze" << std::endl;
+        exit_code = mazed::exit_codes::E_OPEN;
+        continue;
+      }
+
+      if (pu_layout->get_analysis(0).solvable == false) {
+        std::cerr << "mazec: " << *it_maze << ": warning: target can't be reached by the 1st player" << std::endl;
+      }
+      else if (pu_layout->get_analysis(0).verified == false) {
+        std::cerr << "mazec: " << *it_maze << ": warning: too many keys & gates, target wasn't verified to be reachable"
+                  << std::endl;
+      }
+
+      if (mazed::maze_file::compile(*pu_layout, *it_maze + MAZEC_SUFFIX) == false) {
+        std::cerr << "mazec: " << *it_maze << MAZEC_SUFFIX << ": couldn't be written" << std::endl;
+        exit_code = mazed::exit_codes::E_WRITE;
+      }
+    }
+
+    if (options.count("benchmark")) {
+      benchmark(mazes);
+    }
+
+    return exit_code;
+  }
+  catch (std::exception &e) {
+    std::cerr << "mazec: " << e.what() << std::endl;
+    return mazed::exit_codes::E_WRONG_PARAMS;
+  }
+}}}
+
+/* ****************************************************************************************************************** *
+ * ***[ END OF MAZEC_MAIN.CC ]*************************************************************************************** *
+ * ****************************************************************************************************************** */
+
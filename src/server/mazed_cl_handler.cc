@@ -15,21 +15,26 @@
  ~ ~~~[ HEADER FILES ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ ~
  * ****************************************************************************************************************** */
 
+#include <algorithm>
+#include <chrono>
+#include <memory>
 #include <sstream>
 #include <string>
 
 #include <boost/bind.hpp>
 #include <boost/date_time/posix_time/posix_time.hpp>
 #include <boost/smart_ptr/shared_ptr.hpp>
-#include <boost/thread/thread_guard.hpp>
 
 #include <cassert>
 
 #include "mazed_game_instance.hh"
 #include "mazed_game_maze.hh"
 #include "mazed_game_player.hh"
+#include "mazed_game_snapshot.hh"
 #include "mazed_cl_handler.hh"
 
+#include <boost/asio/yield.hpp>       // Keep it last, it defines the coroutines' keywords.
+
 
 /* ****************************************************************************************************************** *
  ~ ~~~[ MEMBER FUNCTIONS IMPLEMENTATIONS ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ ~
@@ -37,19 +42,20 @@
 
 namespace mazed {
   client_handler::client_handler(tcp::socket &socket, asio::io_service &io_service, mazed::settings_tuple &settings,
-                                 const std::shared_ptr<mazed::shared_resources> ptr, unsigned connection_num) :
+                                 const std::shared_ptr<mazed::shared_resources> ptr, unsigned connection_num,
+                                 std::function<void()> finish_handler) :
     socket_(socket),
     io_service_(io_service),
+    strand_(io_service),
     ps_shared_res_{ptr},
-    timeout_(timeout_io_service_),
-    init_barrier_(3),
+    finish_handler_{finish_handler},
+    timeout_(io_service),
+    pacing_timer_(io_service),
     settings_(settings)
   {{{
-    chdir(std::get<mazed::LOG_FOLDER>(settings_).c_str());
-
     // Create the client's connection separate log:
     std::stringstream filename;
-    filename << "connection_" << connection_num << ".log";
+    filename << std::get<mazed::LOG_FOLDER>(settings_) << "/connection_" << connection_num << ".log";
 
     log_file_.open(filename.str(), std::ofstream::out | std::ofstream::trunc);
     log(mazed::log_level::INFO, "Client handler has STARTED (with TCP connection inherited)");
@@ -65,20 +71,6 @@ namespace mazed {
 
   client_handler::~client_handler()
   {{{
-    #if 0
-    if (pu_player_) {
-      if (ps_instance_) {
-        ps_instance_->remove_player(pu_player_.get());
-      }
-
-      pu_player_.reset();
-    }
-
-    if (ps_instance_) {
-      ps_instance_->stop(player_UID_);
-    }
-    #endif
-
     log(mazed::log_level::INFO, "Client handler is STOPPING");
     log_file_.close();
 
@@ -86,125 +78,192 @@ namespace mazed {
   }}}
 
   /**
-   * Starts processing of the client's requests.
+   * Starts processing of the client's requests. It doesn't block, the processing itself is done by the io_service the
+   * client handler was given, so no threads are needed for the client itself. The finish handler (if any) is called
+   * after the processing has finished and it's safe to destroy the client handler.
    */
   void client_handler::run()
   {{{
-    // Starting other necessary threads - ASIO LOOP for ASYNC communication & TIMEOUT checker:
-    boost::shared_ptr<boost::thread> asio_loop_thread(new boost::thread(&client_handler::start_asio_loop, this));
-    boost::shared_ptr<boost::thread> timeout_thread(new boost::thread(&client_handler::start_timeout, this));
-
-    run_processing();
-
-    // Close the given socket properly and cancel any pending async operations on it:
-    if (socket_.is_open() == true) {
-      boost::system::error_code ignored_error;
-      socket_.shutdown(boost::asio::ip::tcp::socket::shutdown_both, ignored_error);
-      socket_.cancel();
-      socket_.close();
-    }
-
-    timeout_.cancel();              // Cancel any pending timeout checks.
-
-    io_service_.stop();             // Make sure no more async operations will be planned.
-    timeout_io_service_.stop();
-
-    // Waiting for other threads to finish their job, we don't want any thread zombies:
-    (*timeout_thread).join();
-    (*asio_loop_thread).join();
-
-    log(mazed::log_level::ALL, "All threads joined back successfully");
+    strand_.dispatch(boost::bind(&client_handler::process, this, boost::system::error_code()));
     return;
   }}}
 
   // // // // // // // // // // // // //
 
   /**
-   * Runs the handshake procedure and starts the main processing loop of client's requests if the previous handshake was
-   * successful.
+   * Stackless coroutine running the handshake procedure and the main processing loop of client's requests. It's
+   * resumed by the completion of every asynchronous receive (or send of the handshake's response). All the handlers of
+   * the client are serialized by the strand, so there's no need for any other synchronization.
+   *
+   * @param[in]   error   Result of the last asynchronous operation.
    */
-  void client_handler::run_processing()
+  void client_handler::process(const boost::system::error_code &error)
   {{{
-    if (handshake_success() == false) {
-      return;                           // Handshake fail. Client has been already notified, bail out.
-    }
+    reenter (coroutine_) {
+      start_timeout();
 
-    boost::unique_lock<boost::mutex> action_lock(action_req_mutex_);
-    
-    timeout_set();
-    action_req_.wait(action_lock);      // Waiting for next message or timeout.
-    timeout_stop();
+      timeout_set();
+      yield async_receive();
 
-    run_mutex_.lock();
-    while (run_ == true) {
-      run_mutex_.unlock();
-      
-      // Calling appropriate message handler of incoming message:
-      switch (message_in_.type) {
-        case CTRL :
-          // NOTE: Making sure no one slips us the message that can cause STACK OVERFLOW:
-          if (message_in_.ctrl_type >= 0 && message_in_.ctrl_type < E_CTRL_TYPE_SIZE) {
-            (this->*ctrl_message_handlers_[message_in_.ctrl_type])();
-          }
-          else {
-            message_prepare(ERROR, WRONG_PROTOCOL, UPDATE, data_t {"Wrong version of protocol"});
-            log(mazed::log_level::ERROR, "CTRL type value overflow detected");
-          }
-          break;
-        
-        case INFO :
-          if (message_in_.info_type == HELLO) {
-            message_prepare(INFO, HELLO, ACK);
+      if (receive_success(error) == true && handshake_success() == true) {
+        // Nothing else can be sent before the HANDSHAKE response, which is always sent without using the frames:
+        frames_sending_ = true;
+        messages_out_[0] = message_out_;
+
+        yield pu_tcp_connect_->async_write(messages_out_, strand_.wrap(boost::bind(&client_handler::process, this,
+                                                                                   asio::placeholders::error)));
+        frames_sending_ = false;
+
+        if (error) {
+          log(mazed::log_level::ERROR, error.message().c_str());
+          run_ = false;
+        }
+        else {
+          multiplexed_ = mux_accepted_;
+          pu_tcp_connect_->binary(binary_accepted_);
+          frame_send();                 // Send anything what was queued in the meantime.
+        }
+
+        while (run_ == true) {
+          timeout_set();
+          yield async_receive();
+
+          if (receive_success(error) == false) {
+            break;
           }
-          else {
-            message_prepare(ERROR, WRONG_PROTOCOL, UPDATE, data_t {"Only HELLO packets are allowed to send on server"});
-            log(mazed::log_level::ERROR, "Wrong INFO message received");
+
+          // Game commands are not part of the request/response cycle, they were already processed:
+          if (multiplexed_ == true && frame_unpack() == false) {
+            continue;
           }
-          break;
 
-        case ERROR :
-          error_message_handler();
-          break;
+          if (message_check() == false) {
+            continue;                   // We're not processing wrong messages, client has been already informed.
+          }
 
-        default :
-          message_prepare(ERROR, WRONG_PROTOCOL, UPDATE, data_t {"Unknown protocol message"});
-          log(mazed::log_level::ERROR, "Unknown message type received");
-          break;
-      }
-     
-      // The timeout must be set before the ASIO loop continues and the ASIO mutex is unlocked: 
-      asio_mutex_.lock();
-      {
-        timeout_set();
-        asio_continue_.notify_one();    // Waking up the ASIO LOOP, this will effectively send any prepared message.
+          message_in_ = std::move(messages_in_[0]);
+          process_message();
+          async_send(message_out_);
+        }
       }
-      asio_mutex_.unlock();
+
+      finish();
+    }
+
+    if (coroutine_.is_complete() == true) {
+      finish_check();
+    }
+
+    return;
+  }}}
+
+
+  /**
+   * Calls the appropriate handler of the incoming message. The handler prepares the response to be sent.
+   */
+  void client_handler::process_message()
+  {{{
+    switch (message_in_.type) {
+      case CTRL :
+        // NOTE: Making sure no one slips us the message that can cause STACK OVERFLOW:
+        if (message_in_.ctrl_type >= 0 && message_in_.ctrl_type < E_CTRL_TYPE_SIZE) {
+          (this->*ctrl_message_handlers_[message_in_.ctrl_type])();
+        }
+        else {
+          message_prepare(ERROR, WRONG_PROTOCOL, UPDATE, data_t {"Wrong version of protocol"});
+          log(mazed::log_level::ERROR, "CTRL type value overflow detected");
+        }
+        break;
       
-      // Wait for next request for action - MESSAGE or TIMEOUT:
-      action_req_.wait(action_lock);
-      timeout_stop();
+      case INFO :
+        if (message_in_.info_type == HELLO) {
+          message_prepare(INFO, HELLO, ACK);
+        }
+        else {
+          message_prepare(ERROR, WRONG_PROTOCOL, UPDATE, data_t {"Only HELLO packets are allowed to send on server"});
+          log(mazed::log_level::ERROR, "Wrong INFO message received");
+        }
+        break;
+
+      case ERROR :
+        error_message_handler();
+        break;
 
-      run_mutex_.lock();
+      default :
+        message_prepare(ERROR, WRONG_PROTOCOL, UPDATE, data_t {"Unknown protocol message"});
+        log(mazed::log_level::ERROR, "Unknown message type received");
+        break;
     }
-    run_mutex_.unlock();
 
     return;
   }}}
 
   
   /**
-   * Terminates the whole client's processing loop by notifying all involved threads that they should terminate. Be
-   * careful when editing, risk of DEADLOCK are very high!
+   * Terminates the processing of the client's requests. The pending receive is woken up, so the coroutine can finish,
+   * while the messages already queued for sending are still sent.
    */
   void client_handler::terminate()
   {{{
-    run_mutex_.lock_upgrade();
-    {
-      run_ = false;
-      action_req_.notify_one();
-      asio_continue_.notify_one();
+    if (run_ == false) {
+      return;
+    }
+
+    run_ = false;
+
+    boost::system::error_code ignored_error;
+    socket_.shutdown(boost::asio::ip::tcp::socket::shutdown_receive, ignored_error);
+    timeout_.cancel(ignored_error);
+    pacing_timer_.cancel(ignored_error);
+
+    return;
+  }}}
+
+
+  /**
+   * Called at the end of the coroutine. The player leaves its game, so the game instance doesn't use this client
+   * handler anymore.
+   */
+  void client_handler::finish()
+  {{{
+    run_ = false;
+
+    boost::system::error_code ignored_error;
+    timeout_.cancel(ignored_error);
+    pacing_timer_.cancel(ignored_error);
+
+    if (pu_player_ && ps_instance_) {
+      ps_instance_->remove_player(pu_player_.get());
+    }
+
+    pu_player_.reset();
+
+    return;
+  }}}
+
+
+  /**
+   * Closes the connection and calls the finish handler, when the coroutine has finished and there are no pending
+   * asynchronous operations left. The finish handler is posted through the strand, so it's called after any handler
+   * already queued.
+   */
+  void client_handler::finish_check()
+  {{{
+    if (coroutine_.is_complete() == false || pending_ops_ > 0 || finished_ == true) {
+      return;
+    }
+
+    finished_ = true;
+
+    if (socket_.is_open() == true) {
+      boost::system::error_code ignored_error;
+      socket_.shutdown(boost::asio::ip::tcp::socket::shutdown_both, ignored_error);
+      socket_.close(ignored_error);
+    }
+
+    if (finish_handler_) {
+      strand_.post(finish_handler_);
     }
-    run_mutex_.unlock_upgrade();
 
     return;
   }}}
@@ -212,30 +271,15 @@ namespace mazed {
   // // // // // // // // // // // // //
 
   /**
-   * Run the handshake procedure and informs the run_processing() member function of it's result.
+   * Checks the handshake message and prepares the response to it.
    *
    * @return 'true' on success handshake | 'false' upon failure.
    */
   bool client_handler::handshake_success()
   {{{
-    // Acquire lock on ACTION REQUEST mutex before the ASIO RECEIVE can (by using initial barrier):
-    boost::unique_lock<boost::mutex> action_lock(action_req_mutex_);
-    init_barrier_.wait();
-  
-    // Set the timeout and wait for message arrival/timeout:
-    timeout_set();
-    action_req_.wait(action_lock);
-    timeout_stop();
-
-    run_mutex_.lock();
-    if(run_ == false) {
-      run_mutex_.unlock();
-      return false;                     // Timeout has passed, inform the caller.
-    }
-    run_mutex_.unlock();
-    
-    // Test the handshake message, the ASIO RECEIVE handler already verified there's only 1 message:
-    if (message_in_.type != CTRL || message_in_.ctrl_type != SYN || message_in_.status != QUERY) {
+    // Test the handshake message, the protocol expects only one actual message:
+    if (messages_in_.size() != 1 || messages_in_[0].type != CTRL || messages_in_[0].ctrl_type != SYN ||
+        messages_in_[0].status != QUERY) {
       message_prepare(CTRL, SYN, NACK);
       async_send(message_out_);
 
@@ -246,14 +290,35 @@ namespace mazed {
       return false;
     }
 
-    // Prepare the response message and notify ASIO LOOP to send it:
-    message_prepare(CTRL, SYN, ACK);
+    message_in_ = std::move(messages_in_[0]);
 
-    asio_mutex_.lock();
-    {
-      asio_continue_.notify_one();
+    // Prepare the response message, confirming the supported capabilities:
+    data_t capabilities;
+
+    if (std::find(message_in_.data.begin(), message_in_.data.end(), PROTOCOL_MUX) != message_in_.data.end()) {
+      mux_accepted_ = true;
+      capabilities.push_back(PROTOCOL_MUX);
+      log(mazed::log_level::INFO, "Game channel is multiplexed over the client's connection");
+    }
+
+    if (std::find(message_in_.data.begin(), message_in_.data.end(), PROTOCOL_BINARY) != message_in_.data.end()) {
+      binary_accepted_ = true;
+      capabilities.push_back(PROTOCOL_BINARY);
+      log(mazed::log_level::INFO, "Binary format is used over the client's connection");
+    }
+
+    if (std::find(message_in_.data.begin(), message_in_.data.end(), PROTOCOL_DELTA) != message_in_.data.end()) {
+      delta_accepted_ = true;
+      capabilities.push_back(PROTOCOL_DELTA);
+      log(mazed::log_level::INFO, "Game updates are sent as DELTA updates");
+    }
+
+    if (capabilities.empty() == true) {
+      message_prepare(CTRL, SYN, ACK);
+    }
+    else {
+      message_prepare(CTRL, SYN, ACK, capabilities);
     }
-    asio_mutex_.unlock();
 
     return true;
   }}}
@@ -261,16 +326,13 @@ namespace mazed {
   // // // // // // // // // // // // //
 
   /**
-   * Starts the TIMEOUT check cycle. The run of the loop itself doesn't start until the all threads have reached the
-   * initial barrier.
+   * Starts the TIMEOUT check cycle. The timer doesn't expire until the timeout_set() is used.
    */
   void client_handler::start_timeout()
   {{{
     timeout_.expires_at(boost::posix_time::pos_infin);
-    timeout_.async_wait(boost::bind(&client_handler::check_timeout, this, asio::placeholders::error));
-
-    init_barrier_.wait();
-    timeout_io_service_.run();
+    timeout_.async_wait(strand_.wrap(boost::bind(&client_handler::check_timeout, this, asio::placeholders::error)));
+    pending_ops_++;
 
     return;
   }}}
@@ -278,46 +340,46 @@ namespace mazed {
   
   /**
    * TIMEOUT check handler. Terminates the whole processing upon error or when the TIMEOUT has passed. Starts a new
-   * asynchronous wait in case none of previous conditions are met.
+   * asynchronous wait in case the TIMEOUT has been only postponed.
    */
   void client_handler::check_timeout(const boost::system::error_code &error)
   {{{
-    run_mutex_.lock();
-    if (run_ == true) {
-      run_mutex_.unlock();
+    pending_ops_--;
 
-      switch (error.value()) {
-        // Actual TIMEOUT was cancelled and new one was set (TIMEOUT was UPDATED):
-        case boost::system::errc::operation_canceled :
-          timeout_.async_wait(boost::bind(&client_handler::check_timeout, this, asio::placeholders::error));
-          return;
-        
-        // TIMEOUT has expired - inform the client:
-        case boost::system::errc::success :
-          message_prepare(ERROR, TIMEOUT, UPDATE, data_t {"Your connection has timed out"});
-          async_send(message_out_);
-          break;
-        
-        // Different error - log it & inform the client:
-        default :
-          log(mazed::log_level::ERROR, error.message().c_str());
-          message_prepare(ERROR, SERVER_ERROR, UPDATE, data_t {"Unknown error occured"});
-          async_send(message_out_);
-          break;
-      }
-      
-      terminate();                      // Terminating upon TIMEOUT or ERROR.
+    if (run_ == false) {
+      finish_check();                   // The processing is finished, nothing more to do.
       return;
     }
-    else {
-      run_mutex_.unlock();              // The processing is finished, nothing more to do.
+
+    // Different error - log it & inform the client:
+    if (error && error != asio::error::operation_aborted) {
+      log(mazed::log_level::ERROR, error.message().c_str());
+      message_prepare(ERROR, SERVER_ERROR, UPDATE, data_t {"Unknown error occured"});
+      async_send(message_out_);
+      terminate();
       return;
     }
+
+    // TIMEOUT has expired - inform the client:
+    if (timeout_.expires_at() <= asio::deadline_timer::traits_type::now()) {
+      log(mazed::log_level::INFO, "Client's connection has timed out");
+      message_prepare(ERROR, TIMEOUT, UPDATE, data_t {"Your connection has timed out"});
+      async_send(message_out_);
+      terminate();
+      return;
+    }
+
+    // Actual TIMEOUT was cancelled and new one was set (TIMEOUT was UPDATED):
+    timeout_.async_wait(strand_.wrap(boost::bind(&client_handler::check_timeout, this, asio::placeholders::error)));
+    pending_ops_++;
+
+    return;
   }}}
   
 
   /**
-   * Inline function for setting new TIMEOUT expiration for new waiting upon client's message arrival.
+   * Inline function for setting new TIMEOUT expiration for new waiting upon client's message arrival. The processing
+   * of the message itself doesn't block, so there's no need to postpone the TIMEOUT while processing it.
    */
   inline void client_handler::timeout_set()
   {{{
@@ -325,256 +387,399 @@ namespace mazed {
     return;
   }}}
 
+  // // // // // // // // // // // // //
 
   /**
-   * Inline function for postponing the TIMEOUT to infinity so we doesn't timeout why processing the client's message.
-   * There's possibility it can take some time.
+   * Starts the asynchronous receive of next message, which resumes the coroutine.
    */
-  inline void client_handler::timeout_stop()
+  void client_handler::async_receive()
   {{{
-    timeout_.expires_from_now(boost::posix_time::pos_infin);
+    if (multiplexed_ == true) {
+      pu_tcp_connect_->async_read(frame_in_, strand_.wrap(boost::bind(&client_handler::process, this,
+                                                                      asio::placeholders::error)));
+    }
+    else {
+      pu_tcp_connect_->async_read(messages_in_, strand_.wrap(boost::bind(&client_handler::process, this,
+                                                                         asio::placeholders::error)));
+    }
+
     return;
   }}}
 
-  // // // // // // // // // // // // //
- 
+
   /**
-   * Start the asynchronous receive/send loop when the initial barrier is passed.
-   */  
-  void client_handler::start_asio_loop()
+   * Checks the result of the asynchronous receive and logs the reason of the connection's end, if any.
+   *
+   * @return  'true' if the message was received, 'false' otherwise.
+   */
+  bool client_handler::receive_success(const boost::system::error_code &error)
   {{{
-    init_barrier_.wait();
-    asio_loop_receive();
-    io_service_.run();
+    if (!error) {
+      return true;
+    }
 
-    return;
+    // The processing has been already terminated and the reason logged:
+    if (run_ == false) {
+      return false;
+    }
+
+    switch (error.value()) {
+      case boost::asio::error::eof :
+        log(mazed::log_level::INFO, "Connection has been closed by client");
+        break;
+
+      case boost::asio::error::operation_aborted :
+        log(mazed::log_level::INFO, "Client's connection has timed out");
+        break;
+
+      default :
+        log(mazed::log_level::ERROR, error.message().c_str());
+        break;
+    }
+
+    run_ = false;
+    return false;
+  }}}
+
+
+  /**
+   * Tests the message received - the protocol expects only one actual message in client's request. Informs the client
+   * if the message isn't valid.
+   *
+   * @return  'true' if the message is valid, 'false' otherwise.
+   */
+  bool client_handler::message_check()
+  {{{
+    if (messages_in_.size() == 1) {
+      return true;
+    }
+
+    if (messages_in_.size() == 0) {
+      message_prepare(ERROR, EMPTY_MESSAGE, UPDATE, data_t {"Empty message received"});
+      log(mazed::log_level::ERROR, "Message with no content received");
+    }
+    else {
+      message_prepare(ERROR, MULTIPLE_MESSAGES, UPDATE, data_t {"Multiple messages received"});
+      log(mazed::log_level::ERROR, "Multiple messages received");
+    }
+    
+    async_send(message_out_);           // Inform the client.
+    return false;
   }}}
 
 
   /**
-   * Starts the asynchronous receive with appropriate handler.
+   * Queues the message to be sent to the client. Messages are sent in the same order they were queued. This member
+   * function has to be called within the client handler's strand.
+   *
+   * @param[in]   msg Message to be sent.
    */
-  void client_handler::asio_loop_receive()
+  void client_handler::async_send(protocol::message &msg)
   {{{
-    pu_tcp_connect_->async_read(messages_in_, boost::bind(&client_handler::asio_loop_receive_handler, this,
-                                                          asio::placeholders::error));
+    frames_out_.emplace_back();
+    frames_out_.back().frame.channel = LOBBY;
+    frames_out_.back().frame.msg = msg;
+    frame_send();
+
     return;
   }}}
 
 
   /**
-   * Handles the incoming message and prepares it for use by the main loop. Terminates the processing upon error.
+   * Single use ASYNC send of the game update to a client. Used by the game::player when the game channel is multiplexed
+   * over the client's connection. The update is passed to the client handler's strand, so it can be called from any
+   * thread.
+   *
+   * @param[in]   upd     Update to be sent.
+   * @param[in]   delay   Delay of the sending in ms given by the pacing of the updates.
    */
-  void client_handler::asio_loop_receive_handler(const boost::system::error_code &error)
+  void client_handler::async_send(const protocol::update &upd, long delay)
   {{{
-    if (error) {
-      switch (error.value()) {
-        case boost::asio::error::eof :
-          log(mazed::log_level::INFO, "Connection has been closed by client");
-          break;
+    frame_out frame;
 
-        case boost::asio::error::operation_aborted :
-          log(mazed::log_level::INFO, "Client's connection has timed out");
-          break;
+    frame.frame.channel = GAME_UPDATE;
+    frame.frame.upd = upd;
+    frame.delta = (upd.type == DELTA);
 
-        default :
-          log(mazed::log_level::ERROR, error.message().c_str());
-          break;
-      }
+    strand_.post(boost::bind(&client_handler::frame_queue, this, frame, delay));
+    return;
+  }}}
 
-      terminate();
-      return;
-    }
-    
-    // Acquiring ASIO mutex lock so we don't compete with other ASIO single run receive handler.
-    boost::unique_lock<boost::mutex> asio_lock(asio_mutex_);
-
-    // Testing the message received - the protocol expects only one actual message in client's request:
-    if (messages_in_.size() != 1) {
-      if (messages_in_.size() == 0) {
-        message_prepare(ERROR, EMPTY_MESSAGE, UPDATE, data_t {"Empty message received"});
-        log(mazed::log_level::ERROR, "Message with no content received");
-      }
-      else {
-        message_prepare(ERROR, MULTIPLE_MESSAGES, UPDATE, data_t {"Multiple messages received"});
-        log(mazed::log_level::ERROR, "Multiple messages received");
-      }
-      
-      async_send(message_out_);         // Inform the client.
-      asio_loop_receive();              // We're not processing wrong messages, start receiving again!
-      return;
-    }
 
-    action_req_mutex_.lock();
-    {
-      message_in_ = messages_in_[0];    // Store the message into temporary storage so we don't block next message.
-      action_req_.notify_one();         // Inform the main loop.
-    }
-    action_req_mutex_.unlock();
+  /**
+   * Single use ASYNC send of the game update encoded once for all the players of the game. Only the last_move of the
+   * player is encoded for this client. Can be used only when the binary format is used.
+   *
+   * @param[in]   ps_encoded  Game update encoded by the protocol::tcp_serialization::encode_shared().
+   * @param[in]   last_move   Result of the player's last move.
+   * @param[in]   delta       The encoded update is DELTA update.
+   * @param[in]   delay       Delay of the sending in ms given by the pacing of the updates.
+   */
+  void client_handler::async_send(const std::shared_ptr<const std::vector<char>> &ps_encoded,
+                                  protocol::E_move_result last_move, bool delta, long delay)
+  {{{
+    frame_out frame;
 
-    // Check if we should continue so we don't deadlock:
-    run_mutex_.lock();
-    if (run_ == false) {
-      run_mutex_.unlock();
-      return;
-    }
-    run_mutex_.unlock();
+    frame.frame.channel = GAME_UPDATE;
+    frame.ps_encoded = ps_encoded;
+    frame.last_move = last_move;
+    frame.delta = delta;
 
-    asio_continue_.wait(asio_lock);     // Wait until the messages to be sent isn't ready.
+    strand_.post(boost::bind(&client_handler::frame_queue, this, frame, delay));
+    return;
+  }}}
 
-    // Check again to avoid sending on already closed socket:
-    run_mutex_.lock();
-    if (run_ == false) {
-      run_mutex_.unlock();
-      return;
-    }
-    run_mutex_.unlock();
-    
-    asio_loop_send();
 
+  /**
+   * Informs the client handler its game has finished. The player is released within the client handler's strand, so
+   * it can be called from any thread.
+   */
+  void client_handler::game_finished()
+  {{{
+    strand_.post(boost::bind(&client_handler::game_finished_handler, this));
     return;
   }}}
 
 
   /**
-   * Send the prepared message to the client. This member function synchronizes with single use send function.
+   * Releases the player and the game instance of the finished game.
    */
-  void client_handler::asio_loop_send()
+  void client_handler::game_finished_handler()
   {{{
-    output_mutex_.lock();
-    {
-      messages_out_[0] = message_out_;
-      pu_tcp_connect_->async_write(messages_out_, boost::bind(&client_handler::asio_loop_send_handler, this,
-                                                              asio::placeholders::error));
-    }
-    output_mutex_.unlock();
+    player_in_game_ = false;
+    ps_instance_.reset();
+    pu_player_.reset();
 
     return;
   }}}
 
+  // // // // // // // // // // // // //
 
   /**
-   * Handler for sent message. By default only registers receive of next message. Terminates the processing upon error.
+   * Unpacks the received frame of the multiplexed connection. Lobby message is stored into the incoming messages'
+   * buffer, game command is passed directly to the player.
+   *
+   * @return  'true' if the frame contained lobby message to be processed, 'false' otherwise.
    */
-  void client_handler::asio_loop_send_handler(const boost::system::error_code &error)
+  bool client_handler::frame_unpack()
   {{{
-    if (error) {
-      message_prepare(ERROR, SERVER_ERROR, UPDATE, data_t {"Unknown error occured"});
-      async_send(message_out_);
+    switch (frame_in_.channel) {
+      case LOBBY :
+        messages_in_.resize(1);
+        messages_in_[0] = std::move(frame_in_.msg);
+        return true;
+
+      case GAME_COMMAND :
+        if (pu_player_) {
+          pu_player_->process_command(frame_in_.cmd);
+        }
+        else {
+          log(mazed::log_level::ERROR, "Game command received without joined game");
+        }
+        return false;
 
-      log(mazed::log_level::ERROR, error.message().c_str());
-      terminate();
-
-      return;
+      default :
+        message_prepare(ERROR, WRONG_PROTOCOL, UPDATE, data_t {"Unknown channel of the frame"});
+        async_send(message_out_);
+        log(mazed::log_level::ERROR, "Frame with unknown channel received");
+        return false;
     }
-
-    asio_loop_receive();
-    return;
   }}}
 
-  // // // // // // // // // // // // //
 
   /**
-   * Single use ASYNC receive from a client. Otherwise this is the same as asio_loop_receive() member function.
+   * Queues the frame passed from another thread, unless the processing has already finished. Delayed frame is held
+   * back until the pacing timer expires. Only one frame is held back at a time, if the previous one is still waiting,
+   * it's queued immediately, so the updates are never reordered.
+   *
+   * @param[in]   frame   Frame to be sent.
+   * @param[in]   delay   Delay of the sending in ms, 0 for immediate sending.
    */
-  void client_handler::async_receive()
+  void client_handler::frame_queue(const frame_out &frame, long delay)
   {{{
-    pu_tcp_connect_->async_read(messages_in_, boost::bind(&client_handler::async_receive_handler, this,
-                                                          asio::placeholders::error));
+    if (coroutine_.is_complete() == true) {
+      return;
+    }
+
+    if (frame.frame.channel == GAME_UPDATE && frame_update_check(frame) == false) {
+      return;
+    }
+
+    if (frame_paced_ == true) {
+      frame_push(paced_frame_);
+      frame_paced_ = false;
+    }
+
+    if (delay > 0) {
+      paced_frame_ = frame;
+      frame_paced_ = true;
+
+      // NOTE: Waiting for the previous frame is cancelled by this:
+      pacing_timer_.expires_from_now(boost::posix_time::milliseconds(delay));
+      pacing_timer_.async_wait(strand_.wrap(boost::bind(&client_handler::frame_pace_handler, this,
+                                                        asio::placeholders::error)));
+      pending_ops_++;
+    }
+    else {
+      frame_push(frame);
+    }
+
+    frame_send();
     return;
   }}}
 
 
   /**
-   * Same handler as async_loop_receive_handler(), except it doesn't start the wait for sending a response to the client
-   * back.
+   * Checks the game update before it's queued. When the client doesn't keep up with the game, the queue of its updates
+   * would grow without any limit. Once FRAMES_OUT_UPDATES_MAX updates are waiting, all of them are dropped and the
+   * KEYFRAME is requested from the player instead, so the missed updates are folded into it. The DELTA updates are
+   * dropped until the KEYFRAME arrives, because they don't make any sense without the previous ones.
+   *
+   * @param[in]   frame   Frame with the game update to be queued.
+   * @return      'true' if the update should be queued, 'false' if it's dropped.
    */
-  void client_handler::async_receive_handler(const boost::system::error_code &error)
+  bool client_handler::frame_update_check(const frame_out &frame)
   {{{
-    if (error) {
-      switch (error.value()) {
-        case boost::asio::error::eof :
-          log(mazed::log_level::INFO, "Connection has been closed by client");
-          break;
+    if (frame.delta == false) {
+      keyframe_awaited_ = false;
+    }
+    else if (keyframe_awaited_ == true) {
+      return false;
+    }
 
-        case boost::asio::error::operation_aborted :
-          log(mazed::log_level::INFO, "Client's connection has timed out");
-          break;
+    if (updates_queued_ + ((frame_paced_ == true) ? 1 : 0) < FRAMES_OUT_UPDATES_MAX) {
+      return true;
+    }
 
-        default :
-          log(mazed::log_level::ERROR, error.message().c_str());
-          break;
+    // Dropping the queued updates, while keeping the lobby messages:
+    std::deque<frame_out> frames_kept;
+    std::deque<frame_out>::iterator it_frame;
+
+    for (it_frame = frames_out_.begin(); it_frame != frames_out_.end(); it_frame++) {
+      if ((*it_frame).frame.channel != GAME_UPDATE) {
+        frames_kept.push_back(std::move(*it_frame));
       }
+    }
 
-      terminate();
-      return;
+    frames_out_.swap(frames_kept);
+    updates_queued_ = 0;
+    frame_paced_ = false;               // Nothing is sent when the pacing timer expires.
+
+    log(mazed::log_level::INFO, "Client doesn't keep up with the game, the updates are folded into KEYFRAME");
+
+    if (frame.delta == false) {
+      return true;                      // The KEYFRAME replaces all the updates dropped.
     }
-    
-    // Acquiring ASIO mutex lock so we don't compete with other ASIO single run receive handler.
-    boost::unique_lock<boost::mutex> asio_lock(asio_mutex_);
-
-    // Testing the message received - the protocol expects only one actual message in client's request:
-    if (messages_in_.size() != 1) {
-      if (messages_in_.size() == 0) {
-        message_prepare(ERROR, EMPTY_MESSAGE, UPDATE, data_t {"Empty message received"});
-        log(mazed::log_level::ERROR, "Message with no content received");
-      }
-      else {
-        message_prepare(ERROR, MULTIPLE_MESSAGES, UPDATE, data_t {"Multiple messages received"});
-        log(mazed::log_level::ERROR, "Multiple messages received");
-      }
-      
-      async_send(message_out_);         // Inform the client.
-      asio_loop_receive();              // We're not processing wrong messages, start receiving again!
-      return;
+
+    keyframe_awaited_ = true;
+
+    if (pu_player_) {
+      protocol::command keyframe_request;
+
+      keyframe_request.cmd = KEYFRAME_REQUEST;
+      pu_player_->process_command(keyframe_request);
     }
 
-    action_req_mutex_.lock();
-    {
-      message_in_ = messages_in_[0];    // Store the message into temporary storage so we don't block next message.
-      action_req_.notify_one();         // Inform the main loop.
+    return false;
+  }}}
+
+
+  /**
+   * Appends the frame to the queue of the frames waiting for sending.
+   */
+  void client_handler::frame_push(const frame_out &frame)
+  {{{
+    frames_out_.push_back(frame);
+
+    if (frame.frame.channel == GAME_UPDATE) {
+      updates_queued_++;
     }
-    action_req_mutex_.unlock();
 
     return;
   }}}
 
 
   /**
-   * Single use ASYNC send to a client. This function can be used by the game instance, therefore it needs a reference
-   * to a message to be send to the client. Otherwise it is the same as async_loop_send(). It uses synchronization so
-   * the message aren't break upon sending.
-   *
-   * @param[in]   msg Message to be sent.
+   * Handler for expired pacing timer. Queues the frame held back for sending.
    */
-  void client_handler::async_send(protocol::message &msg)
+  void client_handler::frame_pace_handler(const boost::system::error_code &error)
   {{{
-    output_mutex_.lock();
-    {
-      messages_out_[0] = msg;
-      pu_tcp_connect_->async_write(messages_out_, boost::bind(&client_handler::empty_handler, this,
-                                                              asio::placeholders::error));
+    pending_ops_--;
+
+    if (!error && frame_paced_ == true) {
+      frame_push(paced_frame_);
+      frame_paced_ = false;
+      frame_send();
     }
-    output_mutex_.unlock();
+
+    finish_check();
+    return;
+  }}}
+
+
+  /**
+   * Starts sending of the first queued frame, unless another frame is being sent right now. The frames are sent one by
+   * one, so the serialized data of one frame aren't overwritten by another. Unless the game channel is multiplexed,
+   * only the message of the frame is sent.
+   */
+  void client_handler::frame_send()
+  {{{
+    if (frames_sending_ == true || frames_out_.empty() == true) {
+      return;
+    }
+
+    frames_sending_ = true;
+    pending_ops_++;
+
+    if (frames_out_.front().ps_encoded) {
+      pu_tcp_connect_->async_write_shared(frames_out_.front().ps_encoded, frames_out_.front().last_move,
+                                          strand_.wrap(boost::bind(&client_handler::frame_send_handler, this,
+                                                                   asio::placeholders::error)));
+    }
+    else if (multiplexed_ == true) {
+      pu_tcp_connect_->async_write(frames_out_.front().frame,
+                                   strand_.wrap(boost::bind(&client_handler::frame_send_handler, this,
+                                                            asio::placeholders::error)));
+    }
+    else {
+      messages_out_[0] = std::move(frames_out_.front().frame.msg);
+      pu_tcp_connect_->async_write(messages_out_, strand_.wrap(boost::bind(&client_handler::frame_send_handler,
+                                                                           this, asio::placeholders::error)));
+    }
+
+    if (frames_out_.front().frame.channel == GAME_UPDATE) {
+      updates_queued_--;
+    }
+
+    frames_out_.pop_front();            // The frame has been already serialized.
 
     return;
   }}}
 
 
   /**
-   * Handler for sent message. By default does nothing. Terminates the processing upon error.
+   * Handler for sent frame. Continues with sending of next queued frame. Terminates the processing upon error.
    */
-  void client_handler::empty_handler(const boost::system::error_code &error)
+  void client_handler::frame_send_handler(const boost::system::error_code &error)
   {{{
+    pending_ops_--;
+    frames_sending_ = false;
+
     if (error) {
-      message_prepare(ERROR, SERVER_ERROR, UPDATE, data_t {"Unknown error occured"});
-      async_send(message_out_);
+      frames_out_.clear();
+      updates_queued_ = 0;
 
-      log(mazed::log_level::ERROR, error.message().c_str());
-      terminate();
+      if (run_ == true) {
+        log(mazed::log_level::ERROR, error.message().c_str());
+        terminate();
+      }
+    }
+    else {
+      frame_send();
     }
 
-    return;   // Nothing to do - single message send.
+    finish_check();
+    return;
   }}}
 
   // // // // // // // // // // // // //
@@ -597,23 +802,107 @@ namespace mazed {
   }}}
 
   
+  /**
+   * Handles the client's login. The player of the given UID is created first if it doesn't exist yet, with the nick
+   * given (or the UID if there's none). Clients which don't log in keep playing as the default player.
+   */
   void client_handler::LOGIN_OR_CREATE_USER_handler()
   {{{
+    if (player_in_game_ == true) {
+      message_prepare(ERROR, ALREADY_IN_GAME, UPDATE, data_t {"You're already in game, terminate/leave it first"});
+      return;
+    }
+
+    std::string uid = (message_in_.data.empty() == true) ? "" : message_in_.data[0];
+    std::string nick = (message_in_.data.size() < 2) ? "" : message_in_.data[1];
+
+    switch (ps_shared_res_->p_players_store->login_or_create(uid, nick)) {
+      case mazed::players_store::OK :
+      case mazed::players_store::CREATED :
+        player_UID_ = uid;
+        player_nick_ = nick;
+        player_logged_ = true;
+        message_prepare(CTRL, LOGIN_OR_CREATE_USER, ACK, data_t {uid, nick});
+        break;
+
+      case mazed::players_store::NICK_TAKEN :
+        message_prepare(CTRL, LOGIN_OR_CREATE_USER, NACK, data_t {"The nick is already taken"});
+        break;
+
+      case mazed::players_store::INVALID :
+        message_prepare(CTRL, LOGIN_OR_CREATE_USER, NACK, data_t {"Invalid UID or nick"});
+        break;
+
+      default :
+        log(mazed::log_level::ERROR, "Failed to store new player");
+        message_prepare(ERROR, SERVER_ERROR_INFO, UPDATE, data_t {"Server failed to store the player"});
+        break;
+    }
+
     return;
   }}}
 
-  
+
+  /**
+   * Handles the client's request for changing the nick of the logged player. The nick is used from the next game.
+   */
   void client_handler::SET_NICK_handler()
   {{{
+    if (player_logged_ == false) {
+      message_prepare(CTRL, SET_NICK, NACK, data_t {"You have to log in first"});
+      return;
+    }
+
+    std::string nick = (message_in_.data.empty() == true) ? "" : message_in_.data[0];
+
+    switch (ps_shared_res_->p_players_store->change_nick(player_UID_, nick)) {
+      case mazed::players_store::OK :
+        player_nick_ = nick;
+        message_prepare(CTRL, SET_NICK, ACK, data_t {nick});
+        break;
+
+      case mazed::players_store::NICK_TAKEN :
+        message_prepare(CTRL, SET_NICK, NACK, data_t {"The nick is already taken"});
+        break;
+
+      case mazed::players_store::INVALID :
+        message_prepare(CTRL, SET_NICK, NACK, data_t {"Invalid nick"});
+        break;
+
+      default :
+        log(mazed::log_level::ERROR, "Failed to store the nick of player");
+        message_prepare(ERROR, SERVER_ERROR_INFO, UPDATE, data_t {"Server failed to store the nick"});
+        break;
+    }
+
     return;
   }}}
 
   
   /**
-   * Handles the client's request for displaying available mazes to play.
+   * Handles the client's request for displaying available mazes to play. With the LIST_MAZES_* parameters only one
+   * page of the matching mazes is sent, along with their metadata.
    */
   void client_handler::LIST_MAZES_handler()
   {{{
+    // NOTE: Empty strings are not parameters, the message's data is {""} by default.
+    if (static_cast<std::size_t>(std::count(message_in_.data.begin(), message_in_.data.end(), std::string())) !=
+        message_in_.data.size()) {
+      mazed::mazes_manager::mazes_filter filter;
+      std::vector<std::string> page;
+
+      if (mazed::mazes_manager::parse_filter(message_in_.data, filter) == false) {
+        message_prepare(CTRL, LIST_MAZES, NACK, data_t {"Invalid LIST_MAZES query"});
+        return;
+      }
+
+      std::size_t total = ps_shared_res_->p_mazes_manager->query_mazes(filter, page);
+
+      page.insert(page.begin(), "total=" + std::to_string(total));
+      message_prepare(CTRL, LIST_MAZES, ACK, page);
+      return;
+    }
+
     std::vector<std::string> mazes = ps_shared_res_->p_mazes_manager->list_mazes();
 
     if (mazes.size() == 0) {
@@ -639,8 +928,37 @@ namespace mazed {
   }}}
 
 
+  /**
+   * Handles the client's request for displaying running games to join. Every game is sent as
+   * "UID;maze;status;used_slots" followed by the ";nick" of every player. The registry is read without any locking.
+   */
   void client_handler::LIST_RUNNING_handler()
   {{{
+    mazed::games_registry::games_snapshot snapshot = ps_shared_res_->p_games_registry->get_games();
+    mazed::games_registry::games_snapshot::const_iterator it_shard;
+    mazed::games_registry::games_table::const_iterator it_game;
+    std::vector<std::string>::const_iterator it_nick;
+    std::vector<std::string> games;
+
+    for (it_shard = snapshot.begin(); it_shard != snapshot.end(); it_shard++) {
+      for (it_game = (*it_shard)->begin(); it_game != (*it_shard)->end(); it_game++) {
+        if ((*it_game).uid == 0) {
+          continue;
+        }
+
+        const protocol::game_info &info = *(*it_game).ps_info;
+        std::string game = info.UID + ";" + info.maze_name + ";" + std::to_string(info.status) + ";" +
+                           std::to_string(info.used_slots);
+
+        for (it_nick = info.players.begin(); it_nick != info.players.end(); it_nick++) {
+          game += ";" + *it_nick;
+        }
+
+        games.push_back(game);
+      }
+    }
+
+    message_prepare(CTRL, LIST_RUNNING, ACK, games);
     return;
   }}}
 
@@ -660,6 +978,24 @@ namespace mazed {
       return;
     }
 
+    // The creator of the game plays from the 1st starting block:
+    const game::maze_layout::analysis_result &analysis = p_maze->get_analysis(0);
+
+    if (analysis.solvable == false) {
+      delete p_maze;
+      message_prepare(ERROR, MAZE_BROKEN, UPDATE, data_t {"The maze can't be finished, its target can't be reached"});
+      log(mazed::log_level::ERROR, "Refused to create game of unsolvable maze");
+      return;
+    }
+
+    std::pair<unsigned long, unsigned long> stats = ps_shared_res_->p_mazes_manager->templates_stats();
+    std::string stats_str = "Maze created, templates cache: " + std::to_string(stats.first) + " hits, " +
+                            std::to_string(stats.second) + " misses, maze " + std::to_string(p_maze->memory_size()) +
+                            " B + shared layout " + std::to_string(p_maze->layout_memory_size()) + " B, at least " +
+                            std::to_string(analysis.min_moves) + " moves & " +
+                            std::to_string(analysis.keys_used) + " keys to finish";
+    log(mazed::log_level::INFO, stats_str.c_str());
+
     pu_player_ = std::unique_ptr<game::player>(new game::player(player_UID_, player_auth_key_, player_nick_, this));
     
     game::instance *p_instance_loc = new game::instance(p_maze, player_UID_, ps_shared_res_, this);
@@ -676,30 +1012,149 @@ namespace mazed {
   }}}
 
 
+  /**
+   * Handles the client's request for loading the saved game. The game is restored into new instance, which the client
+   * joins as the game owner, the same as with the CREATE_GAME. The time of the loading is logged.
+   */
   void client_handler::LOAD_GAME_handler()
   {{{
+    if (player_in_game_ == true) {
+      message_prepare(ERROR, ALREADY_IN_GAME, UPDATE, data_t {"You're already in game, terminate/leave it first"});
+      return;
+    }
+
+    std::string save_name = (message_in_.data.empty() == true) ? "" : message_in_.data[0];
+    std::chrono::steady_clock::time_point started = std::chrono::steady_clock::now();
+
+    game::maze *p_maze = ps_shared_res_->p_mazes_manager->load_game(save_name);
+
+    long load_us = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() -
+                                                                         started).count();
+
+    if (p_maze == NULL) {
+      message_prepare(ERROR, MAZE_BROKEN, UPDATE, data_t {"The saved game couldn't be loaded"});
+      log(mazed::log_level::ERROR, "Failed to load broken or outdated save");
+      return;
+    }
+
+    std::string load_str = "Game loaded from " + save_name + " in " + std::to_string(load_us) + " us";
+    log(mazed::log_level::INFO, load_str.c_str());
+
+    pu_player_ = std::unique_ptr<game::player>(new game::player(player_UID_, player_auth_key_, player_nick_, this));
+
+    game::instance *p_instance_loc = new game::instance(p_maze, player_UID_, ps_shared_res_, this);
+
+    p_instance_loc->add_player(pu_player_.get());
+    ps_instance_ = p_instance_loc->run();
+    pu_player_->run();
+    player_in_game_ = true;
+
+    message_prepare(CTRL, LOAD_GAME, ACK,
+                    data_t {std::to_string(pu_player_->port()), player_auth_key_, p_maze->get_scheme(),
+                            std::to_string(p_maze->get_rows()), std::to_string(p_maze->get_cols())});
     return;
   }}}
 
 
+  /**
+   * Handles the client's request for saving the game being played. Only the snapshot of the game is taken here, it's
+   * written by the save engine afterwards, so the ACK doesn't wait for the disk. The result is logged by the server.
+   */
   void client_handler::SAVE_GAME_handler()
   {{{
+    if (player_in_game_ == false || !ps_instance_) {
+      message_prepare(ERROR, NO_JOINED_GAME, UPDATE, data_t {"You're not in any game to save"});
+      return;
+    }
+
+    std::string save_name = (message_in_.data.empty() == true) ? "" : message_in_.data[0];
+    std::string file_name = ps_shared_res_->p_mazes_manager->save_file_name(save_name);
+
+    if (file_name.empty() == true) {
+      message_prepare(CTRL, SAVE_GAME, NACK, data_t {"Invalid name of the save"});
+      return;
+    }
+
+    std::shared_ptr<game::snapshot> ps_snapshot = std::make_shared<game::snapshot>();
+    long stall_us;
+
+    if (ps_instance_->snapshot(player_UID_, *ps_snapshot, stall_us) == false) {
+      message_prepare(ERROR, NOT_OWNER, UPDATE, data_t {"You can't save game you did not create"});
+      return;
+    }
+
+    if (ps_shared_res_->p_save_engine->submit(ps_snapshot, file_name, stall_us) == false) {
+      log(mazed::log_level::ERROR, "Too many saves waiting for writing");
+      message_prepare(ERROR, SERVER_ERROR_INFO, UPDATE, data_t {"Server is busy with saving, try it again later"});
+      return;
+    }
+
+    message_prepare(CTRL, SAVE_GAME, ACK, data_t {file_name});
     return;
   }}}
 
 
+  /**
+   * Handles the client's request for joining the game of the given UID (see the LIST_RUNNING), or any running game if
+   * there's no UID given. The game is looked up in the games_registry without any locking, so the game found might
+   * have been stopped meanwhile - such game refuses the player & it's not listed anymore.
+   */
   void client_handler::JOIN_GAME_handler()
   {{{
+    if (player_in_game_ == true) {
+      message_prepare(ERROR, ALREADY_IN_GAME, UPDATE, data_t {"You're already in game, terminate/leave it first"});
+      return;
+    }
+
+    std::string game_UID = (message_in_.data.empty() == true) ? "" : message_in_.data[0];
+    std::shared_ptr<game::instance> ps_instance;
+
     pu_player_ = std::unique_ptr<game::player>(new game::player(player_UID_, player_auth_key_, player_nick_, this));
 
-    ps_shared_res_->access_mutex.lock();
-    {
-      ps_instance_ = ps_shared_res_->game_instances.front();
+    if (game_UID.empty() == false) {
+      ps_instance = ps_shared_res_->p_games_registry->find(game_UID);
+
+      if (ps_instance && ps_instance->add_player(pu_player_.get()) == false) {
+        // The game still listed is full, otherwise it has been stopped:
+        if (ps_shared_res_->p_games_registry->find(game_UID)) {
+          pu_player_.reset();
+          message_prepare(CTRL, JOIN_GAME, NACK, data_t {"The game is full"});
+          return;
+        }
+
+        ps_instance.reset();
+      }
+    }
+    else {
+      mazed::games_registry::games_snapshot snapshot = ps_shared_res_->p_games_registry->get_games();
+      mazed::games_registry::games_snapshot::const_iterator it_shard;
+      mazed::games_registry::games_table::const_iterator it_game;
+
+      for (it_shard = snapshot.begin(); it_shard != snapshot.end() && !ps_instance; it_shard++) {
+        for (it_game = (*it_shard)->begin(); it_game != (*it_shard)->end() && !ps_instance; it_game++) {
+          // Empty slots have no instance, finished & full games are skipped:
+          if (!(*it_game).ps_instance || (*it_game).ps_info->status == protocol::E_game_status::FINISHED ||
+              (*it_game).ps_info->used_slots >= GAME_MAX_PLAYERS) {
+            continue;
+          }
+
+          // The game might have been filled or stopped meanwhile, then the next one is tried:
+          if ((*it_game).ps_instance->add_player(pu_player_.get()) == true) {
+            ps_instance = (*it_game).ps_instance;
+          }
+        }
+      }
     }
-    ps_shared_res_->access_mutex.unlock();
 
-    ps_instance_->add_player(pu_player_.get());
+    if (!ps_instance) {
+      pu_player_.reset();
+      message_prepare(ERROR, NO_GAME_RUNNING, UPDATE, data_t {"There's no such game running"});
+      return;
+    }
+
+    ps_instance_ = ps_instance;
     pu_player_->run();
+    player_in_game_ = true;
 
     message_prepare(CTRL, JOIN_GAME, ACK,
                     data_t {std::to_string(pu_player_->port()), player_auth_key_, ps_instance_->get_scheme(),
@@ -722,6 +1177,12 @@ namespace mazed {
 
   void client_handler::TERMINATE_GAME_handler()
   {{{
+    // The game might have already finished, or it has never been created:
+    if (!ps_instance_) {
+      message_prepare(CTRL, TERMINATE_GAME, NACK, data_t {"There's no game to terminate"});
+      return;
+    }
+
     if (ps_instance_->stop(player_UID_) == true) {
       player_in_game_ = false;
       message_prepare(CTRL, TERMINATE_GAME, ACK);
@@ -899,6 +1360,8 @@ namespace mazed {
   }}}
 }
 
+#include <boost/asio/unyield.hpp>
+
 /* ****************************************************************************************************************** *
  * ***[ END OF MAZED_CL_HANDLER.CC ]********************************************************************************* *
  * ****************************************************************************************************************** */
@@ -18,11 +18,14 @@
  ~ ~~~[ HEADER FILES ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ ~
  * ****************************************************************************************************************** */
 
+#include <deque>
 #include <fstream>
+#include <functional>
 #include <memory>
 #include <vector>
 
 #include <boost/asio.hpp>
+#include <boost/asio/coroutine.hpp>
 #include <boost/thread.hpp>
 
 #include "mazed_globals.hh"
@@ -45,9 +48,12 @@ namespace game {
 
 namespace mazed {
 
+  #define FRAMES_OUT_UPDATES_MAX  16U   // Game updates queued for slow client before they're folded into a KEYFRAME.
+
   /**
-   * Complex class for handling the client's requests, starting the game instances and synchronizing threads used for
-   * handling the clients requests. This class uses 3 threads just for running. Do not mess with the synchronization!
+   * Complex class for handling the client's requests and starting the game instances. The client's requests are
+   * processed by stackless coroutine running on the given io_service, so no threads are dedicated to the client. All
+   * the handlers are serialized by the strand. Do not call the private member functions outside of the strand!
    *
    * @note The game instance itself is started in another thread, which is running independently.
    */
@@ -58,28 +64,33 @@ namespace mazed {
       using tcp = boost::asio::ip::tcp;
       using data_t = std::vector<std::string>;      // Typedef to decrease the space needed for sending text to client.
 
+      // Frame waiting for sending. Game update shared with other clients is already encoded:
+      struct frame_out {
+        protocol::frame                             frame;
+        std::shared_ptr<const std::vector<char>>    ps_encoded;
+        protocol::E_move_result                     last_move;
+        bool                                        delta {false};
+      };
+
       // References to already opened connection:
       tcp::socket                                   &socket_;
       asio::io_service                              &io_service_;
+      asio::io_service::strand                      strand_;
       
       std::shared_ptr<mazed::shared_resources>      ps_shared_res_;
 
       // Pointer to serialization over the established connection:
       std::unique_ptr<protocol::tcp_serialization>  pu_tcp_connect_;
       
-      // Objects for checking client's connection timeout:
-      asio::io_service                              timeout_io_service_;
+      // State of the processing coroutine:
+      asio::coroutine                               coroutine_;
+      bool                                          run_ {true};
+      bool                                          finished_ {false};
+      unsigned                                      pending_ops_ {0};         // Timer waits & frames being sent.
+      std::function<void()>                         finish_handler_;
+
+      // Object for checking client's connection timeout:
       asio::deadline_timer                          timeout_;
-
-      // Necessary objects for proper synchronization:
-      boost::condition_variable                     action_req_;
-      boost::condition_variable                     asio_continue_;
-      boost::mutex                                  action_req_mutex_;
-      boost::mutex                                  asio_mutex_;
-      boost::mutex                                  output_mutex_;
-      boost::upgrade_mutex                          run_mutex_;
-      boost::barrier                                init_barrier_;
-      bool run_                                     {true};
       
       // Logging file, logging file mutex & formatting object for date/time string:
       boost::mutex                                  log_mutex_;
@@ -92,7 +103,24 @@ namespace mazed {
       protocol::message                             message_in_;
       protocol::message                             message_out_;
 
+      // Frames' buffers used instead of messages' buffers when the game channel is multiplexed (MUX):
+      protocol::frame                               frame_in_;
+      std::deque<frame_out>                         frames_out_;
+      bool                                          frames_sending_ {false};
+      unsigned                                      updates_queued_ {0};      // Game updates within frames_out_.
+      bool                                          keyframe_awaited_ {false};  // DELTA updates are dropped.
+
+      // Game update delayed by the pacing, so the updates of one tick aren't sent in a burst:
+      asio::deadline_timer                          pacing_timer_;
+      frame_out                                     paced_frame_;
+      bool                                          frame_paced_ {false};
+      bool                                          mux_accepted_ {false};
+      bool                                          binary_accepted_ {false};
+      bool                                          delta_accepted_ {false};
+      bool                                          multiplexed_ {false};
+
       bool                                          player_in_game_ {false};
+      bool                                          player_logged_ {false};
       std::string                                   player_auth_key_ {"Hello!"};
       std::string                                   player_nick_ {"THIS IS NICK!"};
       std::string                                   player_UID_ {"abc1234"};
@@ -126,13 +154,17 @@ namespace mazed {
 
     public:
       client_handler(tcp::socket &sckt, asio::io_service &io_serv, mazed::settings_tuple &settings,
-                     const std::shared_ptr<mazed::shared_resources> ptr, unsigned conn_num);
+                     const std::shared_ptr<mazed::shared_resources> ptr, unsigned conn_num,
+                     std::function<void()> finish_handler = nullptr);
      ~client_handler();
       void run();
 
     private:
-      void run_processing();
+      void process(const boost::system::error_code &error);
+      void process_message();
       void terminate();
+      void finish();
+      void finish_check();
 
       // // // // // // // // // // //
 
@@ -143,24 +175,28 @@ namespace mazed {
       void start_timeout();
       void check_timeout(const boost::system::error_code& error);
       inline void timeout_set();
-      inline void timeout_stop();
       
       // // // // // // // // // // //
 
-      void start_asio_loop();
-
-      void asio_loop_receive();
-      void asio_loop_receive_handler(const boost::system::error_code &error);
-
-      void asio_loop_send();
-      void asio_loop_send_handler(const boost::system::error_code &error);
+      void async_receive();
+      bool receive_success(const boost::system::error_code &error);
+      bool message_check();
+      void async_send(protocol::message &msg);
+      void async_send(const protocol::update &upd, long delay = 0);
+      void async_send(const std::shared_ptr<const std::vector<char>> &ps_encoded, protocol::E_move_result last_move,
+                      bool delta, long delay = 0);
+      void game_finished();
+      void game_finished_handler();
 
       // // // // // // // // // // //
 
-      void async_receive();
-      void async_receive_handler(const boost::system::error_code &error);
-      void async_send(protocol::message &msg);
-      void empty_handler(const boost::system::error_code &error);
+      bool frame_unpack();
+      void frame_queue(const frame_out &frame, long delay);
+      bool frame_update_check(const frame_out &frame);
+      void frame_push(const frame_out &frame);
+      void frame_pace_handler(const boost::system::error_code &error);
+      void frame_send();
+      void frame_send_handler(const boost::system::error_code &error);
 
       // // // // // // // // // // //
 
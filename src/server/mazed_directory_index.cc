@@ -0,0 +1,257 @@
+/**
+ * @file      mazed_directory_index.cc
+ * @author    Dee'Kej (David Kaspar - xkaspa34)
+ * @version   0.1
+ * @brief     Contains implementations of class member functions of mazed::directory_index.
+ */
+
+
+/* ****************************************************************************************************************** *
+ * ***[ START OF MAZED_DIRECTORY_INDEX.CC ]************************************************************************** *
+ * ****************************************************************************************************************** */
+
+
+/* ****************************************************************************************************************** *
+ ~ ~~~[ HEADER FILES ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ ~
+ * ****************************************************************************************************************** */
+
+#include <string>
+#include <vector>
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/inotify.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "mazed_directory_index.hh"
+
+
+/* ****************************************************************************************************************** *
+ ~ ~~~[ MEMBER FUNCTIONS IMPLEMENTATIONS ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ ~
+ * ****************************************************************************************************************** */
+
+namespace mazed {
+
+  /**
+   * Opens the folder and starts watching it. The watch is added before the folder is scanned, so no change is missed.
+   */
+  directory_index::directory_index(const boost::filesystem::path &dir_path, const std::string &extension) :
+    extension_{extension}, ps_listing_{std::make_shared<const listing>()}
+  {{{
+    dir_fd_ = open(dir_path.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+
+    if (dir_fd_ < 0) {
+      return;
+    }
+
+    inotify_fd_ = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+
+    if (inotify_fd_ >= 0) {
+      watch_fd_ = inotify_add_watch(inotify_fd_, dir_path.c_str(), IN_CREATE | IN_DELETE | IN_CLOSE_WRITE |
+                                                                    IN_MOVED_FROM | IN_MOVED_TO | IN_ATTRIB |
+                                                                    IN_ONLYDIR);
+    }
+
+    rescan();
+    return;
+  }}}
+
+
+  directory_index::~directory_index()
+  {{{
+    if (inotify_fd_ >= 0) {
+      close(inotify_fd_);
+    }
+
+    if (dir_fd_ >= 0) {
+      close(dir_fd_);
+    }
+
+    return;
+  }}}
+
+  // // // // // // // // // // // //
+
+  /**
+   * Applies the changes of the folder since the last call.
+   *
+   * @return  true if the folder is watched, so the change handlers have been told about every change, false if the
+   *          consumers have to check the files themselves.
+   */
+  bool directory_index::refresh()
+  {{{
+    boost::lock_guard<boost::mutex> index_lock(index_mutex_);
+    return update();
+  }}}
+
+
+  /**
+   * @return  Sorted names of the regular files of the folder with the given extension.
+   */
+  std::shared_ptr<const directory_index::listing> directory_index::get_listing()
+  {{{
+    boost::lock_guard<boost::mutex> index_lock(index_mutex_);
+
+    update();
+    return ps_listing_;
+  }}}
+
+
+  /**
+   * Registers the change handler. The handler is called with the index locked, so it mustn't use the index itself.
+   */
+  void directory_index::on_change(change_handler handler)
+  {{{
+    boost::lock_guard<boost::mutex> index_lock(index_mutex_);
+
+    handlers_.push_back(handler);
+    return;
+  }}}
+
+  // // // // // // // // // // // //
+
+  bool directory_index::matches(const std::string &file_name)
+  {{{
+    std::size_t ext_length {extension_.length()};
+
+    if (file_name.length() < ext_length) {
+      return false;
+    }
+
+    return ext_length == 0 || file_name.compare(file_name.length() - ext_length, ext_length, extension_) == 0;
+  }}}
+
+
+  bool directory_index::is_regular_file(const std::string &file_name)
+  {{{
+    struct stat file_stat;
+    return fstatat(dir_fd_, file_name.c_str(), &file_stat, 0) == 0 && S_ISREG(file_stat.st_mode);
+  }}}
+
+
+  /**
+   * Reads the whole folder again and creates new snapshot of the listing.
+   */
+  void directory_index::rescan()
+  {{{
+    files_.clear();
+
+    // Own open file description of the folder, the position within it isn't shared with anyone then:
+    int list_fd = openat(dir_fd_, ".", O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    DIR *p_dir = (list_fd < 0) ? NULL : fdopendir(list_fd);
+
+    if (p_dir == NULL) {
+      if (list_fd >= 0) {
+        close(list_fd);
+      }
+
+      ps_listing_ = std::make_shared<const listing>();
+      return;
+    }
+
+    struct dirent *p_entry;
+
+    while ((p_entry = readdir(p_dir)) != NULL) {
+      if (matches(p_entry->d_name) == true && is_regular_file(p_entry->d_name) == true) {
+        files_.insert(p_entry->d_name);
+      }
+    }
+
+    closedir(p_dir);
+
+    ps_listing_ = std::make_shared<const listing>(files_.begin(), files_.end());
+    return;
+  }}}
+
+
+  /**
+   * Expects the index to be locked.
+   */
+  bool directory_index::update()
+  {{{
+    if (dir_fd_ < 0) {
+      return false;
+    }
+
+    if (watch_fd_ < 0) {
+      rescan();
+      return false;
+    }
+
+    read_events();
+    return watch_fd_ >= 0;
+  }}}
+
+
+  /**
+   * Reads all the pending inotify events. The snapshot of the listing is replaced only if the listing has changed.
+   */
+  void directory_index::read_events()
+  {{{
+    alignas(struct inotify_event) char buffer[4096];
+    ssize_t length;
+    bool changed {false};
+
+    while ((length = read(inotify_fd_, buffer, sizeof(buffer))) > 0) {
+      char *p_position = buffer;
+
+      while (p_position < buffer + length) {
+        const struct inotify_event *p_event = reinterpret_cast<const struct inotify_event *>(p_position);
+        p_position += sizeof(struct inotify_event) + p_event->len;
+
+        if ((p_event->mask & IN_Q_OVERFLOW) != 0) {
+          rescan();
+          notify("");
+          changed = false;
+          continue;
+        }
+
+        if ((p_event->mask & IN_IGNORED) != 0) {
+          watch_fd_ = -1;                           // The folder has been removed, scanning it from now on.
+          rescan();
+          notify("");
+          return;
+        }
+
+        if (p_event->len == 0) {
+          continue;
+        }
+
+        std::string file_name(p_event->name);
+
+        if ((p_event->mask & (IN_DELETE | IN_MOVED_FROM)) != 0) {
+          changed = (files_.erase(file_name) > 0) || changed;
+        }
+        else if (matches(file_name) == true && is_regular_file(file_name) == true) {
+          changed = files_.insert(file_name).second || changed;
+        }
+
+        notify(file_name);
+      }
+    }
+
+    if (changed == true) {
+      ps_listing_ = std::make_shared<const listing>(files_.begin(), files_.end());
+    }
+
+    return;
+  }}}
+
+
+  void directory_index::notify(const std::string &file_name)
+  {{{
+    std::vector<change_handler>::iterator it_handler;
+
+    for (it_handler = handlers_.begin(); it_handler != handlers_.end(); it_handler++) {
+      (*it_handler)(file_name);
+    }
+
+    return;
+  }}}
+}
+
+/* ****************************************************************************************************************** *
+ * ***[ END OF MAZED_DIRECTORY_INDEX.CC ]**************************************************************************** *
+ * ****************************************************************************************************************** */
+
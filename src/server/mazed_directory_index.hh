@@ -0,0 +1,94 @@
+/**
+ * @file      mazed_directory_index.hh
+ * @author    Dee'Kej (David Kaspar - xkaspa34)
+ * @version   0.1
+ * @brief     Contains declaration of the in-memory index of the mazes & saves folders.
+ */
+
+
+/* ****************************************************************************************************************** *
+ * ***[ START OF MAZED_DIRECTORY_INDEX.HH ]************************************************************************** *
+ * ****************************************************************************************************************** */
+
+#ifndef H_GUARD_MAZED_DIRECTORY_INDEX_HH
+#define H_GUARD_MAZED_DIRECTORY_INDEX_HH
+
+
+/* ****************************************************************************************************************** *
+ ~ ~~~[ HEADER FILES ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ ~
+ * ****************************************************************************************************************** */
+
+#include <functional>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+#include <boost/thread.hpp>
+
+
+/* ****************************************************************************************************************** *
+ ~ ~~~[ DIRECTORY_INDEX CLASS ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ ~
+ * ****************************************************************************************************************** */
+
+namespace mazed {
+
+  /**
+   * Opened folder with the sorted listing of its regular files of the given extension. The folder is scanned once and
+   * the listing is maintained from the inotify events then, so the listing is served from the memory. The events are
+   * read (without blocking) by the refresh(), before the listing is used - there's no thread needed for it, which
+   * wouldn't survive the forking of the daemon anyway. When the folder can't be watched, it's scanned upon every
+   * refresh(), as before.
+   *
+   * The change handlers are called with the name of every changed file (of any extension), or with the empty name if
+   * any file could have changed (e.g. the events queue has overflown).
+   */
+  class directory_index {
+    public:
+      using listing = std::vector<std::string>;
+      using change_handler = std::function<void(const std::string &file_name)>;
+
+    private:
+      std::string                                   extension_;
+      int                                           dir_fd_ {-1};
+      int                                           inotify_fd_ {-1};
+      int                                           watch_fd_ {-1};
+
+      boost::mutex                                  index_mutex_;
+      std::set<std::string>                         files_;
+      std::shared_ptr<const listing>                ps_listing_;      // Sorted snapshot of the files_.
+      std::vector<change_handler>                   handlers_;
+
+      // // // // // // // // // // //
+
+      bool matches(const std::string &file_name);
+      bool is_regular_file(const std::string &file_name);
+      void rescan();
+      bool update();
+      void read_events();
+      void notify(const std::string &file_name);
+
+    public:
+      directory_index(const boost::filesystem::path &dir_path, const std::string &extension);
+     ~directory_index();
+
+      bool refresh();
+      std::shared_ptr<const listing> get_listing();
+      void on_change(change_handler handler);
+
+      /**
+       * @return  File descriptor of the opened folder | -1 if it couldn't be opened.
+       */
+      int get_fd()
+      {{{
+        return dir_fd_;
+      }}}
+  };
+}
+
+/* ****************************************************************************************************************** *
+ * ***[ END OF MAZED_DIRECTORY_INDEX.HH ]**************************************************************************** *
+ * ****************************************************************************************************************** */
+
+#endif
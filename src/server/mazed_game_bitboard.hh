@@ -0,0 +1,76 @@
+/**
+ * @file      mazed_game_bitboard.hh
+ * @author    Dee'Kej (David Kaspar - xkaspa34)
+ * @version   0.1
+ * @brief     Contains the bitboard class of the maze's layers used on server-side.
+ */
+
+
+/* ****************************************************************************************************************** *
+ * ***[ START OF MAZED_GAME_BITBOARD.HH ]**************************************************************************** *
+ * ****************************************************************************************************************** */
+
+#ifndef H_GUARD_MAZED_GAME_BITBOARD_HH
+#define H_GUARD_MAZED_GAME_BITBOARD_HH
+
+
+/* ****************************************************************************************************************** *
+ ~ ~~~[ HEADER FILES ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ ~
+ * ****************************************************************************************************************** */
+
+#include <array>
+#include <cstdint>
+
+#include "mazed_game_globals.hh"
+
+
+/* ****************************************************************************************************************** *
+ ~ ~~~[ BITBOARD CLASS ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ ~
+ * ****************************************************************************************************************** */
+
+namespace game {
+
+  /**
+   * One bit layer of the maze, e.g. the walls. Every row of the maze is kept in one 64-bit word.
+   */
+  class bitboard {
+      static_assert(MAZE_MAX_SIZE <= 64, "row of the maze doesn't fit into one word of the game::bitboard");
+
+      using schar_t = signed char;
+
+      std::array<std::uint64_t, MAZE_MAX_SIZE>      rows_;          // Bit N of the row is the column N.
+
+    public:
+      bitboard()
+      {{{
+        rows_.fill(0);
+        return;
+      }}}
+
+
+      bool test(schar_t row, schar_t col) const
+      {{{
+        return (rows_[row] >> col) & 1U;
+      }}}
+
+
+      void set(schar_t row, schar_t col)
+      {{{
+        rows_[row] |= 1ULL << col;
+        return;
+      }}}
+
+
+      void reset(schar_t row, schar_t col)
+      {{{
+        rows_[row] &= ~(1ULL << col);
+        return;
+      }}}
+  };
+}
+
+/* ****************************************************************************************************************** *
+ * ***[ END OF MAZED_GAME_BITBOARD.HH ]****************************************************************************** *
+ * ****************************************************************************************************************** */
+
+#endif
@@ -18,9 +18,7 @@
  ~ ~~~[ HEADER FILES ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ ~
  * ****************************************************************************************************************** */
 
-#include <vector>
-
-#include "mazed_game_player.hh"
+#include "mazed_game_globals.hh"
 #include "../basic_block.hh"
 
 
@@ -29,15 +27,12 @@
  * ****************************************************************************************************************** */
 
 namespace game {
-  class player;
 
   /**
-   * Class of game block for server-side purposes.
+   * Class of game block for server-side purposes. It's a cell of the maze layout's flat grid - 1 byte of the block
+   * type. Players standing on the block are kept by the game::maze aside, because the layout is shared.
    */
   class block : public basic_block {
-      // Normally, list might be better, but the maximum size of the vector will be 4 - this is acceptable:
-      std::vector<game::player *>       *p_players_ {NULL};
-
     public:
       block() : basic_block()
       {{{
@@ -47,61 +42,14 @@ namespace game {
 
       ~block()
       {{{
-        delete p_players_;
         return;
       }}}
 
 
-      E_block_type get()
+      E_block_type get() const
       {{{
         return type_;
       }}}
-
-
-      inline void set(E_block_type type)
-      {{{
-        type_ = type;
-        return;
-      }}}
-
-
-      void add_player(game::player *p_player)
-      {{{
-        if (p_players_ == NULL) {
-          p_players_ = new std::vector<game::player *>();
-        }
-
-        p_players_->push_back(p_player);
-        has_player_ = true;
-
-        return;
-      }}}
-
-
-      void remove_player(game::player *p_player)
-      {{{
-        assert(has_player_ == true);
-        assert(p_players_ != NULL);
-
-        std::vector<game::player *>::iterator it;
-
-        for (it = p_players_->begin(); it != p_players_->end() && *it != p_player; it++) {
-          ;
-        }
-
-        assert(it != p_players_->end());
-        assert(*it == p_player);
-
-        p_players_->erase(it);
-
-        if (p_players_->empty() == true) {
-          delete p_players_;
-          p_players_ = NULL;
-          has_player_ = false;
-        }
-
-        return;
-      }}}
   };
 }
 
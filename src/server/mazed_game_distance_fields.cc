@@ -0,0 +1,301 @@
+/**
+ * @file      mazed_game_distance_fields.cc
+ * @author    Dee'Kej (David Kaspar - xkaspa34)
+ * @version   0.1
+ * @brief     Contains implementations of class member functions of game::distance_fields.
+ */
+
+
+/* ****************************************************************************************************************** *
+ * ***[ START OF MAZED_GAME_DISTANCE_FIELDS.CC ]********************************************************************* *
+ * ****************************************************************************************************************** */
+
+
+/* ****************************************************************************************************************** *
+ ~ ~~~[ HEADER FILES ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ ~
+ * ****************************************************************************************************************** */
+
+#include <deque>
+#include <functional>
+#include <queue>
+#include <unordered_set>
+
+#include "mazed_game_distance_fields.hh"
+
+
+/* ****************************************************************************************************************** *
+ ~ ~~~[ MEMBER FUNCTIONS IMPLEMENTATIONS ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ ~
+ * ****************************************************************************************************************** */
+
+namespace game {
+  const unsigned short distance_fields::UNREACHABLE;
+
+  distance_fields::distance_fields(schar_t rows_num, schar_t cols_num) : rows_num_{rows_num}, cols_num_{cols_num}
+  {{{
+    return;
+  }}}
+
+
+  distance_fields::~distance_fields()
+  {{{
+    return;
+  }}}
+
+  // // // // // // // // // // //
+
+  /**
+   * Returns the distance field of the target cell. The field is computed only if it isn't cached yet.
+   *
+   * @param[in]   blocked   Layer of the maze's blocks which can't be entered.
+   * @param[in]   target    Coordinates of the target cell.
+   * @return      Distance field of the target cell. It's kept repaired by the repair() while it stays in the cache.
+   */
+  std::shared_ptr<const distance_fields::field> distance_fields::get(const game::bitboard &blocked,
+                                                                     std::pair<schar_t, schar_t> target)
+  {{{
+    unsigned short target_cell = target.first * cols_num_ + target.second;
+
+    if (fields_.size() >= GAME_FIELDS_CACHE && fields_.count(target_cell) == 0) {
+      fields_.clear();
+    }
+
+    std::shared_ptr<field> &ps_field = fields_[target_cell];
+
+    if (!ps_field) {
+      ps_field = std::make_shared<field>(rows_num_ * cols_num_, UNREACHABLE);
+      compute(blocked, target_cell, *ps_field);
+    }
+
+    return ps_field;
+  }}}
+
+
+  /**
+   * Repairs all the cached fields after the block has become passable or blocked. Has to be called after every such
+   * change of the blocked layer.
+   *
+   * @param[in]   blocked   Layer of the maze's blocks which can't be entered, already changed.
+   * @param[in]   coords    Coordinates of the changed block.
+   */
+  void distance_fields::repair(const game::bitboard &blocked, std::pair<schar_t, schar_t> coords)
+  {{{
+    unsigned short cell = coords.first * cols_num_ + coords.second;
+    bool is_blocked = blocked.test(coords.first, coords.second);
+
+    std::unordered_map<unsigned short, std::shared_ptr<field>>::iterator it_fields;
+
+    for (it_fields = fields_.begin(); it_fields != fields_.end(); it_fields++) {
+      if (it_fields->first == cell) {
+        continue;                       // Target cell is always the source of its field.
+      }
+
+      if (is_blocked == true) {
+        repair_blocked(blocked, it_fields->first, cell, *it_fields->second);
+      }
+      else {
+        repair_opened(blocked, it_fields->first, cell, *it_fields->second);
+      }
+    }
+
+    return;
+  }}}
+
+  // // // // // // // // // // //
+
+  /**
+   * Stores the neighbouring cells which can be entered. The target cell can always be entered.
+   *
+   * @return  Number of the neighbouring cells stored.
+   */
+  inline unsigned char distance_fields::neighbours(const game::bitboard &blocked, unsigned short target,
+                                                   unsigned short cell, unsigned short (&cells)[4])
+  {{{
+    static const schar_t ROW_OFFSETS[] = {0, 0, -1, 1};
+    static const schar_t COL_OFFSETS[] = {-1, 1, 0, 0};
+
+    schar_t row = cell / cols_num_;
+    schar_t col = cell % cols_num_;
+    unsigned char count {0};
+
+    for (unsigned i = 0; i < 4; i++) {
+      schar_t next_row = row + ROW_OFFSETS[i];
+      schar_t next_col = col + COL_OFFSETS[i];
+
+      if (next_row < 0 || next_row >= rows_num_ || next_col < 0 || next_col >= cols_num_) {
+        continue;
+      }
+
+      unsigned short next_cell = next_row * cols_num_ + next_col;
+
+      if (next_cell == target || blocked.test(next_row, next_col) == false) {
+        cells[count++] = next_cell;
+      }
+    }
+
+    return count;
+  }}}
+
+
+  /**
+   * Breadth-first search from the target cell over the cells which aren't blocked.
+   */
+  void distance_fields::compute(const game::bitboard &blocked, unsigned short target, field &distances)
+  {{{
+    // Every cell is queued at most once, so the field's size is enough for the queue:
+    std::vector<unsigned short> queue(distances.size());
+    std::size_t head {0};
+    std::size_t tail {0};
+
+    unsigned short next_cells[4];
+
+    distances[target] = 0;
+    queue[tail++] = target;
+
+    while (head < tail) {
+      unsigned short cell = queue[head++];
+      unsigned char count = neighbours(blocked, target, cell, next_cells);
+
+      for (unsigned char i = 0; i < count; i++) {
+        if (distances[next_cells[i]] == UNREACHABLE) {
+          distances[next_cells[i]] = distances[cell] + 1;
+          queue[tail++] = next_cells[i];
+        }
+      }
+    }
+
+    return;
+  }}}
+
+
+  /**
+   * Repair of the field after the cell has become passable. The distances can only decrease, the decrease is propagated
+   * from the opened cell only to the cells which get closer to the target.
+   */
+  void distance_fields::repair_opened(const game::bitboard &blocked, unsigned short target, unsigned short cell,
+                                      field &distances)
+  {{{
+    unsigned short next_cells[4];
+    unsigned char count = neighbours(blocked, target, cell, next_cells);
+
+    for (unsigned char i = 0; i < count; i++) {
+      if (distances[next_cells[i]] != UNREACHABLE && distances[next_cells[i]] + 1 < distances[cell]) {
+        distances[cell] = distances[next_cells[i]] + 1;
+      }
+    }
+
+    if (distances[cell] == UNREACHABLE) {
+      return;                           // Opened in the part of the maze, which isn't reachable.
+    }
+
+    // The distances decrease in BFS order from the single cell, so the FIFO is sufficient:
+    std::deque<unsigned short> queue {cell};
+
+    while (queue.empty() == false) {
+      cell = queue.front();
+      queue.pop_front();
+      count = neighbours(blocked, target, cell, next_cells);
+
+      for (unsigned char i = 0; i < count; i++) {
+        if (distances[cell] + 1 < distances[next_cells[i]]) {
+          distances[next_cells[i]] = distances[cell] + 1;
+          queue.push_back(next_cells[i]);
+        }
+      }
+    }
+
+    return;
+  }}}
+
+
+  /**
+   * Repair of the field after the cell has become blocked. The distances can only increase and only for the cells,
+   * whose all shortest paths went through the blocked cell. These affected cells are found first, then their distances
+   * are computed again from the unaffected cells around them.
+   */
+  void distance_fields::repair_blocked(const game::bitboard &blocked, unsigned short target, unsigned short cell,
+                                       field &distances)
+  {{{
+    if (distances[cell] == UNREACHABLE) {
+      return;
+    }
+
+    unsigned short next_cells[4];
+    unsigned short support_cells[4];
+    unsigned char count;
+
+    std::vector<unsigned short> affected {cell};
+    std::unordered_set<unsigned short> affected_set {cell};
+
+    // The affected cells are found layer by layer, so the affected cells closer to the target are already known:
+    for (std::size_t i = 0; i < affected.size(); i++) {
+      count = neighbours(blocked, target, affected[i], next_cells);
+
+      for (unsigned char j = 0; j < count; j++) {
+        unsigned short next_cell = next_cells[j];
+
+        if (distances[next_cell] != distances[affected[i]] + 1 || affected_set.count(next_cell) != 0) {
+          continue;
+        }
+
+        bool supported {false};
+        unsigned char support_count = neighbours(blocked, target, next_cell, support_cells);
+
+        for (unsigned char k = 0; k < support_count && supported == false; k++) {
+          supported = (distances[support_cells[k]] + 1 == distances[next_cell] &&
+                       affected_set.count(support_cells[k]) == 0);
+        }
+
+        if (supported == false) {
+          affected.push_back(next_cell);
+          affected_set.insert(next_cell);
+        }
+      }
+    }
+
+    for (std::size_t i = 0; i < affected.size(); i++) {
+      distances[affected[i]] = UNREACHABLE;
+    }
+
+    // Dijkstra over the affected cells, seeded from their unaffected neighbours:
+    using item = std::pair<unsigned short, unsigned short>;       // Distance & cell.
+    std::priority_queue<item, std::vector<item>, std::greater<item>> queue;
+
+    for (std::size_t i = 1; i < affected.size(); i++) {
+      count = neighbours(blocked, target, affected[i], next_cells);
+
+      for (unsigned char j = 0; j < count; j++) {
+        if (distances[next_cells[j]] != UNREACHABLE && distances[next_cells[j]] + 1 < distances[affected[i]]) {
+          distances[affected[i]] = distances[next_cells[j]] + 1;
+        }
+      }
+
+      if (distances[affected[i]] != UNREACHABLE) {
+        queue.push(item(distances[affected[i]], affected[i]));
+      }
+    }
+
+    while (queue.empty() == false) {
+      item top = queue.top();
+      queue.pop();
+
+      if (top.first != distances[top.second]) {
+        continue;                       // Outdated item.
+      }
+
+      count = neighbours(blocked, target, top.second, next_cells);
+
+      for (unsigned char j = 0; j < count; j++) {
+        if (top.first + 1 < distances[next_cells[j]]) {
+          distances[next_cells[j]] = top.first + 1;
+          queue.push(item(top.first + 1, next_cells[j]));
+        }
+      }
+    }
+
+    return;
+  }}}
+}
+
+/* ****************************************************************************************************************** *
+ * ***[ END OF MAZED_GAME_DISTANCE_FIELDS.CC ]*********************************************************************** *
+ * ****************************************************************************************************************** */
@@ -0,0 +1,80 @@
+/**
+ * @file      mazed_game_distance_fields.hh
+ * @author    Dee'Kej (David Kaspar - xkaspa34)
+ * @version   0.1
+ * @brief     Contains declaration of the cache of BFS distance fields used by the guardians.
+ */
+
+
+/* ****************************************************************************************************************** *
+ * ***[ START OF MAZED_GAME_DISTANCE_FIELDS.HH ]********************************************************************* *
+ * ****************************************************************************************************************** */
+
+#ifndef H_GUARD_MAZED_GAME_DISTANCE_FIELDS_HH
+#define H_GUARD_MAZED_GAME_DISTANCE_FIELDS_HH
+
+
+/* ****************************************************************************************************************** *
+ ~ ~~~[ HEADER FILES ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ ~
+ * ****************************************************************************************************************** */
+
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "mazed_game_bitboard.hh"
+
+
+/* ****************************************************************************************************************** *
+ ~ ~~~[ DISTANCE_FIELDS CLASS ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ ~
+ * ****************************************************************************************************************** */
+
+namespace game {
+
+  #define GAME_FIELDS_CACHE   16U       // Maximum number of distance fields cached by one maze.
+
+  /**
+   * Cache of BFS distance fields of one maze. The field holds the distance of every cell of the maze to the target cell
+   * (row-major, as the maze's matrix), so the guardian finds its next step towards the target just by looking at its
+   * neighbouring cells. The fields are shared by all the guardians of the maze. When a block of the maze becomes
+   * passable or blocked (gate opened, key taken or dropped), the cached fields are repaired only around the changed
+   * block instead of being computed again.
+   */
+  class distance_fields {
+    public:
+      using field = std::vector<unsigned short>;
+
+      static const unsigned short UNREACHABLE = 0xFFFF;
+
+    private:
+      using schar_t = signed char;
+
+      schar_t                                                   rows_num_;
+      schar_t                                                   cols_num_;
+      std::unordered_map<unsigned short, std::shared_ptr<field>> fields_;         // Target cell -> field.
+
+      // // // // // // // // // // //
+
+      void compute(const game::bitboard &blocked, unsigned short target, field &distances);
+      void repair_opened(const game::bitboard &blocked, unsigned short target, unsigned short cell, field &distances);
+      void repair_blocked(const game::bitboard &blocked, unsigned short target, unsigned short cell,
+                          field &distances);
+
+      inline unsigned char neighbours(const game::bitboard &blocked, unsigned short target, unsigned short cell,
+                                      unsigned short (&cells)[4]);
+
+    public:
+      distance_fields(schar_t rows_num, schar_t cols_num);
+     ~distance_fields();
+
+      std::shared_ptr<const field> get(const game::bitboard &blocked, std::pair<schar_t, schar_t> target);
+      void repair(const game::bitboard &blocked, std::pair<schar_t, schar_t> coords);
+  };
+}
+
+/* ****************************************************************************************************************** *
+ * ***[ END OF MAZED_GAME_DISTANCE_FIELDS.HH ]*********************************************************************** *
+ * ****************************************************************************************************************** */
+
+#endif
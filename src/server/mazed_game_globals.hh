@@ -29,6 +29,9 @@ namespace game {
   #define MAZE_MIN_SIZE       15U
   #define MAZE_MAX_SIZE       50U
 
+  #define GAME_KEYFRAME_INTERVAL  50U   // Every Nth game update is KEYFRAME even for clients using DELTA updates.
+  #define GAME_GUARDIANS_INTERVAL 2U    // Guardians move every Nth tick of the game.
+
   enum E_move {
     NONE = 0,
     LEFT,
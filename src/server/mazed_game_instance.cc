@@ -15,6 +15,10 @@
  ~ ~~~[ HEADER FILES ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ ~
  * ****************************************************************************************************************** */
 
+#include <algorithm>
+#include <chrono>
+#include <utility>
+
 #include "mazed_cl_handler.hh"
 #include "mazed_shared_resources.hh"
 
@@ -22,6 +26,7 @@
 #include "mazed_game_maze.hh"
 #include "mazed_game_guardian.hh"
 #include "mazed_game_player.hh"
+#include "mazed_game_snapshot.hh"
 #include "../protocol.hh"
 
 #include "mazed_game_instance.hh"
@@ -34,25 +39,18 @@
 namespace game {
   instance::instance(game::maze *maze_ptr, std::string game_owner,
                      std::shared_ptr<mazed::shared_resources> ps_shared_res, mazed::client_handler *cl_handler_ptr) : 
-    timer_(io_service_), p_maze_{maze_ptr}, p_cl_handler_{cl_handler_ptr}, ps_shared_res_{ps_shared_res}
+    p_maze_{maze_ptr}, p_cl_handler_{cl_handler_ptr}, ps_shared_res_{ps_shared_res}
   {{{
     p_maze_->game_owner_ = game_owner;
+    pacing_ = std::get<mazed::UPDATES_PACING>(p_cl_handler_->settings_);
     return;
   }}}
 
 
   instance::~instance()
   {{{
-    if (shared_ == true) {
-      shared_ = false;
-
-      ps_shared_res_->access_mutex.lock();
-      {
-        ps_shared_res_->game_instances.erase(it_self_);
-      }
-      ps_shared_res_->access_mutex.unlock();
-    }
-
+    // NOTE: The games_registry owns the instance until it's stopped, so it's never listed anymore here.
+    ps_shared_res_->p_scheduler->remove(tick_ID_);    // Waits for the tick in progress.
 
     std::array<player *, GAME_MAX_PLAYERS>::iterator it_players;
     game::player *p_player;
@@ -60,7 +58,7 @@ namespace game {
     for (it_players = p_maze_->players_.begin(); it_players != p_maze_->players_.end(); it_players++) {
       if (*it_players != NULL) {
         p_player = *it_players;
-        remove_player(*it_players);
+        player_drop(*it_players);
         p_player->game_finished();
       }
       else {
@@ -69,13 +67,6 @@ namespace game {
     }
 
 
-    timer_.cancel();
-    io_service_.stop();
-
-    if (pu_thread_ && (*pu_thread_).joinable() == true) {
-      (*pu_thread_).join();
-    }
-
     delete p_maze_;
     p_maze_ = NULL;
     
@@ -86,7 +77,7 @@ namespace game {
 
   std::string instance::get_scheme()
   {{{
-    return p_maze_->maze_scheme_;
+    return p_maze_->get_scheme();
   }}}
 
   std::string instance::get_rows()
@@ -99,78 +90,154 @@ namespace game {
     return std::to_string(p_maze_->get_cols());
   }}}
 
+  std::string instance::get_UID()
+  {{{
+    return UID_;
+  }}}
+
+  // // // // // // // // // // //
+
+  /**
+   * Shares the instance and starts its ticking. The instance is owned by the games_registry, where it's listed before
+   * the first tick, until it's stopped.
+   */
   std::shared_ptr<game::instance> instance::run()
   {{{
-    assert(pu_thread_.get() == nullptr);
-    
-    pu_thread_ = std::unique_ptr<boost::thread>(new boost::thread(&instance::start_game, this));
+    assert(tick_ID_ == 0);
+
+    std::shared_ptr<game::instance> ps_this(this);
 
-    ps_shared_res_->access_mutex.lock();
+    p_maze_->players_.lock_upgrade();
     {
-      ps_shared_res_->game_instances.emplace_back(this);
-      it_self_ = ps_shared_res_->game_instances.end();
-      it_self_--;
-      shared_ = true;
+      UID_ = ps_shared_res_->p_games_registry->add(ps_this, p_maze_->maze_name_, players_nicks());
     }
-    ps_shared_res_->access_mutex.unlock();
+    p_maze_->players_.unlock_upgrade();
 
+    tick_ID_ = ps_shared_res_->p_scheduler->add(boost::bind(&instance::game_loop, this), p_maze_->game_speed_);
     
-    return *it_self_;
+    return ps_this;
   }}}
 
 
+  /**
+   * Stops the game, it's removed from the games_registry & game::scheduler and all its players are released. Called
+   * upon the owner's TERMINATE_GAME, or when the owner has left the game.
+   *
+   * @param[in]   user      UID of the user stopping the game, only the game owner can stop the game.
+   * @return      true if the game has been stopped (or it was stopped already), false if the user is not the owner.
+   */
   bool instance::stop(const std::string user)
   {{{
-    bool retval {false};
     std::shared_ptr<game::instance> ps_tmp_this;
 
     p_maze_->access_mutex_.lock();
     {
-      if (p_maze_->game_owner_ == user) {
-                
-        if (shared_ == true) {
-          shared_ = false;
-
-          ps_shared_res_->access_mutex.lock();
-          {
-            ps_tmp_this = *it_self_;
-            ps_shared_res_->game_instances.erase(it_self_);
-          }
-          ps_shared_res_->access_mutex.unlock();
-        }
+      if (p_maze_->game_owner_ != user) {
+        p_maze_->access_mutex_.unlock();
+        return false;
+      }
+    }
+    p_maze_->access_mutex_.unlock();
 
+    // NOTE: Waits for the tick in progress, which is using the maze lock.
+    ps_shared_res_->p_scheduler->remove(tick_ID_);
 
-        std::array<player *, GAME_MAX_PLAYERS>::iterator it_players;
-        game::player *p_player;
+    p_maze_->access_mutex_.lock();
+    {
+      // NOTE: The instance isn't destroyed before the unlocking, even if the registry has owned the last reference.
+      ps_tmp_this = ps_shared_res_->p_games_registry->remove(UID_);
+      stopped_ = true;
 
-        for (it_players = p_maze_->players_.begin(); it_players != p_maze_->players_.end(); it_players++) {
-          if (*it_players != NULL) {
-            // TODO: GAME TERMINATING INFORM
 
-            p_player = *it_players;
-            remove_player(*it_players);
-            p_player->game_finished();
-          }
-          else {
-            continue;
-          }
+      std::array<player *, GAME_MAX_PLAYERS>::iterator it_players;
+      game::player *p_player;
+
+      for (it_players = p_maze_->players_.begin(); it_players != p_maze_->players_.end(); it_players++) {
+        if (*it_players != NULL) {
+          // TODO: GAME TERMINATING INFORM
+
+          p_player = *it_players;
+          player_drop(*it_players);
+          p_player->game_finished();
+        }
+        else {
+          continue;
         }
+      }
+    }
+    p_maze_->access_mutex_.unlock();
 
+    return true;
+  }}}
+
+
+  /**
+   * Takes the snapshot of the game's mutable state for the saving. Only the copying is done under the maze lock, which
+   * is O(state), the snapshot is encoded & written by the mazed::save_engine afterwards.
+   *
+   * @param[in]   user      UID of the user requesting the save, only the game owner can save the game.
+   * @param[out]  state     Snapshot of the game.
+   * @param[out]  stall_us  Time in us the maze lock has been held, which is the longest stall of the game loop caused.
+   * @return      true if the snapshot has been taken, false if the user is not the game owner.
+   */
+  bool instance::snapshot(const std::string user, game::snapshot &state, long &stall_us)
+  {{{
+    std::chrono::steady_clock::time_point locked;
+
+    p_maze_->access_mutex_.lock();
+    {
+      locked = std::chrono::steady_clock::now();
+
+      if (p_maze_->game_owner_ != user) {
+        p_maze_->access_mutex_.unlock();
+        return false;
+      }
 
-        timer_.cancel();
-        io_service_.stop();
+      state.maze_name = p_maze_->maze_name_;
+      state.maze_fingerprint = p_maze_->ps_layout_->get_fingerprint();
+      state.game_owner = p_maze_->game_owner_;
+      state.game_speed = p_maze_->game_speed_;
+      state.ticks = p_maze_->ticks_;
+      state.keys = p_maze_->keys_;
 
-        if (pu_thread_ && (*pu_thread_).joinable() == true) {
-          (*pu_thread_).join();
-          pu_thread_.reset();
+      std::vector<std::pair<signed char, signed char>>::const_iterator it_gates;
+
+      for (it_gates = p_maze_->ps_layout_->gates_.begin(); it_gates != p_maze_->ps_layout_->gates_.end(); it_gates++) {
+        if (p_maze_->block_get((*it_gates).first, (*it_gates).second) != game::block::GATE_CLOSED) {
+          state.gates_open.push_back(*it_gates);
         }
+      }
 
-        retval = true;
+      std::vector<game::guardian>::iterator it_guardians;
+
+      for (it_guardians = p_maze_->guardians_.begin(); it_guardians != p_maze_->guardians_.end(); it_guardians++) {
+        state.guardians.push_back((*it_guardians).get_coords());
+      }
+
+      std::array<player *, GAME_MAX_PLAYERS>::iterator it_players;
+
+      p_maze_->players_.lock_upgrade();
+      {
+        for (it_players = p_maze_->players_.begin(); it_players != p_maze_->players_.end(); it_players++) {
+          if (*it_players != NULL) {
+            game::snapshot::player_state &player = state.players[it_players - p_maze_->players_.begin()];
+
+            player.present = true;
+            player.nick = (*it_players)->get_nick();
+            player.coords = (*it_players)->get_coords();
+            player.lifes = (*it_players)->get_lifes();
+            player.has_key = (*it_players)->has_key();
+          }
+        }
       }
+      p_maze_->players_.unlock_upgrade();
+
+      stall_us = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() -
+                                                                       locked).count();
     }
     p_maze_->access_mutex_.unlock();
 
-    return retval;
+    return true;
   }}}
 
 
@@ -196,39 +263,14 @@ namespace game {
 
   // // // // // // // // // // //
 
-  void instance::start_game()
+  /**
+   * Single tick of the game, called periodically by the game::scheduler.
+   */
+  void instance::game_loop()
   {{{
-    timer_.expires_from_now(boost::posix_time::milliseconds(p_maze_->game_speed_));
-    timer_.async_wait(boost::bind(&instance::timeout_loop_handler, this, boost::asio::placeholders::error));
-    io_service_.run();
-    return;
-  }}}
-
-
-  void instance::timeout_loop_handler(const boost::system::error_code& error)
-  {{{
-    switch (error.value()) {
-      case boost::system::errc::operation_canceled :
-        // This error occurs every time we asynchronously cancel the events of the timer.
-        break;
-
-      case boost::system::errc::success :
-        game_loop();
-        timer_.expires_at(timer_.expires_at() + boost::posix_time::milliseconds(p_maze_->game_speed_));
-        timer_.async_wait(boost::bind(&instance::timeout_loop_handler, this, boost::asio::placeholders::error));
-        break;
-
-      default :
-        p_cl_handler_->log(mazed::log_level::ERROR, error.message().c_str());
-        break;
-    }
-
-    return;
-  }}}
-
+    std::shared_ptr<game::instance> ps_tmp_this;      // Released after the unlocking, see the end of the tick.
+    bool finished {false};
 
-  inline void instance::game_loop()
-  {{{
     p_maze_->access_mutex_.lock();
     {
 
@@ -238,6 +280,7 @@ namespace game {
       }
 
       std::array<player *, GAME_MAX_PLAYERS>::iterator it_players;
+      game::player *p_player;
       
       p_maze_->players_.lock_upgrade();
       {
@@ -253,27 +296,18 @@ namespace game {
           }
         }
 
-        if (p_maze_->game_winners_.empty() == true) {
-          // TODO: guardians updating
-          // In case of death of a player -> check if he's dead.
-          // In case of all player's death -> Game Over.
-        }
-        else {
+        // The game is over when somebody has won, or all the players have been killed:
+        if (p_maze_->game_winners_.empty() == false || guardians_update() == true) {
           p_maze_->game_run_ = false;
           p_maze_->game_finished_ = true;
-
-          for (it_players = p_maze_->players_.begin(); it_players != p_maze_->players_.end(); it_players++) {
-            if (*it_players != NULL) {
-              // TODO: INFORM players with INFO message.
-              (*it_players)->game_finished();
-            }
-            else {
-              continue;
-            }
-          }
+          finished = true;
+          status_changed(protocol::E_game_status::FINISHED);
         }
 
-        
+
+        // Keep the state of the previous tick for the DELTA update:
+        std::swap(p_maze_->last_update_, p_maze_->next_updates_[0]);
+
         p_maze_->next_updates_[0].keys_coords.clear();
         p_maze_->next_updates_[0].opened_gates_coords.clear();
         p_maze_->next_updates_[0].players_coords.clear();
@@ -281,17 +315,19 @@ namespace game {
 
 
         std::vector<std::pair<signed char, signed char>>::iterator iter;
+        std::vector<std::pair<signed char, signed char>>::const_iterator it_gates;
+        const std::vector<std::pair<signed char, signed char>> &gates = p_maze_->ps_layout_->gates_;
 
         for (iter = p_maze_->keys_.begin(); iter != p_maze_->keys_.end(); iter++) {
           p_maze_->next_updates_[0].keys_coords.push_back(*iter);
         }
 
-        for (iter = p_maze_->gates_.begin(); iter != p_maze_->gates_.end(); iter++) {
-          if (p_maze_->matrix_[(*iter).first][(*iter).second].get() == game::block::GATE_CLOSED) {
+        for (it_gates = gates.begin(); it_gates != gates.end(); it_gates++) {
+          if (p_maze_->block_get((*it_gates).first, (*it_gates).second) == game::block::GATE_CLOSED) {
             continue;
           }
           else {
-            p_maze_->next_updates_[0].opened_gates_coords.push_back(*iter);
+            p_maze_->next_updates_[0].opened_gates_coords.push_back(*it_gates);
           }
         }
 
@@ -312,11 +348,20 @@ namespace game {
           }
         }
 
-        std::vector<protocol::update> updates;
+        bool keyframe_tick = (p_maze_->ticks_++ % GAME_KEYFRAME_INTERVAL == 0) || delta_update() == false;
+
+        // Updates of this tick will be encoded again upon first use:
+        p_maze_->ps_next_update_encoded_.reset();
+        p_maze_->ps_next_delta_encoded_.reset();
+
+        // The updates are spread evenly over the pacing slice of the tick, instead of being sent in a burst:
+        long pacing_slice = p_maze_->game_speed_ * pacing_ / 100;
+        long players_num = GAME_MAX_PLAYERS - std::count(p_maze_->players_.begin(), p_maze_->players_.end(), nullptr);
+        long player_idx = 0;
+
         for (it_players = p_maze_->players_.begin(); it_players != p_maze_->players_.end(); it_players++) {
           if (*it_players != NULL) {
-            updates = p_maze_->next_updates_;
-            (*it_players)->update_client(updates);
+            (*it_players)->update_client(keyframe_tick, pacing_slice * player_idx++ / players_num);
           }
           else {
             continue;
@@ -326,10 +371,29 @@ namespace game {
       }
       p_maze_->players_.unlock_upgrade();
 
+      // The finished game is removed after its last update has been sent, so it's never listed nor joined anymore:
+      if (finished == true) {
+        ps_shared_res_->p_scheduler->remove(tick_ID_);  // Called from the tick itself, so it doesn't wait.
+        ps_tmp_this = ps_shared_res_->p_games_registry->remove(UID_);
+        stopped_ = true;
+
+        for (it_players = p_maze_->players_.begin(); it_players != p_maze_->players_.end(); it_players++) {
+          if (*it_players != NULL) {
+            // TODO: INFORM players with INFO message.
+            p_player = *it_players;
+            player_drop(*it_players);
+            p_player->game_finished();
+          }
+          else {
+            continue;
+          }
+        }
+      }
+
     }
     p_maze_->access_mutex_.unlock();
 
-    return;
+    return;                                           // NOTE: The instance might be destroyed by the ps_tmp_this.
   }}}
 
   // // // // // // // // // // //
@@ -341,48 +405,263 @@ namespace game {
   }}}
 #endif
   
+  /**
+   * Adds the player into the first free slot of the game.
+   *
+   * @return  'true' upon success | 'false' if the game is full, or it has been stopped already. The stopped game could
+   *          have been still found in the games_registry by the reader, which has loaded it just before.
+   */
   bool instance::add_player(game::player *player_ptr)
   {{{
     bool retval {true};
     unsigned char player_num;
-    
-    p_maze_->players_.lock_upgrade();
+
+    p_maze_->access_mutex_.lock();
     {
-      player_num = p_maze_->players_.add(player_ptr);
+      if (stopped_ == true) {
+        p_maze_->access_mutex_.unlock();
+        return false;
+      }
+
+      p_maze_->players_.lock_upgrade();
+      {
+        player_num = p_maze_->players_.add(player_ptr);
+
+        if (player_num < GAME_MAX_PLAYERS) {
+          p_maze_->players_alive_++;
+          player_ptr->set_maze(p_maze_);
+          player_ptr->set_number(player_num);
+          player_ptr->set_start_coords(p_maze_->ps_layout_->players_start_coords_[player_num]);
+
+          game::snapshot::player_state &restored = p_maze_->players_restored_[player_num];
+
+          // Player joining the loaded game continues from the saved position:
+          if (restored.present == true) {
+            player_ptr->restore(restored.coords, restored.lifes, restored.has_key);
+            restored.present = false;
+          }
+
+          players_changed();
+        }
+        else {
+          retval = false;
+        }
 
-      if (player_num < GAME_MAX_PLAYERS) {
-        p_maze_->players_alive_++;
-        player_ptr->set_maze(p_maze_);
-        player_ptr->set_number(player_num);
-        player_ptr->set_start_coords(p_maze_->players_start_coords_[player_num]);
       }
-      else {
-        retval = false;
+      p_maze_->players_.unlock_upgrade();
+    }
+    p_maze_->access_mutex_.unlock();
+
+    return retval;
+  }}}
+
+
+  /**
+   * Moves the guardians one block towards the nearest player and kills the players caught. Guardians are slower than
+   * the players, so they move only every GAME_GUARDIANS_INTERVAL tick. Expects the maze and the players list to be
+   * locked.
+   *
+   * @return  'true' if the last alive player has been killed | 'false' otherwise.
+   */
+  inline bool instance::guardians_update()
+  {{{
+    std::array<player *, GAME_MAX_PLAYERS>::iterator it_players;
+    std::vector<game::guardian>::iterator it_guardians;
+    std::vector<std::pair<signed char, signed char>> targets;
+
+    for (it_players = p_maze_->players_.begin(); it_players != p_maze_->players_.end(); it_players++) {
+      if (*it_players != NULL && (*it_players)->get_lifes() > 0) {
+        targets.push_back((*it_players)->get_coords());
       }
+    }
 
+    if (targets.empty() == true) {
+      return false;
     }
-    p_maze_->players_.unlock_upgrade();
 
-    return retval;
+    if (p_maze_->ticks_ % GAME_GUARDIANS_INTERVAL == 0) {
+      p_maze_->guardians_move(targets);
+    }
+
+    bool killed {false};
+
+    for (it_guardians = p_maze_->guardians_.begin(); it_guardians != p_maze_->guardians_.end(); it_guardians++) {
+      std::pair<signed char, signed char> coords = (*it_guardians).get_coords();
+
+      for (it_players = p_maze_->players_.begin(); it_players != p_maze_->players_.end(); it_players++) {
+        if (*it_players != NULL && (*it_players)->get_lifes() > 0 && (*it_players)->get_coords() == coords) {
+          killed = ((*it_players)->kill() == true) || killed;
+        }
+      }
+    }
+
+    return killed == true && p_maze_->players_alive_ == 0;
   }}}
 
 
+  /**
+   * Computes the DELTA update from the KEYFRAME of the previous tick and the actual KEYFRAME.
+   *
+   * @return  'true' upon success | 'false' if the changes can't be expressed by the DELTA update.
+   */
+  inline bool instance::delta_update()
+  {{{
+    protocol::update &last = p_maze_->last_update_;
+    protocol::update &next = p_maze_->next_updates_[0];
+    protocol::update &delta = p_maze_->next_deltas_[0];
+
+    delta.type = protocol::E_update_type::DELTA;
+    delta.opened_gates_coords.clear();
+    delta.keys_coords.clear();
+    delta.taken_keys_coords.clear();
+    delta.players_coords.clear();
+    delta.players_moved.clear();
+    delta.guardians_coords.clear();
+    delta.guardians_moved.clear();
+
+    // Players & guardians are listed always in the same order:
+    if (last.players_coords.size() != next.players_coords.size() ||
+        last.guardians_coords.size() != next.guardians_coords.size()) {
+      return false;
+    }
+
+    std::vector<std::pair<signed char, signed char>>::iterator iter;
+
+    // Gates can be only opened:
+    for (iter = next.opened_gates_coords.begin(); iter != next.opened_gates_coords.end(); iter++) {
+      if (std::find(last.opened_gates_coords.begin(), last.opened_gates_coords.end(), *iter) ==
+          last.opened_gates_coords.end()) {
+        delta.opened_gates_coords.push_back(*iter);
+      }
+    }
+
+    if (last.opened_gates_coords.size() + delta.opened_gates_coords.size() != next.opened_gates_coords.size()) {
+      return false;
+    }
+
+    // Keys can be taken and placed again:
+    for (iter = last.keys_coords.begin(); iter != last.keys_coords.end(); iter++) {
+      if (std::find(next.keys_coords.begin(), next.keys_coords.end(), *iter) == next.keys_coords.end()) {
+        delta.taken_keys_coords.push_back(*iter);
+      }
+    }
+
+    for (iter = next.keys_coords.begin(); iter != next.keys_coords.end(); iter++) {
+      if (std::find(last.keys_coords.begin(), last.keys_coords.end(), *iter) == last.keys_coords.end()) {
+        delta.keys_coords.push_back(*iter);
+      }
+    }
+
+    if (last.keys_coords.size() - delta.taken_keys_coords.size() + delta.keys_coords.size() !=
+        next.keys_coords.size()) {
+      return false;                     // Multiple keys at the same coordinates.
+    }
+
+    for (unsigned short i = 0; i < next.players_coords.size(); i++) {
+      if (next.players_coords[i] != last.players_coords[i]) {
+        delta.players_coords.push_back(next.players_coords[i]);
+        delta.players_moved.push_back(i);
+      }
+    }
+
+    for (std::size_t i = 0; i < next.guardians_coords.size(); i++) {
+      if (next.guardians_coords[i] != last.guardians_coords[i]) {
+        delta.guardians_coords.push_back(next.guardians_coords[i]);
+        delta.guardians_moved.push_back(static_cast<unsigned short>(i));
+      }
+    }
+
+    return true;
+  }}}
+
+
+  /**
+   * Removes the player leaving the game. Nobody else can terminate the game, so it's stopped when its owner leaves.
+   */
   void instance::remove_player(game::player *player_ptr)
   {{{
     // TODO: Add player to already played list.
 
+    if (player_drop(player_ptr) == true && player_ptr->get_UID() == p_maze_->game_owner_) {
+      stop(player_ptr->get_UID());                  // NOTE: The instance might be destroyed upon the return.
+    }
+
+    return;
+  }}}
+
+
+  /**
+   * Removes the player from the players list of the game.
+   *
+   * @return  'true' if the player has been removed | 'false' if it has been already removed by the game itself, while
+   *          its client was leaving.
+   */
+  bool instance::player_drop(game::player *player_ptr)
+  {{{
+    bool retval {false};
+
     p_maze_->players_.lock_upgrade();
     {
+      if (p_maze_->players_.contains(player_ptr->get_number(), player_ptr) == true) {
 #ifndef NDEBUG
-      p_maze_->players_.remove(player_ptr->get_number(), player_ptr);
+        p_maze_->players_.remove(player_ptr->get_number(), player_ptr);
 #else
-      p_maze_->players_.remove(player_ptr->get_number());
+        p_maze_->players_.remove(player_ptr->get_number());
 #endif
 
-      p_maze_->players_alive_--;
+        if (player_ptr->get_lifes() > 0) {
+          p_maze_->players_alive_--;    // Killed players aren't alive already.
+        }
+
+        players_changed();
+        retval = true;
+      }
     }
     p_maze_->players_.unlock_upgrade();
 
+    return retval;
+  }}}
+
+
+  /**
+   * Publishes the nicks of the actual players to the games_registry. Expects the players list to be locked.
+   */
+  void instance::players_changed()
+  {{{
+    if (UID_.empty() == true) {
+      return;                                       // Not listed yet, the run() publishes them.
+    }
+
+    ps_shared_res_->p_games_registry->set_players(UID_, players_nicks());
+
+    return;
+  }}}
+
+
+  /**
+   * @return  Nicks of the players in the game. Expects the players_ to be locked.
+   */
+  std::vector<std::string> instance::players_nicks()
+  {{{
+    std::vector<std::string> nicks;
+    std::array<player *, GAME_MAX_PLAYERS>::iterator it_players;
+
+    for (it_players = p_maze_->players_.begin(); it_players != p_maze_->players_.end(); it_players++) {
+      if (*it_players != NULL) {
+        nicks.push_back((*it_players)->get_nick());
+      }
+    }
+
+    return nicks;
+  }}}
+
+
+  /**
+   * Publishes the new status of the game to the games_registry.
+   */
+  void instance::status_changed(protocol::E_game_status status)
+  {{{
+    ps_shared_res_->p_games_registry->set_status(UID_, status);
     return;
   }}}
 }
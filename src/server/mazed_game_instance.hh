@@ -40,6 +40,7 @@ namespace game {
 
   class maze;
   class player;
+  struct snapshot;
   
   /**
    * Maze game instance.
@@ -48,23 +49,24 @@ namespace game {
 
       // // // // // // // // // // //
 
-      boost::asio::io_service                                   io_service_;
-      boost::asio::deadline_timer                               timer_;
-      
+      unsigned long                                             tick_ID_ {0};     // ID within the game::scheduler.
+      unsigned                                                  pacing_ {0};      // % of the tick for the updates.
+      bool                                                      stopped_ {false}; // Guarded by the maze's lock.
+
       game::maze                                                *p_maze_;
       mazed::client_handler                                     *p_cl_handler_;
       std::shared_ptr<mazed::shared_resources>                  ps_shared_res_;
-      std::list<std::shared_ptr<game::instance>>::iterator      it_self_;
-      bool                                                      shared_ {false};
-
-      std::unique_ptr<boost::thread>                            pu_thread_;
+      std::string                                               UID_;             // Handle in the games_registry.
 
       // // // // // // // // // // //
   
       void run_game();
-      void start_game();
-      void timeout_loop_handler(const boost::system::error_code& error);
-      inline void game_loop();
+      void game_loop();
+      inline bool guardians_update();
+      inline bool delta_update();
+      bool player_drop(game::player *player_ptr);
+      void players_changed();
+      std::vector<std::string> players_nicks();
       
       // // // // // // // // // // //
 
@@ -76,6 +78,7 @@ namespace game {
      std::string get_scheme();
      std::string get_rows();
      std::string get_cols();
+     std::string get_UID();
 
 #if 0
       protocol::E_game_status get_status();
@@ -87,6 +90,9 @@ namespace game {
 
       std::shared_ptr<game::instance> run();
       bool stop(const std::string user);
+
+      bool snapshot(const std::string user, game::snapshot &state, long &stall_us);
+      void status_changed(protocol::E_game_status status);
   };
 }
 
@@ -19,17 +19,25 @@
  * ****************************************************************************************************************** */
 
 #include <array>
+#include <cassert>
+#include <cstddef>
+#include <memory>
 #include <queue>
 #include <string>
 #include <unordered_map>
 #include <vector>
 
 #include "mazed_game_globals.hh"
+#include "mazed_game_bitboard.hh"
 #include "mazed_game_block.hh"
+#include "mazed_game_distance_fields.hh"
 #include "mazed_game_guardian.hh"
+#include "mazed_game_maze_layout.hh"
 #include "mazed_game_players_list.hh"
+#include "mazed_game_snapshot.hh"
 #include "../protocol.hh"
 #include "../basic_maze.hh"
+#include "../slide_table.hh"
 
 
 /* ****************************************************************************************************************** *
@@ -60,6 +68,8 @@ namespace game {
       using schar_t = signed char;
 
       boost::mutex                                              access_mutex_;
+      std::shared_ptr<const game::maze_layout>                  ps_layout_;
+      std::string                                               maze_name_;       // Set by the mazes_manager.
 
       std::string                                               game_owner_;
       long                                                      game_speed_ {1000};
@@ -67,32 +77,54 @@ namespace game {
       bool                                                      game_finished_ {false};
       std::vector<game::player *>                               game_winners_;
 
-      std::string                                               maze_scheme_;
-      std::string                                               maze_version_;
-
       game::players_list                                        players_;
       unsigned char                                             players_alive_ {0};
       std::unordered_map<std::string, schar_t>                  previous_players_;
 
-      std::array<std::pair<schar_t, schar_t>, GAME_MAX_PLAYERS> players_start_coords_;
       std::array<std::pair<schar_t, schar_t>, GAME_MAX_PLAYERS> players_saved_coords_;
+      std::array<game::snapshot::player_state, GAME_MAX_PLAYERS> players_restored_;     // Applied upon the joining.
       
       std::vector<game::guardian>                               guardians_;
-      std::vector<std::pair<schar_t, schar_t>>                  gates_;
       std::vector<std::pair<schar_t, schar_t>>                  keys_;
-      std::vector<std::vector<game::block>>                     matrix_;
+
+      // Mutable overlay of the shared layout, kept in sync by the block_set():
+      game::bitboard                                            bb_gates_open_;
+      game::bitboard                                            bb_keys_;
+      game::bitboard                                            bb_blocked_;      // Blocks the player can't enter.
+      std::array<game::bitboard, GAME_MAX_PLAYERS>              bb_players_;
+
+      game::distance_fields                                     distances_;       // Used by the guardians.
+      std::unique_ptr<game::slide_table>                        pu_slides_;       // Copied upon the first change.
 
       std::queue<std::pair<protocol::E_info_type, std::string>> events_queue_;
       std::vector<protocol::update>                             next_updates_;
+      std::vector<protocol::update>                             next_deltas_;
+      protocol::update                                          last_update_;     // KEYFRAME of previous tick.
+      unsigned long                                             ticks_ {0};
+
+      // Updates of actual tick encoded once for all the players, created upon first use:
+      std::shared_ptr<const std::vector<char>>                  ps_next_update_encoded_;
+      std::shared_ptr<const std::vector<char>>                  ps_next_delta_encoded_;
       std::vector<protocol::message>                            events_log_;
 
       // // // // // // // // // // //
       
     public:
-      maze(schar_t row_num, schar_t col_num) :
-        basic_maze(row_num, col_num),
-        gates_(), keys_(), matrix_(row_num, std::vector<game::block>(col_num)), next_updates_(1)
+      /**
+       * Creates new maze of the layout parsed by the mazes_manager. The layout is shared, only the state of the game is
+       * created for the maze, and it's initial.
+       */
+      explicit maze(const std::shared_ptr<const game::maze_layout> &ps_layout) :
+        basic_maze(ps_layout->dimensions_.first, ps_layout->dimensions_.second), ps_layout_{ps_layout},
+        keys_(ps_layout->keys_), bb_keys_(ps_layout->bb_keys_), bb_blocked_(ps_layout->bb_blocked_),
+        distances_(dimensions_.first, dimensions_.second), next_updates_(1), next_deltas_(1)
       {{{
+        std::vector<std::pair<schar_t, schar_t>>::const_iterator it_coords;
+
+        for (it_coords = ps_layout_->guardians_.begin(); it_coords != ps_layout_->guardians_.end(); it_coords++) {
+          guardians_.emplace_back((*it_coords).first, (*it_coords).second, this);
+        }
+
         return;
       }}}
 
@@ -103,51 +135,328 @@ namespace game {
       }}}
 
 
+      /**
+       * @return  Actual type of the block - the layout's block with the gates & keys of this maze applied.
+       */
+      game::block::E_block_type block_get(schar_t row, schar_t col) const
+      {{{
+        game::block::E_block_type type = ps_layout_->blocks_[row * dimensions_.second + col].get();
+
+        switch (type) {
+          case game::block::GATE_CLOSED :
+            if (bb_gates_open_.test(row, col) == false) {
+              return game::block::GATE_CLOSED;
+            }
+
+            return (bb_keys_.test(row, col) == true) ? game::block::GATE_DROPPED_KEY : game::block::GATE_OPEN;
+
+          case game::block::EMPTY :
+            return (bb_keys_.test(row, col) == true) ? game::block::KEY : game::block::EMPTY;
+
+          default :
+            return type;
+        }
+      }}}
+
+
+      /**
+       * Sets the type of the block in the overlay of this maze. Only the gates & keys can be changed during the game,
+       * walls and targets are given by the layout.
+       */
+      void block_set(schar_t row, schar_t col, game::block::E_block_type type)
+      {{{
+        assert(ps_layout_->bb_walls_.test(row, col) == false && ps_layout_->bb_targets_.test(row, col) == false);
+
+        if (type == game::block::KEY || type == game::block::GATE_DROPPED_KEY) {
+          bb_keys_.set(row, col);
+        }
+        else {
+          bb_keys_.reset(row, col);
+        }
+
+        if (type == game::block::GATE_OPEN || type == game::block::GATE_DROPPED_KEY) {
+          bb_gates_open_.set(row, col);
+        }
+        else {
+          bb_gates_open_.reset(row, col);
+        }
+
+        bool blocked = (type == game::block::GATE_CLOSED || type == game::block::KEY);
+
+        if (blocked != bb_blocked_.test(row, col)) {
+          if (blocked == true) {
+            bb_blocked_.set(row, col);
+          }
+          else {
+            bb_blocked_.reset(row, col);
+          }
+
+          if (!pu_slides_) {
+            pu_slides_ = std::unique_ptr<game::slide_table>(new game::slide_table(ps_layout_->slides_));
+          }
+
+          distances_.repair(bb_blocked_, std::pair<schar_t, schar_t>(row, col));
+          pu_slides_->set_blocked(row, col, blocked);
+        }
+
+        return;
+      }}}
+
+
+      void player_enter(schar_t row, schar_t col, unsigned char player_num)
+      {{{
+        bb_players_[player_num].set(row, col);
+        return;
+      }}}
+
+
+      void player_leave(schar_t row, schar_t col, unsigned char player_num)
+      {{{
+        assert(bb_players_[player_num].test(row, col) == true);
+
+        bb_players_[player_num].reset(row, col);
+        return;
+      }}}
+
+
+      /**
+       * Restores the mutable state of the game from the snapshot of the saved game. Expects a new maze, which isn't
+       * shared yet. The players are restored by their numbers once they join the game, the dead ones join as new.
+       * Every coordinates are checked against the layout first, so the corrupted save can't break the maze. On the
+       * failure the maze is left half-restored and it has to be deleted.
+       *
+       * @return  true if the state has been restored, false if the snapshot doesn't fit the layout.
+       */
+      bool restore(const game::snapshot &state)
+      {{{
+        std::vector<std::pair<schar_t, schar_t>>::const_iterator it_coords;
+
+        if (state.guardians.size() != guardians_.size() || state.game_speed <= 0) {
+          return false;
+        }
+
+        for (it_coords = state.gates_open.begin(); it_coords != state.gates_open.end(); it_coords++) {
+          if (is_restorable(*it_coords) == false ||
+              ps_layout_->blocks_[(*it_coords).first * dimensions_.second + (*it_coords).second].get() !=
+              game::block::GATE_CLOSED) {
+            return false;
+          }
+
+          block_set((*it_coords).first, (*it_coords).second, game::block::GATE_OPEN);
+        }
+
+        // Keys of the layout are replaced by the saved ones:
+        for (it_coords = keys_.begin(); it_coords != keys_.end(); it_coords++) {
+          block_set((*it_coords).first, (*it_coords).second, game::block::EMPTY);
+        }
+
+        keys_.clear();
+
+        for (it_coords = state.keys.begin(); it_coords != state.keys.end(); it_coords++) {
+          if (is_restorable(*it_coords) == false || bb_keys_.test((*it_coords).first, (*it_coords).second) == true) {
+            return false;
+          }
+
+          switch (block_get((*it_coords).first, (*it_coords).second)) {
+            case game::block::EMPTY :
+              block_set((*it_coords).first, (*it_coords).second, game::block::KEY);
+              break;
+
+            case game::block::GATE_OPEN :
+              block_set((*it_coords).first, (*it_coords).second, game::block::GATE_DROPPED_KEY);
+              break;
+
+            default :
+              return false;
+          }
+
+          keys_.push_back(*it_coords);
+        }
+
+        for (it_coords = state.guardians.begin(); it_coords != state.guardians.end(); it_coords++) {
+          if (is_restorable(*it_coords, true) == false) {
+            return false;
+          }
+
+          guardians_[it_coords - state.guardians.begin()].set_coords((*it_coords).first, (*it_coords).second);
+        }
+
+        for (unsigned i = 0; i < GAME_MAX_PLAYERS; i++) {
+          const game::snapshot::player_state &player = state.players[i];
+
+          if (player.present == false || player.lifes == 0) {
+            continue;
+          }
+
+          if (is_restorable(player.coords) == false ||
+              bb_blocked_.test(player.coords.first, player.coords.second) == true) {
+            return false;
+          }
+
+          players_restored_[i] = player;
+        }
+
+        game_speed_ = state.game_speed;
+        ticks_ = state.ticks;
+
+        return true;
+      }}}
+
+
+      /**
+       * @return  true if the coordinates are inside the maze and they're neither a wall nor a target, the guardians
+       *          can stand on the target.
+       */
+      bool is_restorable(const std::pair<schar_t, schar_t> &coords, bool target_allowed = false) const
+      {{{
+        if (coords.first < 0 || coords.first >= dimensions_.first || coords.second < 0 ||
+            coords.second >= dimensions_.second || ps_layout_->bb_walls_.test(coords.first, coords.second) == true) {
+          return false;
+        }
+
+        return target_allowed == true || ps_layout_->bb_targets_.test(coords.first, coords.second) == false;
+      }}}
+
+
+      /**
+       * @return  Slide table of the maze - the layout's one until some of the gates or keys has changed.
+       */
+      const game::slide_table &slides() const
+      {{{
+        return (pu_slides_) ? *pu_slides_ : ps_layout_->slides_;
+      }}}
+
+
+      /**
+       * @return  Approximate number of bytes occupied by this maze only, without the shared layout, the guardians'
+       *          distance fields and the updates of the game.
+       */
+      std::size_t memory_size() const
+      {{{
+        return sizeof(*this) + keys_.capacity() * sizeof(std::pair<schar_t, schar_t>) +
+               guardians_.capacity() * sizeof(game::guardian) + ((pu_slides_) ? pu_slides_->memory_size() : 0);
+      }}}
+
+
+      /**
+       * @return  Approximate number of bytes occupied by the layout, which is shared with the other mazes.
+       */
+      std::size_t layout_memory_size() const
+      {{{
+        return ps_layout_->memory_size();
+      }}}
+
+
       std::string get_scheme()
       {{{
-        return maze_scheme_;
+        return ps_layout_->scheme_;
       }}}
 
 
       std::string get_version()
       {{{
-        return maze_version_;
+        return ps_layout_->version_;
+      }}}
+
+
+      /**
+       * @return  Results of the analysis of the layout for the given player, done when the maze was loaded.
+       */
+      const game::maze_layout::analysis_result &get_analysis(unsigned player_num) const
+      {{{
+        return ps_layout_->get_analysis(player_num);
       }}}
 
 
       bool is_move_possible(std::pair<signed char, signed char> coords, game::E_move move)
       {{{
-        game::block::E_block_type block_type;
+        if (move == game::E_move::STOP || move == game::E_move::NONE) {
+          return true;
+        }
 
-        switch (move) {
-          case game::E_move::LEFT :
-            coords.second--;
-            break;
+        return slides().length(coords.first, coords.second, static_cast<game::slide_table::E_direction>(move)) > 0;
+      }}}
 
-          case game::E_move::RIGHT :
-            coords.second++;
-            break;
 
-          case game::E_move::UP :
-            coords.first--;
-            break;
+      /**
+       * Moves every guardian one block towards the nearest of the given targets (the alive players). Every guardian
+       * follows the BFS distance fields of the targets, which are shared by all the guardians and cached by the maze,
+       * so one step of the guardian is O(1).
+       */
+      void guardians_move(const std::vector<std::pair<schar_t, schar_t>> &targets)
+      {{{
+        static const schar_t ROW_OFFSETS[] = {0, 0, -1, 1};
+        static const schar_t COL_OFFSETS[] = {-1, 1, 0, 0};
 
-          case game::E_move::DOWN :
-            coords.first++;
-            break;
+        std::vector<std::shared_ptr<const game::distance_fields::field>> fields;
+        std::vector<std::pair<schar_t, schar_t>>::const_iterator it_targets;
+        std::vector<game::guardian>::iterator it_guardians;
 
-          case game::E_move::STOP :
-          case game::E_move::NONE :
-            return true;
+        for (it_targets = targets.begin(); it_targets != targets.end(); it_targets++) {
+          fields.push_back(distances_.get(bb_blocked_, *it_targets));
+        }
 
-          default :
-            return false;
+        if (fields.empty() == true) {
+          return;
+        }
+
+        for (it_guardians = guardians_.begin(); it_guardians != guardians_.end(); it_guardians++) {
+          std::pair<schar_t, schar_t> coords = (*it_guardians).get_coords();
+          unsigned short cell = coords.first * dimensions_.second + coords.second;
+
+          // The nearest target is chased:
+          const game::distance_fields::field *p_field = fields[0].get();
+
+          for (std::size_t i = 1; i < fields.size(); i++) {
+            if ((*fields[i])[cell] < (*p_field)[cell]) {
+              p_field = fields[i].get();
+            }
+          }
+
+          unsigned short distance = (*p_field)[cell];
+
+          if (distance == game::distance_fields::UNREACHABLE || distance == 0) {
+            continue;
+          }
+
+          // Any neighbour closer to the target is on one of the shortest paths:
+          for (unsigned i = 0; i < 4; i++) {
+            schar_t next_row = coords.first + ROW_OFFSETS[i];
+            schar_t next_col = coords.second + COL_OFFSETS[i];
+
+            if (next_row < 0 || next_row >= dimensions_.first || next_col < 0 || next_col >= dimensions_.second) {
+              continue;
+            }
+
+            if ((*p_field)[next_row * dimensions_.second + next_col] == distance - 1) {
+              (*it_guardians).set_coords(next_row, next_col);
+              break;
+            }
+          }
         }
 
-        block_type = matrix_[coords.first % dimensions_.first][coords.second % dimensions_.second].get();
+        return;
+      }}}
+
+
+      /**
+       * @return  KEYFRAME or DELTA update of actual tick encoded as a frame in binary format, without the last_move.
+       */
+      const std::shared_ptr<const std::vector<char>> &encoded_update(bool delta)
+      {{{
+        std::shared_ptr<const std::vector<char>> &ps_encoded = (delta == true) ? ps_next_delta_encoded_ :
+                                                                                 ps_next_update_encoded_;
+        if (!ps_encoded) {
+          protocol::frame frame_out;
+
+          frame_out.channel = protocol::E_channel::GAME_UPDATE;
+          frame_out.upd = (delta == true) ? next_deltas_[0] : next_updates_[0];
+
+          // The last_move is the last enum of the frame, encoded as 1 byte:
+          ps_encoded = protocol::tcp_serialization::encode_shared(frame_out, 1);
+        }
 
-        return (block_type == game::block::WALL || block_type == game::block::GATE_CLOSED ||
-                block_type == game::block::KEY) ? false : true;
+        return ps_encoded;
       }}}
   };
 }
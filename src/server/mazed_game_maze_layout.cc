@@ -0,0 +1,230 @@
+/**
+ * @file      mazed_game_maze_layout.cc
+ * @author    Dee'Kej (David Kaspar - xkaspa34)
+ * @version   0.1
+ * @brief     Contains the analysis of the game::maze_layout done when the maze is loaded.
+ */
+
+
+/* ****************************************************************************************************************** *
+ * ***[ START OF MAZED_GAME_MAZE_LAYOUT.CC ]************************************************************************* *
+ * ****************************************************************************************************************** */
+
+
+/* ****************************************************************************************************************** *
+ ~ ~~~[ HEADER FILES ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ ~
+ * ****************************************************************************************************************** */
+
+#include <algorithm>
+#include <deque>
+#include <unordered_set>
+
+#include "mazed_game_maze_layout.hh"
+
+
+/* ****************************************************************************************************************** *
+ ~ ~~~[ MEMBER FUNCTIONS IMPLEMENTATIONS ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ ~
+ * ****************************************************************************************************************** */
+
+namespace game {
+
+  /**
+   * Analyses the layout for every player's starting block. Has to be called once the layout is complete.
+   */
+  void maze_layout::analyse()
+  {{{
+    for (unsigned i = 0; i < GAME_MAX_PLAYERS; i++) {
+      analyses_[i] = analyse_start(players_start_coords_[i]);
+    }
+
+    return;
+  }}}
+
+  // // // // // // // // // // //
+
+  /**
+   * Flood fills the region reachable from the starting block in the given state of the maze. The taken keys & opened
+   * gates are passable, the others only border the region.
+   *
+   * @param[in]   start         Coordinates of the starting block.
+   * @param[in]   items_index   Index of the key | gate within the state for every block, -1 for the other blocks.
+   * @param[in]   state         Taken keys followed by the opened gates.
+   * @param[out]  region        Blocks of the region.
+   * @param[out]  bordering     Indexes of the keys & gates bordering the region.
+   */
+  void maze_layout::region_fill(std::pair<schar_t, schar_t> start, const std::vector<int> &items_index,
+                                const std::vector<bool> &state, std::vector<bool> &region,
+                                std::vector<int> &bordering) const
+  {{{
+    schar_t rows = dimensions_.first;
+    schar_t cols = dimensions_.second;
+
+    const schar_t moves[4][2] = {{-1, 0}, {1, 0}, {0, -1}, {0, 1}};
+
+    std::deque<std::pair<schar_t, schar_t>> queue {start};
+
+    region.assign(rows * cols, false);
+    bordering.clear();
+
+    region[start.first * cols + start.second] = true;
+
+    while (queue.empty() == false) {
+      std::pair<schar_t, schar_t> cell = queue.front();
+      queue.pop_front();
+
+      for (unsigned i = 0; i < 4; i++) {
+        schar_t row = cell.first + moves[i][0];
+        schar_t col = cell.second + moves[i][1];
+
+        if (row < 0 || row >= rows || col < 0 || col >= cols || region[row * cols + col] == true ||
+            bb_walls_.test(row, col) == true) {
+          continue;
+        }
+
+        int item = items_index[row * cols + col];
+
+        if (item >= 0 && state[item] == false) {
+          if (std::find(bordering.begin(), bordering.end(), item) == bordering.end()) {
+            bordering.push_back(item);
+          }
+
+          continue;
+        }
+
+        region[row * cols + col] = true;
+        queue.emplace_back(row, col);
+      }
+    }
+
+    return;
+  }}}
+
+
+  /**
+   * Finds out whether the target can be reached from the given starting block. The states of the maze (keys taken &
+   * gates opened so far) are searched breadth first: the region reachable in the state is flood filled, then every key
+   * bordering the region is taken (while no key is held) or every gate bordering the region is opened (with the held
+   * key), each giving the next state. So every order of taking keys & opening gates is tried, and the target is found
+   * with the least keys & gates used. When there are too many states to be searched, the target is assumed to be
+   * reachable, so the maze is never refused because of the analysis only.
+   *
+   * @param[in]   start   Coordinates of the starting block.
+   * @return      Result of the analysis, the moves are estimated as the shortest path to the nearest target within the
+   *              final region (the detours for the keys are not counted).
+   */
+  maze_layout::analysis_result maze_layout::analyse_start(std::pair<schar_t, schar_t> start) const
+  {{{
+    analysis_result result;
+
+    schar_t rows = dimensions_.first;
+    schar_t cols = dimensions_.second;
+
+    if (bb_walls_.test(start.first, start.second) == true) {
+      return result;                                // Starting block is not present in the maze.
+    }
+
+    const schar_t moves[4][2] = {{-1, 0}, {1, 0}, {0, -1}, {0, 1}};
+
+    std::size_t keys_num = keys_.size();
+    std::vector<int> items_index(rows * cols, -1);
+
+    for (std::size_t i = 0; i < keys_num; i++) {
+      items_index[keys_[i].first * cols + keys_[i].second] = i;
+    }
+
+    for (std::size_t i = 0; i < gates_.size(); i++) {
+      items_index[gates_[i].first * cols + gates_[i].second] = keys_num + i;
+    }
+
+    std::vector<std::vector<bool>> states {std::vector<bool>(keys_num + gates_.size(), false)};
+    std::unordered_set<std::vector<bool>> states_seen {states[0]};
+
+    std::vector<bool> region;                       // Region of the actual state.
+    std::vector<int> bordering;
+    std::vector<int>::iterator it_item;
+
+    // {{{ Search of the states, taking keys & opening gates:
+    for (std::size_t i = 0; i < states.size(); i++) {
+      region_fill(start, items_index, states[i], region, bordering);
+
+      for (std::size_t cell = 0; cell < region.size() && result.solvable == false; cell++) {
+        result.solvable = (region[cell] == true && bb_targets_.test(cell / cols, cell % cols) == true);
+      }
+
+      std::size_t keys_taken = std::count(states[i].begin(), states[i].begin() + keys_num, true);
+      std::size_t gates_opened = std::count(states[i].begin() + keys_num, states[i].end(), true);
+
+      if (result.solvable == true) {
+        result.reachable = (i == 0);
+        result.keys_used = gates_opened;
+        break;
+      }
+
+      bool key_held = (keys_taken > gates_opened);
+
+      for (it_item = bordering.begin(); it_item != bordering.end(); it_item++) {
+        // The key can be taken with empty hands only, the gate can be opened with the held key only:
+        if ((static_cast<std::size_t>(*it_item) < keys_num) == key_held) {
+          continue;
+        }
+
+        std::vector<bool> next_state = states[i];
+        next_state[*it_item] = true;
+
+        if (states_seen.insert(next_state).second == false) {
+          continue;
+        }
+
+        if (states.size() >= GAME_ANALYSIS_STATES_MAX) {
+          result.solvable = true;
+          result.verified = false;
+          return result;
+        }
+
+        states.push_back(next_state);
+      }
+    }
+
+    if (result.solvable == false) {
+      return result;                                // Nothing else can be done, the target can't be reached.
+    }
+    // }}}
+
+    // {{{ Shortest path within the final region:
+    std::vector<int> distances(rows * cols, -1);
+    std::deque<std::pair<schar_t, schar_t>> queue {start};
+
+    distances[start.first * cols + start.second] = 0;
+
+    while (queue.empty() == false) {
+      std::pair<schar_t, schar_t> cell = queue.front();
+      queue.pop_front();
+
+      if (bb_targets_.test(cell.first, cell.second) == true) {
+        result.min_moves = distances[cell.first * cols + cell.second];
+        break;
+      }
+
+      for (unsigned i = 0; i < 4; i++) {
+        schar_t row = cell.first + moves[i][0];
+        schar_t col = cell.second + moves[i][1];
+
+        if (row < 0 || row >= rows || col < 0 || col >= cols || region[row * cols + col] == false ||
+            distances[row * cols + col] >= 0) {
+          continue;
+        }
+
+        distances[row * cols + col] = distances[cell.first * cols + cell.second] + 1;
+        queue.emplace_back(row, col);
+      }
+    }
+    // }}}
+
+    return result;
+  }}}
+}
+
+/* ****************************************************************************************************************** *
+ * ***[ END OF MAZED_GAME_MAZE_LAYOUT.CC ]*************************************************************************** *
+ * ****************************************************************************************************************** */
+
@@ -0,0 +1,224 @@
+/**
+ * @file      mazed_game_maze_layout.hh
+ * @author    Dee'Kej (David Kaspar - xkaspa34)
+ * @version   0.1
+ * @brief     Contains the immutable layout of the maze shared by all the game instances of the same maze.
+ */
+
+
+/* ****************************************************************************************************************** *
+ * ***[ START OF MAZED_GAME_MAZE_LAYOUT.HH ]************************************************************************* *
+ * ****************************************************************************************************************** */
+
+#ifndef H_GUARD_MAZED_GAME_MAZE_LAYOUT_HH
+#define H_GUARD_MAZED_GAME_MAZE_LAYOUT_HH
+
+
+/* ****************************************************************************************************************** *
+ ~ ~~~[ HEADER FILES ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ ~
+ * ****************************************************************************************************************** */
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "mazed_game_globals.hh"
+#include "mazed_game_bitboard.hh"
+#include "mazed_game_block.hh"
+#include "../slide_table.hh"
+
+
+/* ****************************************************************************************************************** *
+ ~ ~~~[ MAZE_LAYOUT CLASS ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ ~
+ * ****************************************************************************************************************** */
+
+namespace mazed {
+  class maze_file;
+}
+
+namespace game {
+
+  class maze;
+  class instance;
+
+  #define GAME_ANALYSIS_STATES_MAX  4096U     // Maximum number of states searched by the analysis of one start.
+
+  /**
+   * Static layout of the maze as parsed from the maze file - the scheme, the blocks, the starting coordinates and the
+   * initial navigation tables. It's filled in by the mazed::maze_file only and it's never modified afterwards, so one
+   * layout is shared (read-only) by all the game::maze objects created from the same maze file. Everything what
+   * changes during the game (gates, keys, players) is kept by the game::maze itself. The layout is analysed once it's
+   * loaded, so the mazes which can't be finished are known before any game is created from them.
+   */
+  class maze_layout {
+      friend class mazed::maze_file;
+      friend class game::maze;
+      friend class game::instance;
+
+      using schar_t = signed char;
+
+    public:
+      // Result of the analysis of the layout for one starting block. Guardians are not taken into account:
+      struct analysis_result {
+        bool                                        reachable {false};    // Target reachable without any key.
+        bool                                        solvable {false};     // Target reachable with the keys & gates.
+        unsigned                                    keys_used {0};        // Least gates opened on the way.
+        int                                         min_moves {-1};       // Lower estimate | -1 if not solvable.
+        bool                                        verified {true};      // false - too many states, solvable assumed.
+      };
+
+    private:
+
+      std::pair<schar_t, schar_t>                               dimensions_;
+      std::string                                               scheme_;
+      std::string                                               version_;
+
+      std::vector<game::block>                                  blocks_;          // Row-major, keys are EMPTY.
+      std::vector<std::pair<schar_t, schar_t>>                  gates_;
+      std::vector<std::pair<schar_t, schar_t>>                  keys_;            // Initial positions.
+      std::vector<std::pair<schar_t, schar_t>>                  guardians_;       // Initial positions.
+      std::array<std::pair<schar_t, schar_t>, GAME_MAX_PLAYERS> players_start_coords_;
+
+      game::bitboard                                            bb_walls_;
+      game::bitboard                                            bb_targets_;
+      game::bitboard                                            bb_keys_;         // Initial positions.
+      game::bitboard                                            bb_blocked_;      // Initial, gates closed.
+
+      game::slide_table                                         slides_;          // Initial, gates closed.
+
+      std::array<analysis_result, GAME_MAX_PLAYERS>             analyses_;        // Filled in by the analyse().
+      std::uint32_t                                             fingerprint_ {0}; // Checksum of the maze's content.
+
+      // // // // // // // // // // //
+
+      /**
+       * Sets the block of the layout while it's being parsed. Keys are kept aside of the blocks, because the key can be
+       * moved during the game.
+       */
+      void block_set(schar_t row, schar_t col, game::block::E_block_type type)
+      {{{
+        blocks_[row * dimensions_.second + col].set((type == game::block::KEY) ? game::block::EMPTY : type);
+
+        switch (type) {
+          case game::block::WALL :
+            bb_walls_.set(row, col);
+            break;
+
+          case game::block::TARGET :
+            bb_targets_.set(row, col);
+            break;
+
+          case game::block::GATE_CLOSED :
+            gates_.emplace_back(row, col);
+            break;
+
+          case game::block::KEY :
+            bb_keys_.set(row, col);
+            keys_.emplace_back(row, col);
+            break;
+
+          default :
+            break;
+        }
+
+        if (type == game::block::WALL || type == game::block::GATE_CLOSED || type == game::block::KEY) {
+          bb_blocked_.set(row, col);
+          slides_.set_blocked(row, col, true);
+        }
+
+        return;
+      }}}
+
+      void region_fill(std::pair<schar_t, schar_t> start, const std::vector<int> &items_index,
+                       const std::vector<bool> &state, std::vector<bool> &region, std::vector<int> &bordering) const;
+      analysis_result analyse_start(std::pair<schar_t, schar_t> start) const;
+      void analyse();
+
+    public:
+      maze_layout(schar_t row_num, schar_t col_num) :
+        dimensions_(row_num, col_num), blocks_(row_num * col_num), slides_(row_num, col_num)
+      {{{
+        return;
+      }}}
+
+
+      ~maze_layout()
+      {{{
+        return;
+      }}}
+
+
+      signed char get_rows() const
+      {{{
+        return dimensions_.first;
+      }}}
+
+
+      signed char get_cols() const
+      {{{
+        return dimensions_.second;
+      }}}
+
+
+      std::size_t get_keys_num() const
+      {{{
+        return keys_.size();
+      }}}
+
+
+      std::size_t get_gates_num() const
+      {{{
+        return gates_.size();
+      }}}
+
+
+      std::size_t get_guardians_num() const
+      {{{
+        return guardians_.size();
+      }}}
+
+
+      /**
+       * @return  Checksum of the maze's content, which is the same for the text & the compiled maze.
+       */
+      std::uint32_t get_fingerprint() const
+      {{{
+        return fingerprint_;
+      }}}
+
+
+      std::pair<schar_t, schar_t> get_start_coords(unsigned player_num) const
+      {{{
+        return players_start_coords_[player_num];
+      }}}
+
+
+      /**
+       * @return  Results of the analysis for the starting block of the given player.
+       */
+      const analysis_result &get_analysis(unsigned player_num) const
+      {{{
+        return analyses_[player_num];
+      }}}
+
+
+      /**
+       * @return  Approximate number of bytes occupied by the layout, shared by all the mazes created from it.
+       */
+      std::size_t memory_size() const
+      {{{
+        return sizeof(*this) + scheme_.capacity() + version_.capacity() + blocks_.capacity() * sizeof(game::block) +
+               (gates_.capacity() + keys_.capacity() + guardians_.capacity()) * sizeof(std::pair<schar_t, schar_t>) +
+               slides_.memory_size();
+      }}}
+  };
+}
+
+/* ****************************************************************************************************************** *
+ * ***[ END OF MAZED_GAME_MAZE_LAYOUT.HH ]*************************************************************************** *
+ * ****************************************************************************************************************** */
+
+#endif
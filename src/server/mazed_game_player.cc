@@ -36,8 +36,6 @@ namespace game {
   player::player(const std::string &puid, const std::string &auth_key, const std::string &nick,
                  mazed::client_handler *p_client_handler) :
     basic_player(),
-    socket_(io_service_),
-    acceptor_(io_service_, tcp::endpoint(tcp::v4(), static_cast<unsigned short>(0))),
     UID_{puid}, auth_key_{auth_key}, p_cl_handler_{p_client_handler}
   {{{
     if (nick.length() == 0) {
@@ -47,23 +45,42 @@ namespace game {
       nick_ = nick;
     }
 
-    pu_tcp_connect_ = std::unique_ptr<protocol::tcp_serialization>(new protocol::tcp_serialization(socket_));
+    multiplexed_ = p_cl_handler_->multiplexed_;
+    delta_ = p_cl_handler_->delta_accepted_;
+    binary_ = p_cl_handler_->binary_accepted_;
+
+    // Game updates & commands are using client's connection, no need for another one:
+    if (multiplexed_ == true) {
+      return;
+    }
+
+    pu_io_service_ = std::unique_ptr<asio::io_service>(new asio::io_service);
+    pu_socket_ = std::unique_ptr<tcp::socket>(new tcp::socket(*pu_io_service_));
+    pu_acceptor_ = std::unique_ptr<tcp::acceptor>(new tcp::acceptor(*pu_io_service_,
+                                                                    tcp::endpoint(tcp::v4(),
+                                                                                  static_cast<unsigned short>(0))));
+
+    pu_tcp_connect_ = std::unique_ptr<protocol::tcp_serialization>(new protocol::tcp_serialization(*pu_socket_));
     return;
   }}}
 
 
   player::~player()
   {{{
+    if (multiplexed_ == true) {
+      return;
+    }
+
     access_mutex_.lock();
     {
-      if (socket_.is_open() == true) {
+      if (pu_socket_->is_open() == true) {
         boost::system::error_code ignored_error;
-        socket_.shutdown(boost::asio::ip::tcp::socket::shutdown_both, ignored_error);
-        socket_.cancel();
-        socket_.close();
+        pu_socket_->shutdown(boost::asio::ip::tcp::socket::shutdown_both, ignored_error);
+        pu_socket_->cancel();
+        pu_socket_->close();
       }
 
-      io_service_.stop();
+      pu_io_service_->stop();
     }
     access_mutex_.unlock();
 
@@ -72,9 +89,12 @@ namespace game {
 
   // // // // // // // // // // //
 
+  /**
+   * @return  Port of the game connection's acceptor, or 0 if the game channel is multiplexed.
+   */
   unsigned short player::port()
   {{{
-    return acceptor_.local_endpoint().port();
+    return (multiplexed_ == true) ? 0 : pu_acceptor_->local_endpoint().port();
   }}}
 
 
@@ -89,20 +109,60 @@ namespace game {
   {{{
     start_coords_ = coords;
     coords_ = coords;
-    p_maze_->matrix_[coords.first][coords.second].add_player(this);
+    p_maze_->player_enter(coords.first, coords.second, player_num_);
+    return;
+  }}}
+
+
+  /**
+   * Moves the player to the position of the saved game, the start coordinates are kept for the respawn. Expects the
+   * coordinates to be checked by the maze::restore() already.
+   */
+  void player::restore(std::pair<signed char, signed char> coords, unsigned char lifes, bool has_key)
+  {{{
+    p_maze_->player_leave(coords_.first, coords_.second, player_num_);
+
+    coords_ = coords;
+    lifes_ = lifes;
+    has_key_ = has_key;
+
+    p_maze_->player_enter(coords_.first, coords_.second, player_num_);
     return;
   }}}
 
   
+  std::string player::get_UID()
+  {{{
+    return UID_;
+  }}}
+
+
   std::pair<signed char, signed char> player::get_coords()
   {{{
     return coords_;
   }}}
 
+
+  bool player::has_key()
+  {{{
+    return has_key_;
+  }}}
+
   // // // // // // // // // // //
 
   void player::run()
   {{{
+    // Client is already connected, there's nothing to wait for:
+    if (multiplexed_ == true) {
+      access_mutex_.lock();
+      {
+        connected_ = true;
+      }
+      access_mutex_.unlock();
+
+      return;
+    }
+
     pu_thread_ = std::unique_ptr<boost::thread>(new boost::thread(&player::start_accept, this));
     pu_thread_->detach();
     return;
@@ -113,18 +173,19 @@ namespace game {
   {{{
     access_mutex_.lock();
     {
-      if (socket_.is_open() == true) {
-        boost::system::error_code ignored_error;
-        socket_.shutdown(boost::asio::ip::tcp::socket::shutdown_both, ignored_error);
-        socket_.cancel();
-        socket_.close();
-      }
+      if (multiplexed_ == false) {
+        if (pu_socket_->is_open() == true) {
+          boost::system::error_code ignored_error;
+          pu_socket_->shutdown(boost::asio::ip::tcp::socket::shutdown_both, ignored_error);
+          pu_socket_->cancel();
+          pu_socket_->close();
+        }
 
-      io_service_.stop();
+        pu_io_service_->stop();
+        pu_io_service_->reset();
+      }
 
       connected_ = false;
-
-      io_service_.reset();
     }
     access_mutex_.unlock();
 
@@ -135,19 +196,19 @@ namespace game {
 
   void player::start_accept()
   {{{
-    acceptor_.async_accept(socket_, boost::bind(&player::handle_accept, this, _1));
-    io_service_.run();
+    pu_acceptor_->async_accept(*pu_socket_, boost::bind(&player::handle_accept, this, _1));
+    pu_io_service_->run();
     return;
   }}}
 
 
   void player::handle_accept(const boost::system::error_code &error)
   {{{
-    acceptor_.close();
+    pu_acceptor_->close();
 
     if (error) {
       p_cl_handler_->log(mazed::log_level::ERROR, error.message().c_str());
-      acceptor_.async_accept(socket_, boost::bind(&player::handle_accept, this, _1));
+      pu_acceptor_->async_accept(*pu_socket_, boost::bind(&player::handle_accept, this, _1));
       return;
     }
     
@@ -161,7 +222,7 @@ namespace game {
   {{{
     if (error) {
       p_cl_handler_->log(mazed::log_level::ERROR, error.message().c_str());
-      acceptor_.async_accept(socket_, boost::bind(&player::handle_accept, this, _1));
+      pu_acceptor_->async_accept(*pu_socket_, boost::bind(&player::handle_accept, this, _1));
       return;
     }
 
@@ -171,14 +232,14 @@ namespace game {
 
       p_cl_handler_->log(mazed::log_level::INFO, "Client's authentication failed");
 
-      if (socket_.is_open() == true) {
+      if (pu_socket_->is_open() == true) {
         boost::system::error_code ignored_error;
-        socket_.shutdown(boost::asio::ip::tcp::socket::shutdown_both, ignored_error);
-        socket_.cancel();
-        socket_.close();
+        pu_socket_->shutdown(boost::asio::ip::tcp::socket::shutdown_both, ignored_error);
+        pu_socket_->cancel();
+        pu_socket_->close();
       }
 
-      acceptor_.async_accept(socket_, boost::bind(&player::handle_accept, this, _1));
+      pu_acceptor_->async_accept(*pu_socket_, boost::bind(&player::handle_accept, this, _1));
       return;
     }
     
@@ -219,21 +280,48 @@ namespace game {
       }
 
       p_cl_handler_->ps_instance_->remove_player(this);
-      p_cl_handler_->pu_player_.reset();
+      p_cl_handler_->game_finished();
       return;
     }
 
-    access_mutex_.lock();
+    process_command(commands_in_[0]);
+
+    async_receive();
+    return;
+  }}}
+
+
+  /**
+   * Processes the command received from the client, either over the player's own game connection, or over the client's
+   * connection when the game channel is multiplexed. The command itself is buffered for the next game update.
+   *
+   * @param[in]   cmd     Command issued by the player.
+   */
+  void player::process_command(const protocol::command &cmd)
+  {{{
+    if (cmd.cmd == KEYFRAME_REQUEST) {
+      access_mutex_.lock();
+      {
+        keyframe_pending_ = true;
+      }
+      access_mutex_.unlock();
+
+      return;
+    }
+
+    // NOTE: Maze is always locked before the player, the same way as the game loop does.
+    p_maze_->access_mutex_.lock();
     {
-      p_maze_->access_mutex_.lock();
+      access_mutex_.lock();
       if (p_maze_->game_finished_ == false) {
 
         if (p_maze_->game_run_ == false) {
 
-          if (commands_in_[0].cmd == START_CONTINUE) {
+          if (cmd.cmd == START_CONTINUE) {
             if (p_maze_->game_owner_ == UID_) {
               p_maze_->game_run_ = true;
               last_move_result_ = POSSIBLE;
+              p_cl_handler_->ps_instance_->status_changed(protocol::E_game_status::RUNNING);
             }
             else {
               last_move_result_ = NOT_POSSIBLE;
@@ -241,16 +329,17 @@ namespace game {
 
             command_buffer_ = protocol::E_user_command::NONE;
           }
-          else {
-            command_buffer_ = commands_in_[0].cmd;
+          else if (game_over_ == false) {
+            command_buffer_ = cmd.cmd;
           }
 
         }
         else {
-          if (commands_in_[0].cmd == PAUSE) {
+          if (cmd.cmd == PAUSE) {
             if (p_maze_->game_owner_ == UID_ && game_over_ == false) {
               p_maze_->game_run_ = false;
               last_move_result_ = POSSIBLE;
+              p_cl_handler_->ps_instance_->status_changed(protocol::E_game_status::PAUSED);
             }
             else {
               last_move_result_ = NOT_POSSIBLE;
@@ -259,29 +348,55 @@ namespace game {
             command_buffer_ = protocol::E_user_command::NONE;
           }
           else if (command_buffer_ == protocol::E_user_command::NONE && game_over_ == false) {
-            command_buffer_ = commands_in_[0].cmd;
+            command_buffer_ = cmd.cmd;
           }
         }
 
       }
-      p_maze_->access_mutex_.unlock();
+      access_mutex_.unlock();
     }
-    access_mutex_.unlock();
+    p_maze_->access_mutex_.unlock();
 
-    async_receive();
     return;
   }}}
 
   
-  void player::update_client(std::vector<protocol::update> &updates)
+  /**
+   * Sends the game update of actual tick to the client. The DELTA update is sent only if the client uses them and it
+   * has received the previous update, otherwise the KEYFRAME update is sent. When the client's connection uses the
+   * binary format, the update encoded once for all the players is sent, followed by the player's last_move.
+   *
+   * @param[in]   keyframe_tick   The KEYFRAME has to be sent to all clients.
+   * @param[in]   delay           Delay of the sending in ms given by the pacing. Used only for multiplexed channel.
+   */
+  void player::update_client(bool keyframe_tick, long delay)
   {{{
     access_mutex_.lock();
     {
       if (connected_ == true) {
-        updates[0].last_move = last_move_result_;
+        bool delta = (delta_ == true && keyframe_tick == false && keyframe_pending_ == false);
+
+        keyframe_pending_ = false;
+
+        if (multiplexed_ == true && binary_ == true) {
+          p_cl_handler_->async_send(p_maze_->encoded_update(delta), last_move_result_, delta, delay);
+          access_mutex_.unlock();
+          return;
+        }
+
+        updates_out_ = (delta == true) ? p_maze_->next_deltas_ : p_maze_->next_updates_;
+        updates_out_[0].last_move = last_move_result_;
 
-        pu_tcp_connect_->async_write(updates, boost::bind(&player::update_client_handler, this,
-                                     boost::asio::placeholders::error));
+        if (multiplexed_ == true) {
+          p_cl_handler_->async_send(updates_out_[0], delay);
+        }
+        else {
+          pu_tcp_connect_->async_write(updates_out_, boost::bind(&player::update_client_handler, this,
+                                       boost::asio::placeholders::error));
+        }
+      }
+      else {
+        keyframe_pending_ = true;       // The client will miss this update.
       }
     }
     access_mutex_.unlock();
@@ -308,7 +423,7 @@ namespace game {
       }
 
       p_cl_handler_->ps_instance_->remove_player(this);
-      p_cl_handler_->pu_player_.reset();
+      p_cl_handler_->game_finished();
     }
     
     return;
@@ -317,9 +432,7 @@ namespace game {
   
   void player::game_finished()
   {{{
-    // TODO: Store the statistics into client handler.
-    p_cl_handler_->ps_instance_.reset(); 
-    p_cl_handler_->pu_player_.reset();
+    p_cl_handler_->game_finished();     // The player is released by its client handler.
     return;
   }}}
 
@@ -331,7 +444,7 @@ namespace game {
       return;
     }
 
-    p_maze_->matrix_[coords_.first][coords_.second].remove_player(this);
+    p_maze_->player_leave(coords_.first, coords_.second, player_num_);
 
     switch (move) {
       case LEFT :
@@ -354,7 +467,7 @@ namespace game {
         break;
     }
 
-    p_maze_->matrix_[coords_.first][coords_.second].add_player(this);
+    p_maze_->player_enter(coords_.first, coords_.second, player_num_);
     invulnerability_ = false;
     
     return;
@@ -389,8 +502,8 @@ namespace game {
     key_coords.first %= p_maze_->dimensions_.first;
     key_coords.second %= p_maze_->dimensions_.second;
     
-    if (p_maze_->matrix_[key_coords.first][key_coords.second].get() == game::block::KEY) {
-      p_maze_->matrix_[key_coords.first][key_coords.second].set(game::block::EMPTY);
+    if (p_maze_->block_get(key_coords.first, key_coords.second) == game::block::KEY) {
+      p_maze_->block_set(key_coords.first, key_coords.second, game::block::EMPTY);
       has_key_ = true;
 
       std::vector<std::pair<signed char, signed char>>::iterator it_keys;
@@ -406,8 +519,8 @@ namespace game {
 
       return POSSIBLE;
     }
-    else if (p_maze_->matrix_[key_coords.first][key_coords.second].get() == game::block::GATE_DROPPED_KEY) {
-      p_maze_->matrix_[key_coords.first][key_coords.second].set(game::block::GATE_OPEN);
+    else if (p_maze_->block_get(key_coords.first, key_coords.second) == game::block::GATE_DROPPED_KEY) {
+      p_maze_->block_set(key_coords.first, key_coords.second, game::block::GATE_OPEN);
       has_key_ = true;
 
       std::vector<std::pair<signed char, signed char>>::iterator it_keys;
@@ -456,8 +569,8 @@ namespace game {
     gate_coords.first %= p_maze_->dimensions_.first;
     gate_coords.second %= p_maze_->dimensions_.second;
     
-    if (p_maze_->matrix_[gate_coords.first][gate_coords.second].get() == game::block::GATE_CLOSED) {
-      p_maze_->matrix_[gate_coords.first][gate_coords.second].set(game::block::GATE_OPEN);
+    if (p_maze_->block_get(gate_coords.first, gate_coords.second) == game::block::GATE_CLOSED) {
+      p_maze_->block_set(gate_coords.first, gate_coords.second, game::block::GATE_OPEN);
       has_key_ = false;
       return POSSIBLE;
     }
@@ -473,6 +586,12 @@ namespace game {
 
     access_mutex_.lock();
     {
+      // Player without any lifes left is only watching the game:
+      if (game_over_ == true) {
+        access_mutex_.unlock();
+        return false;
+      }
+
       command_act = command_buffer_;
       command_buffer_ = protocol::E_user_command::NONE;
     }
@@ -565,55 +684,56 @@ namespace game {
         break;
     }
 
-    return (p_maze_->matrix_[coords_.first][coords_.second].get() == game::block::TARGET) ? true : false;
+    return (p_maze_->block_get(coords_.first, coords_.second) == game::block::TARGET) ? true : false;
   }}}
 
 
+  /**
+   * Kills the player caught by a guardian. The key held by the player is dropped and the player respawns at its start
+   * coordinates, unless it has no lifes left. Expects the maze to be locked by the game loop.
+   *
+   * @return  'true' if the player has been killed | 'false' if it's invulnerable.
+   */
   bool player::kill()
   {{{
     if (invulnerability_ == true) {
       return false;
     }
 
-    p_maze_->access_mutex_.lock();
-    {
-      if (has_key_ == true) {
-        {
-          if (p_maze_->matrix_[coords_.first][coords_.second].get() == game::block::GATE_OPEN) {
-            p_maze_->matrix_[coords_.first][coords_.second].set(game::block::GATE_DROPPED_KEY);
-          }
-          else {
-            p_maze_->matrix_[coords_.first][coords_.second].set(game::block::KEY);
-          }
-          
-          p_maze_->keys_.push_back(coords_);
-        }
-
-        has_key_ = false;
+    if (has_key_ == true) {
+      if (p_maze_->block_get(coords_.first, coords_.second) == game::block::GATE_OPEN) {
+        p_maze_->block_set(coords_.first, coords_.second, game::block::GATE_DROPPED_KEY);
+      }
+      else {
+        p_maze_->block_set(coords_.first, coords_.second, game::block::KEY);
       }
 
-      access_mutex_.lock();
-      {
-        p_maze_->matrix_[coords_.first][coords_.second].remove_player(this);
+      p_maze_->keys_.push_back(coords_);
+      has_key_ = false;
+    }
 
-        lifes_--;
-        
-        if (lifes_ > 0) {
-          coords_ = start_coords_;
-        }
-        else {
-          game_over_ = true;
-          p_maze_->players_alive_--;
-        }
+    access_mutex_.lock();
+    {
+      p_maze_->player_leave(coords_.first, coords_.second, player_num_);
 
-        next_move_ = STOP;
+      lifes_--;
+      next_move_ = STOP;
 
-        p_maze_->matrix_[coords_.first][coords_.second].add_player(this);
+      if (lifes_ > 0) {
+        coords_ = start_coords_;
+        invulnerability_ = true;        // Until the first move after the respawn.
+        p_maze_->player_enter(coords_.first, coords_.second, player_num_);
       }
-      access_mutex_.lock();
+      else {
+        game_over_ = true;
+        p_maze_->players_alive_--;
 
+        // Commands received before the death are never executed:
+        command_buffer_ = protocol::E_user_command::NONE;
+        next_move_ = game::E_move::NONE;
+      }
     }
-    p_maze_->access_mutex_.unlock();
+    access_mutex_.unlock();
 
     return true;
   }}}
@@ -19,6 +19,7 @@
  * ****************************************************************************************************************** */
 
 #include <fstream>
+#include <memory>
 
 #include <boost/asio.hpp>
 #include <boost/bind.hpp>
@@ -49,17 +50,23 @@ namespace game {
   class maze;
 
   /**
-   * Derived from basic_player class for server-side purposes.
+   * Derived from basic_player class for server-side purposes. Unless the game channel is multiplexed over the client's
+   * connection, the player accepts its own game connection from the client.
    */
   class player : public basic_player {
       boost::mutex                                  access_mutex_;
 
-      asio::io_service                              io_service_;
-      tcp::socket                                   socket_;
-      tcp::acceptor                                 acceptor_;
+      // Separate game connection, used only when the client doesn't support the multiplexing:
+      std::unique_ptr<asio::io_service>             pu_io_service_;
+      std::unique_ptr<tcp::socket>                  pu_socket_;
+      std::unique_ptr<tcp::acceptor>                pu_acceptor_;
       
       std::unique_ptr<protocol::tcp_serialization>  pu_tcp_connect_;
       bool                                          connected_ {false};
+      bool                                          multiplexed_ {false};
+      bool                                          delta_ {false};             // Client uses DELTA updates.
+      bool                                          binary_ {false};            // Client uses binary format.
+      bool                                          keyframe_pending_ {true};
 
       std::unique_ptr<boost::thread>                pu_thread_;
       
@@ -111,17 +118,21 @@ namespace game {
       
       void set_maze(game::maze *maze_ptr);
       void set_start_coords(std::pair<signed char, signed char> coords);
+      void restore(std::pair<signed char, signed char> coords, unsigned char lifes, bool has_key);
 
       void run();
       void stop();
 
+      std::string get_UID();
       std::pair<signed char, signed char> get_coords();
+      bool has_key();
 
       bool update();
       bool kill();
 
       void game_finished();
-      void update_client(std::vector<protocol::update> &updates);
+      void update_client(bool keyframe_tick, long delay = 0);
+      void process_command(const protocol::command &cmd);
   };
 }
 
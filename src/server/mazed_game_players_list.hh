@@ -123,6 +123,12 @@ namespace game {
       }}}
 
 
+      bool contains(unsigned char player_num, game::player *p_player)
+      {{{
+        return player_num < GAME_MAX_PLAYERS && players_[player_num] == p_player;
+      }}}
+
+
 #ifndef NDEBUG
       void remove(unsigned char player_num, game::player *p_player)
       {{{
@@ -0,0 +1,252 @@
+/**
+ * @file      mazed_game_scheduler.cc
+ * @author    Dee'Kej (David Kaspar - xkaspa34)
+ * @version   0.1
+ * @brief     Contains implementations of class member functions of game::scheduler.
+ */
+
+
+/* ****************************************************************************************************************** *
+ * ***[ START OF MAZED_GAME_SCHEDULER.CC ]*************************************************************************** *
+ * ****************************************************************************************************************** */
+
+
+/* ****************************************************************************************************************** *
+ ~ ~~~[ HEADER FILES ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ ~
+ * ****************************************************************************************************************** */
+
+#include <boost/bind.hpp>
+
+#include "mazed_game_scheduler.hh"
+
+
+/* ****************************************************************************************************************** *
+ ~ ~~~[ MEMBER FUNCTIONS IMPLEMENTATIONS ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ ~
+ * ****************************************************************************************************************** */
+
+namespace game {
+  scheduler::scheduler(unsigned threads) :
+    pu_work_(new boost::asio::io_service::work(io_service_)),
+    timer_(io_service_)
+  {{{
+    for (unsigned i = 0; i < threads; i++) {
+      workers_.create_thread(boost::bind(&boost::asio::io_service::run, &io_service_));
+    }
+
+    return;
+  }}}
+
+
+  scheduler::~scheduler()
+  {{{
+    access_mutex_.lock();
+    {
+      boost::system::error_code ignored_error;
+      timer_.cancel(ignored_error);
+    }
+    access_mutex_.unlock();
+
+    // Ticks being executed are finished, the ones not started yet are dropped:
+    pu_work_.reset();
+    io_service_.stop();
+    workers_.join_all();
+
+    return;
+  }}}
+
+  // // // // // // // // // // //
+
+  /**
+   * Adds new periodic tick. The first tick is executed after the given period.
+   *
+   * @param[in]   tick    Function to be called periodically.
+   * @param[in]   period  Period of the tick in ms, rounded up to the resolution of the scheduler.
+   * @return      ID of the tick, to be used for its removal.
+   */
+  unsigned long scheduler::add(std::function<void()> tick, long period)
+  {{{
+    unsigned long ID;
+
+    access_mutex_.lock();
+    {
+      ID = next_ID_++;
+
+      entry &tick_entry = entries_[ID];
+      tick_entry.tick = tick;
+      tick_entry.period = (period > 0) ? (period + SCHEDULER_RESOLUTION - 1) / SCHEDULER_RESOLUTION : 1;
+      tick_entry.next_due = slots_passed_ + tick_entry.period;
+
+      insert(ID, tick_entry);
+
+      // The timer is not running while there's nothing to schedule:
+      if (timer_running_ == false) {
+        timer_running_ = true;
+        timer_.expires_from_now(boost::posix_time::milliseconds(SCHEDULER_RESOLUTION));
+        timer_.async_wait(boost::bind(&scheduler::timer_handler, this, boost::asio::placeholders::error));
+      }
+    }
+    access_mutex_.unlock();
+
+    return ID;
+  }}}
+
+
+  /**
+   * Removes the tick. If the tick is being executed right now, it waits until it's finished, so it's safe to destroy
+   * anything the tick uses after the return. Unless it's called from the tick itself, it mustn't be called while
+   * holding any lock the tick uses.
+   *
+   * @param[in]   ID      ID of the tick returned by add().
+   */
+  void scheduler::remove(unsigned long ID)
+  {{{
+    boost::unique_lock<boost::mutex> lock(access_mutex_);
+
+    std::unordered_map<unsigned long, entry>::iterator it_entry = entries_.find(ID);
+
+    if (it_entry == entries_.end()) {
+      return;
+    }
+
+    // NOTE: The ID left in the timer wheel is dropped when its slot is reached.
+    if (it_entry->second.running == false) {
+      entries_.erase(it_entry);
+      return;
+    }
+
+    it_entry->second.removed = true;
+
+    if (it_entry->second.thread_ID == boost::this_thread::get_id()) {
+      return;                           // Called from the tick itself, it's removed after it finishes.
+    }
+
+    while (entries_.find(ID) != entries_.end()) {
+      tick_finished_.wait(lock);
+    }
+
+    return;
+  }}}
+
+  // // // // // // // // // // //
+
+  /**
+   * Inserts the entry into the slot of the timer wheel given by its next due. Expects the access_mutex_ to be locked.
+   */
+  void scheduler::insert(unsigned long ID, entry &tick_entry)
+  {{{
+    // The ticks overrunning their period are executed in the next slot:
+    if (tick_entry.next_due <= slots_passed_) {
+      tick_entry.next_due = slots_passed_ + 1;
+    }
+
+    wheel_[tick_entry.next_due % SCHEDULER_SLOTS].push_back(ID);
+    return;
+  }}}
+
+
+  /**
+   * Moves the timer wheel by one slot and passes the due ticks of the slot to the worker threads. Entries due in one of
+   * the next turns of the wheel are kept in the slot.
+   */
+  void scheduler::timer_handler(const boost::system::error_code &error)
+  {{{
+    if (error) {
+      return;                           // Scheduler is being destroyed.
+    }
+
+    access_mutex_.lock();
+    {
+      slots_passed_++;
+
+      std::vector<unsigned long> &slot = wheel_[slots_passed_ % SCHEDULER_SLOTS];
+      std::vector<unsigned long>::iterator it_kept = slot.begin();
+      std::unordered_map<unsigned long, entry>::iterator it_entry;
+
+      for (std::vector<unsigned long>::iterator it_ID = slot.begin(); it_ID != slot.end(); it_ID++) {
+        it_entry = entries_.find(*it_ID);
+
+        if (it_entry == entries_.end()) {
+          continue;                     // Removed tick.
+        }
+
+        if (it_entry->second.next_due > slots_passed_) {
+          *it_kept++ = *it_ID;          // Due in one of the next turns.
+          continue;
+        }
+
+        it_entry->second.running = true;
+        io_service_.post(boost::bind(&scheduler::run_tick, this, *it_ID));
+      }
+
+      slot.erase(it_kept, slot.end());
+
+      if (entries_.empty() == true) {
+        timer_running_ = false;
+      }
+      else {
+        timer_.expires_at(timer_.expires_at() + boost::posix_time::milliseconds(SCHEDULER_RESOLUTION));
+        timer_.async_wait(boost::bind(&scheduler::timer_handler, this, boost::asio::placeholders::error));
+      }
+    }
+    access_mutex_.unlock();
+
+    return;
+  }}}
+
+
+  /**
+   * Executes the tick within one of the worker threads and schedules its next execution.
+   */
+  void scheduler::run_tick(unsigned long ID)
+  {{{
+    std::function<void()> *p_tick;
+
+    access_mutex_.lock();
+    {
+      std::unordered_map<unsigned long, entry>::iterator it_entry = entries_.find(ID);
+
+      if (it_entry == entries_.end()) {
+        access_mutex_.unlock();
+        return;
+      }
+
+      // Removed after being posted, but before it was executed:
+      if (it_entry->second.removed == true) {
+        entries_.erase(it_entry);
+        tick_finished_.notify_all();
+        access_mutex_.unlock();
+        return;
+      }
+
+      it_entry->second.thread_ID = boost::this_thread::get_id();
+      p_tick = &it_entry->second.tick;  // NOTE: Running entry is never erased by anyone else.
+    }
+    access_mutex_.unlock();
+
+    (*p_tick)();
+
+    access_mutex_.lock();
+    {
+      std::unordered_map<unsigned long, entry>::iterator it_entry = entries_.find(ID);
+
+      if (it_entry != entries_.end()) {
+        if (it_entry->second.removed == true) {
+          entries_.erase(it_entry);
+          tick_finished_.notify_all();
+        }
+        else {
+          it_entry->second.running = false;
+          it_entry->second.next_due += it_entry->second.period;
+          insert(ID, it_entry->second);
+        }
+      }
+    }
+    access_mutex_.unlock();
+
+    return;
+  }}}
+}
+
+/* ****************************************************************************************************************** *
+ * ***[ END OF MAZED_GAME_SCHEDULER.CC ]***************************************************************************** *
+ * ****************************************************************************************************************** */
@@ -0,0 +1,88 @@
+/**
+ * @file      mazed_game_scheduler.hh
+ * @author    Dee'Kej (David Kaspar - xkaspa34)
+ * @version   0.1
+ * @brief     Contains declaration of the server-wide scheduler of the game ticks.
+ */
+
+
+/* ****************************************************************************************************************** *
+ * ***[ START OF MAZED_GAME_SCHEDULER.HH ]*************************************************************************** *
+ * ****************************************************************************************************************** */
+
+#ifndef H_GUARD_MAZED_GAME_SCHEDULER_HH
+#define H_GUARD_MAZED_GAME_SCHEDULER_HH
+
+
+/* ****************************************************************************************************************** *
+ ~ ~~~[ HEADER FILES ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ ~
+ * ****************************************************************************************************************** */
+
+#include <array>
+#include <functional>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include <boost/asio.hpp>
+#include <boost/thread.hpp>
+
+
+/* ****************************************************************************************************************** *
+ ~ ~~~[ SCHEDULER CLASS ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ ~
+ * ****************************************************************************************************************** */
+
+namespace game {
+
+  #define SCHEDULER_RESOLUTION  10U     // Duration of one slot of the timer wheel in ms.
+  #define SCHEDULER_SLOTS       256U    // Number of slots of the timer wheel.
+
+  /**
+   * Server-wide scheduler of the game ticks. The ticks are kept in a hashed timer wheel driven by single timer, the
+   * due ticks are executed by a fixed pool of worker threads. One tick of the same game is never executed twice at the
+   * same time, next tick is scheduled after the previous one has finished.
+   */
+  class scheduler {
+      struct entry {
+        std::function<void()>                       tick;
+        unsigned long                               period;       // In slots of the timer wheel.
+        unsigned long                               next_due;     // Absolute number of the slot.
+        bool                                        running {false};
+        bool                                        removed {false};
+        boost::thread::id                           thread_ID;    // Thread executing the tick.
+      };
+
+      boost::asio::io_service                       io_service_;
+      std::unique_ptr<boost::asio::io_service::work> pu_work_;
+      boost::asio::deadline_timer                   timer_;
+      boost::thread_group                           workers_;
+
+      boost::mutex                                  access_mutex_;
+      boost::condition_variable                     tick_finished_;
+
+      std::unordered_map<unsigned long, entry>      entries_;
+      std::array<std::vector<unsigned long>, SCHEDULER_SLOTS> wheel_;
+      unsigned long                                 slots_passed_ {0};
+      unsigned long                                 next_ID_ {1};
+      bool                                          timer_running_ {false};
+
+      // // // // // // // // // // //
+
+      void insert(unsigned long ID, entry &tick_entry);
+      void timer_handler(const boost::system::error_code &error);
+      void run_tick(unsigned long ID);
+
+    public:
+      scheduler(unsigned threads);
+     ~scheduler();
+
+      unsigned long add(std::function<void()> tick, long period);
+      void remove(unsigned long ID);
+  };
+}
+
+/* ****************************************************************************************************************** *
+ * ***[ END OF MAZED_GAME_SCHEDULER.HH ]***************************************************************************** *
+ * ****************************************************************************************************************** */
+
+#endif
@@ -0,0 +1,69 @@
+/**
+ * @file      mazed_game_snapshot.hh
+ * @author    Dee'Kej (David Kaspar - xkaspa34)
+ * @version   0.1
+ * @brief     Contains the copy of the mutable state of the game, which is written as the saved game.
+ */
+
+
+/* ****************************************************************************************************************** *
+ * ***[ START OF MAZED_GAME_SNAPSHOT.HH ]**************************************************************************** *
+ * ****************************************************************************************************************** */
+
+#ifndef H_GUARD_MAZED_GAME_SNAPSHOT_HH
+#define H_GUARD_MAZED_GAME_SNAPSHOT_HH
+
+
+/* ****************************************************************************************************************** *
+ ~ ~~~[ HEADER FILES ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ ~
+ * ****************************************************************************************************************** */
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "mazed_game_globals.hh"
+
+
+/* ****************************************************************************************************************** *
+ ~ ~~~[ SNAPSHOT STRUCTURE ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ ~
+ * ****************************************************************************************************************** */
+
+namespace game {
+
+  /**
+   * Consistent copy of everything what changes during the game, taken by the game::instance under the maze lock. The
+   * static layout is not copied, it's referred by the name of the maze only. The snapshot is never modified after it
+   * has been taken, so it can be encoded & written by another thread without any locking.
+   */
+  struct snapshot {
+    using coords_t = std::pair<signed char, signed char>;
+
+    struct player_state {
+      bool                                          present {false};
+      std::string                                   nick;
+      coords_t                                      coords;
+      unsigned char                                 lifes {0};
+      bool                                          has_key {false};
+    };
+
+    std::string                                     maze_name;
+    std::uint32_t                                   maze_fingerprint {0};   // See the maze_layout::get_fingerprint().
+    std::string                                     game_owner;
+    long                                            game_speed {0};
+    unsigned long                                   ticks {0};
+
+    std::vector<coords_t>                           keys;
+    std::vector<coords_t>                           gates_open;
+    std::vector<coords_t>                           guardians;
+    std::array<player_state, GAME_MAX_PLAYERS>      players;
+  };
+}
+
+/* ****************************************************************************************************************** *
+ * ***[ END OF MAZED_GAME_SNAPSHOT.HH ]****************************************************************************** *
+ * ****************************************************************************************************************** */
+
+#endif
@@ -0,0 +1,299 @@
+/**
+ * @file      mazed_games_registry.cc
+ * @author    Dee'Kej (David Kaspar - xkaspa34)
+ * @version   0.1
+ * @brief     Contains implementations of class member functions of mazed::games_registry.
+ */
+
+
+/* ****************************************************************************************************************** *
+ * ***[ START OF MAZED_GAMES_REGISTRY.CC ]*************************************************************************** *
+ * ****************************************************************************************************************** */
+
+
+/* ****************************************************************************************************************** *
+ ~ ~~~[ HEADER FILES ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ ~
+ * ****************************************************************************************************************** */
+
+#include "mazed_games_registry.hh"
+
+
+/* ****************************************************************************************************************** *
+ ~ ~~~[ MEMBER FUNCTIONS IMPLEMENTATIONS ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ ~
+ * ****************************************************************************************************************** */
+
+namespace mazed {
+
+  /**
+   * @param[in]   shards_num  Number of the shards, at least 1.
+   */
+  games_registry::games_registry(unsigned shards_num) : shards_((shards_num > 0) ? shards_num : 1)
+  {{{
+    std::vector<shard>::iterator it_shard;
+
+    for (it_shard = shards_.begin(); it_shard != shards_.end(); it_shard++) {
+      (*it_shard).ps_games = std::make_shared<const games_table>();
+    }
+
+    return;
+  }}}
+
+
+  games_registry::~games_registry()
+  {{{
+    return;
+  }}}
+
+  // // // // // // // // // // //
+
+  /**
+   * Registers the game, it's listed as the PAUSED game.
+   *
+   * @param[in]   ps_instance   Instance of the game, it's owned by the registry until it's removed.
+   * @param[in]   maze_name     Name of the game's maze.
+   * @param[in]   players       Nicks of the players already in the game.
+   * @return      UID of the game, which is its handle for the registry.
+   */
+  std::string games_registry::add(const std::shared_ptr<game::instance> &ps_instance, const std::string &maze_name,
+                                  const std::vector<std::string> &players)
+  {{{
+    std::shared_ptr<protocol::game_info> ps_info = std::make_shared<protocol::game_info>();
+    entry game;
+
+    game.uid = ++last_UID_;
+    game.ps_info = ps_info;
+    game.ps_instance = ps_instance;
+
+    ps_info->UID = "G" + std::to_string(game.uid);
+    ps_info->used_slots = players.size();
+    ps_info->status = protocol::E_game_status::PAUSED;
+    ps_info->maze_name = maze_name;
+    ps_info->players = players;
+
+    shard &games_shard = shards_[game.uid % shards_.size()];
+
+    games_shard.writers_mutex.lock();
+    {
+      games_shard.games_num++;
+      publish(games_shard, game, false);
+    }
+    games_shard.writers_mutex.unlock();
+
+    return ps_info->UID;
+  }}}
+
+
+  /**
+   * Removes the game from the registry, the readers which have loaded the registry before can still see it.
+   *
+   * @return  Instance of the game removed | nullptr if there was no such game. The instance is released by the caller,
+   *          so it's never destroyed while the shard is locked.
+   */
+  std::shared_ptr<game::instance> games_registry::remove(const std::string &uid)
+  {{{
+    unsigned long num = uid_number(uid);
+    shard &games_shard = shards_[num % shards_.size()];
+
+    std::shared_ptr<const games_table> ps_old;
+    std::shared_ptr<game::instance> ps_instance;
+
+    games_shard.writers_mutex.lock();
+    {
+      ps_old = std::atomic_load(&games_shard.ps_games);
+      std::size_t slot = slot_find(*ps_old, num);
+
+      if (slot < ps_old->size() && (*ps_old)[slot].uid != 0) {
+        ps_instance = (*ps_old)[slot].ps_instance;
+        games_shard.games_num--;
+        publish(games_shard, (*ps_old)[slot], true);
+      }
+    }
+    games_shard.writers_mutex.unlock();
+
+    return ps_instance;
+  }}}
+
+  // // // // // // // // // // //
+
+  /**
+   * Replaces the players (nicks) of the game listed, unknown games are ignored.
+   */
+  void games_registry::set_players(const std::string &uid, const std::vector<std::string> &players)
+  {{{
+    unsigned long num = uid_number(uid);
+    shard &games_shard = shards_[num % shards_.size()];
+
+    games_shard.writers_mutex.lock();
+    {
+      std::shared_ptr<const games_table> ps_old = std::atomic_load(&games_shard.ps_games);
+      std::size_t slot = slot_find(*ps_old, num);
+
+      if (slot < ps_old->size() && (*ps_old)[slot].uid != 0) {
+        entry game = (*ps_old)[slot];
+        std::shared_ptr<protocol::game_info> ps_info = std::make_shared<protocol::game_info>(*game.ps_info);
+
+        ps_info->players = players;
+        ps_info->used_slots = players.size();
+        game.ps_info = ps_info;
+        publish(games_shard, game, false);
+      }
+    }
+    games_shard.writers_mutex.unlock();
+
+    return;
+  }}}
+
+
+  /**
+   * Replaces the status of the game listed, unknown games are ignored.
+   */
+  void games_registry::set_status(const std::string &uid, protocol::E_game_status status)
+  {{{
+    unsigned long num = uid_number(uid);
+    shard &games_shard = shards_[num % shards_.size()];
+
+    games_shard.writers_mutex.lock();
+    {
+      std::shared_ptr<const games_table> ps_old = std::atomic_load(&games_shard.ps_games);
+      std::size_t slot = slot_find(*ps_old, num);
+
+      if (slot < ps_old->size() && (*ps_old)[slot].uid != 0 && (*ps_old)[slot].ps_info->status != status) {
+        entry game = (*ps_old)[slot];
+        std::shared_ptr<protocol::game_info> ps_info = std::make_shared<protocol::game_info>(*game.ps_info);
+
+        ps_info->status = status;
+        game.ps_info = ps_info;
+        publish(games_shard, game, false);
+      }
+    }
+    games_shard.writers_mutex.unlock();
+
+    return;
+  }}}
+
+
+  /**
+   * Rebuilds the table of the shard with the changed game (either added/replaced or removed) and publishes it. The
+   * table is sized to the games_num of the shard, which has to be updated already. Expects the shard to be locked.
+   */
+  void games_registry::publish(shard &games_shard, const entry &changed, bool removed)
+  {{{
+    std::shared_ptr<const games_table> ps_old = std::atomic_load(&games_shard.ps_games);
+    std::size_t capacity = GAMES_TABLE_MIN;
+
+    while (capacity < 2 * games_shard.games_num) {
+      capacity *= 2;                                // The table is at most half full, the probing stays short.
+    }
+
+    std::shared_ptr<games_table> ps_games = std::make_shared<games_table>(capacity);
+    games_table::const_iterator it_game;
+
+    for (it_game = ps_old->begin(); it_game != ps_old->end(); it_game++) {
+      if ((*it_game).uid != 0 && (*it_game).uid != changed.uid) {
+        (*ps_games)[slot_find(*ps_games, (*it_game).uid)] = *it_game;
+      }
+    }
+
+    if (removed == false) {
+      (*ps_games)[slot_find(*ps_games, changed.uid)] = changed;
+    }
+
+    std::atomic_store(&games_shard.ps_games, std::shared_ptr<const games_table>(ps_games));
+
+    return;
+  }}}
+
+  // // // // // // // // // // //
+
+  /**
+   * @return  Slot of the game with the given UID | the empty slot where it would be placed | size of the table if the
+   *          table is empty.
+   */
+  std::size_t games_registry::slot_find(const games_table &games, unsigned long uid) const
+  {{{
+    if (games.empty() == true) {
+      return 0;
+    }
+
+    std::size_t mask = games.size() - 1;            // The size is always the power of 2.
+    std::size_t slot = ((uid / shards_.size()) * 0x9E3779B97F4A7C15UL) & mask;
+
+    while (games[slot].uid != 0 && games[slot].uid != uid) {
+      slot = (slot + 1) & mask;
+    }
+
+    return slot;
+  }}}
+
+
+  /**
+   * @return  Number of the textual UID of the game ("G<number>") | 0 if it's not valid.
+   */
+  unsigned long games_registry::uid_number(const std::string &uid)
+  {{{
+    if (uid.size() < 2 || uid.size() > 20 || uid[0] != 'G') {
+      return 0;
+    }
+
+    unsigned long num = 0;
+    std::string::const_iterator it_char;
+
+    for (it_char = uid.begin() + 1; it_char != uid.end(); it_char++) {
+      if (*it_char < '0' || *it_char > '9') {
+        return 0;
+      }
+
+      num = num * 10 + (*it_char - '0');
+    }
+
+    return num;
+  }}}
+
+  // // // // // // // // // // //
+
+  /**
+   * @return  Actual snapshots of the tables of all the shards, which are never changed. The empty slots of the tables
+   *          have the UID 0. The shards are loaded one after another, so the snapshot isn't atomic as a whole.
+   */
+  games_registry::games_snapshot games_registry::get_games() const
+  {{{
+    games_snapshot games;
+    std::vector<shard>::const_iterator it_shard;
+
+    games.reserve(shards_.size());
+
+    for (it_shard = shards_.begin(); it_shard != shards_.end(); it_shard++) {
+      games.push_back(std::atomic_load(&(*it_shard).ps_games));
+    }
+
+    return games;
+  }}}
+
+
+  /**
+   * @return  Instance of the game with the given UID | nullptr if there's no such game running.
+   */
+  std::shared_ptr<game::instance> games_registry::find(const std::string &uid) const
+  {{{
+    unsigned long num = uid_number(uid);
+    std::shared_ptr<const games_table> ps_games = std::atomic_load(&shards_[num % shards_.size()].ps_games);
+    std::size_t slot = slot_find(*ps_games, num);
+
+    if (num == 0 || slot >= ps_games->size() || (*ps_games)[slot].uid == 0) {
+      return nullptr;
+    }
+
+    return (*ps_games)[slot].ps_instance;
+  }}}
+
+
+  std::size_t games_registry::get_shards_num() const
+  {{{
+    return shards_.size();
+  }}}
+}
+
+/* ****************************************************************************************************************** *
+ * ***[ END OF MAZED_GAMES_REGISTRY.CC ]***************************************************************************** *
+ * ****************************************************************************************************************** */
+
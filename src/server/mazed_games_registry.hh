@@ -0,0 +1,104 @@
+/**
+ * @file      mazed_games_registry.hh
+ * @author    Dee'Kej (David Kaspar - xkaspa34)
+ * @version   0.1
+ * @brief     Contains declaration of the sharded registry of the running games, which is read without locking.
+ */
+
+
+/* ****************************************************************************************************************** *
+ * ***[ START OF MAZED_GAMES_REGISTRY.HH ]*************************************************************************** *
+ * ****************************************************************************************************************** */
+
+#ifndef H_GUARD_MAZED_GAMES_REGISTRY_HH
+#define H_GUARD_MAZED_GAMES_REGISTRY_HH
+
+
+/* ****************************************************************************************************************** *
+ ~ ~~~[ HEADER FILES ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ ~
+ * ****************************************************************************************************************** */
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <boost/thread.hpp>
+
+#include "../protocol.hh"
+
+
+/* ****************************************************************************************************************** *
+ ~ ~~~[ GAMES_REGISTRY CLASS ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ ~
+ * ****************************************************************************************************************** */
+
+namespace game {
+  class instance;
+}
+
+namespace mazed {
+
+  #define GAMES_SHARDS          16U         // Default number of the registry's shards, see the bench_registry.
+  #define GAMES_TABLE_MIN       16U         // Minimal size of the table of the games, has to be the power of 2.
+
+  /**
+   * Registry of the running games keyed by their UIDs, it owns the instances of the games. The registry is split into
+   * the shards by the UID, every shard is copy-on-write: every change copies the table of the shard's games, changes
+   * the copy and publishes it atomically. The readers (LIST_RUNNING, JOIN_GAME) only load the published tables, so
+   * they never wait for the creating or terminating of the games, nor each other. The writers are serialized only by
+   * the mutex of the shard changed, which is never held while calling anything else. The UIDs are given round-robin,
+   * so the games being created & terminated at once are spread over all the shards.
+   *
+   * The table is a flat open-addressing hash table rebuilt upon every copy, so the copy is one allocation and the UID
+   * is looked up in O(1). The game_info of every game is an immutable snapshot as well, it's replaced upon the change
+   * of the game's players or status.
+   */
+  class games_registry {
+    public:
+      struct entry {
+        unsigned long                               uid {0};        // 0 for the empty slot.
+        std::shared_ptr<const protocol::game_info>  ps_info;
+        std::shared_ptr<game::instance>             ps_instance;
+      };
+
+      using games_table = std::vector<entry>;
+      using games_snapshot = std::vector<std::shared_ptr<const games_table>>;
+
+    private:
+      struct shard {
+        boost::mutex                                writers_mutex;
+        std::shared_ptr<const games_table>          ps_games;       // Accessed by the std::atomic_*() only.
+        std::size_t                                 games_num {0};
+      };
+
+      std::vector<shard>                            shards_;        // Never resized, the shards aren't movable.
+      std::atomic<unsigned long>                    last_UID_ {0};
+
+      // // // // // // // // // // //
+
+      void publish(shard &games_shard, const entry &changed, bool removed);
+      std::size_t slot_find(const games_table &games, unsigned long uid) const;
+      static unsigned long uid_number(const std::string &uid);
+
+    public:
+      games_registry(unsigned shards_num = GAMES_SHARDS);
+     ~games_registry();
+
+      std::string add(const std::shared_ptr<game::instance> &ps_instance, const std::string &maze_name,
+                      const std::vector<std::string> &players);
+      std::shared_ptr<game::instance> remove(const std::string &uid);
+
+      void set_players(const std::string &uid, const std::vector<std::string> &players);
+      void set_status(const std::string &uid, protocol::E_game_status status);
+
+      games_snapshot get_games() const;
+      std::shared_ptr<game::instance> find(const std::string &uid) const;
+      std::size_t get_shards_num() const;
+  };
+}
+
+/* ****************************************************************************************************************** *
+ * ***[ END OF MAZED_GAMES_REGISTRY.HH ]***************************************************************************** *
+ * ****************************************************************************************************************** */
+
+#endif
@@ -42,6 +42,9 @@ namespace mazed {
     MAX_PING,
     SERVER_PORT,
     LOGGING_LEVEL,
+    IO_THREADS,
+    GAME_THREADS,
+    UPDATES_PACING,
   };
 
   enum class log_level : unsigned char {
@@ -63,7 +66,10 @@ namespace mazed {
     long,                               // SLEEP_INTERVAL
     long,                               // MAX_PING
     unsigned short,                     // SERVER_PORT
-    log_level                           // LOGGING
+    log_level,                          // LOGGING
+    unsigned,                           // IO_THREADS
+    unsigned,                           // GAME_THREADS
+    unsigned                            // UPDATES_PACING
   >;
  
   namespace exit_codes {
@@ -71,6 +71,9 @@ void process_params(int argc, char *argv[])
 
   unsigned char logging;
   int           port;
+  int           io_threads;
+  int           game_threads;
+  int           pacing;
   long          sleep;
   long          timeout;
   std::string   players_dir;
@@ -116,6 +119,15 @@ void process_params(int argc, char *argv[])
     help.add_options() ("saves-ext", params::value<std::string>(&saves_ext)->default_value(".save"),
                         "extension of saved mazes (default: *.save)");
 
+    help.add_options() ("io-threads", params::value<int>(&io_threads)->default_value(0),
+                        "threads of shared acceptor pool, 0 for thread per connection (default: 0)");
+
+    help.add_options() ("game-threads", params::value<int>(&game_threads)->default_value(2),
+                        "threads executing the ticks of all games (default: 2)");
+
+    help.add_options() ("pacing", params::value<int>(&pacing)->default_value(0),
+                        "% of the tick to spread the game updates over, 0 to disable (default: 0)");
+
     params::variables_map var_map;
     params::store(params::parse_command_line(argc, argv, help), var_map);
     params::notify(var_map);
@@ -143,6 +155,24 @@ void process_params(int argc, char *argv[])
       exit(mazed::exit_codes::E_WRONG_PARAMS);
     }
 
+    if (var_map["io-threads"].as<int>() < 0) {
+      std::cerr << process_name << ": Error: the argument ('" << var_map["io-threads"].as<int>();
+      std::cerr << "') for option '--io-threads' is invalid" << std::endl;
+      exit(mazed::exit_codes::E_WRONG_PARAMS);
+    }
+
+    if (var_map["game-threads"].as<int>() < 1) {
+      std::cerr << process_name << ": Error: the argument ('" << var_map["game-threads"].as<int>();
+      std::cerr << "') for option '--game-threads' is invalid" << std::endl;
+      exit(mazed::exit_codes::E_WRONG_PARAMS);
+    }
+
+    if (var_map["pacing"].as<int>() < 0 || var_map["pacing"].as<int>() > 100) {
+      std::cerr << process_name << ": Error: the argument ('" << var_map["pacing"].as<int>();
+      std::cerr << "') for option '--pacing' is invalid" << std::endl;
+      exit(mazed::exit_codes::E_WRONG_PARAMS);
+    }
+
     std::get<mazed::PLAYERS_FOLDER>(SETTINGS) = players_dir;
     std::get<mazed::SAVES_FOLDER>(SETTINGS) = saves_dir;
     std::get<mazed::SAVES_EXTENSION>(SETTINGS) = saves_ext;
@@ -153,6 +183,9 @@ void process_params(int argc, char *argv[])
     std::get<mazed::SLEEP_INTERVAL>(SETTINGS) = sleep;
     std::get<mazed::MAX_PING>(SETTINGS) = timeout;
     std::get<mazed::SERVER_PORT>(SETTINGS) = port;
+    std::get<mazed::IO_THREADS>(SETTINGS) = io_threads;
+    std::get<mazed::GAME_THREADS>(SETTINGS) = game_threads;
+    std::get<mazed::UPDATES_PACING>(SETTINGS) = pacing;
     std::get<mazed::LOGGING_LEVEL>(SETTINGS) = mazed::log_level::NONE;       // Avoiding too-early logging.
     LOGGING_LEVEL = static_cast<mazed::log_level>(logging - '0');
 
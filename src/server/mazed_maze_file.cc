@@ -0,0 +1,481 @@
+/**
+ * @file      mazed_maze_file.cc
+ * @author    Dee'Kej (David Kaspar - xkaspa34)
+ * @version   0.1
+ * @brief     Contains implementations of the readers & writer of the maze files.
+ */
+
+
+/* ****************************************************************************************************************** *
+ * ***[ START OF MAZED_MAZE_FILE.CC ]******************************************************************************** *
+ * ****************************************************************************************************************** */
+
+
+/* ****************************************************************************************************************** *
+ ~ ~~~[ HEADER FILES ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ ~
+ * ****************************************************************************************************************** */
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <boost/algorithm/string.hpp>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "mazed_maze_file.hh"
+
+
+/* ****************************************************************************************************************** *
+ ~ ~~~[ MEMBER FUNCTIONS IMPLEMENTATIONS ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ ~
+ * ****************************************************************************************************************** */
+
+namespace mazed {
+
+  /**
+   * Parses and validates the opened text maze file.
+   *
+   * @return  Parsed layout of the maze | NULL if the maze file is not valid.
+   */
+  game::maze_layout *maze_file::parse(std::istream &maze_file)
+  {{{
+    try {
+      std::string input, version;
+      std::vector<std::string> input_tokens;
+      std::size_t rows, cols;
+      std::stringstream maze_scheme;
+
+      game::maze_layout *p_layout = NULL;
+
+
+      std::getline(maze_file, input);
+
+      if (maze_file.good() != true) {
+        return NULL;
+      }
+
+      boost::split(input_tokens, input, boost::is_any_of("="));
+      
+      if (input_tokens.size() != 2 || input_tokens[0] != "version") {
+        return NULL;
+      }
+
+      version = input_tokens[1];
+      std::getline(maze_file, input);
+      
+      if (maze_file.good() != true) {
+        return NULL;
+      }
+
+      boost::split(input_tokens, input, boost::is_any_of("=xX"));
+
+      if (input_tokens.size() != 3 || input_tokens[0] != "size") {
+        return NULL;
+      }
+      
+      rows = std::stoul(input_tokens[1], nullptr, 0);
+      cols = std::stoul(input_tokens[2], nullptr, 0);
+
+      if (rows < MAZE_MIN_SIZE || rows > MAZE_MAX_SIZE || cols < MAZE_MIN_SIZE || cols > MAZE_MAX_SIZE) {
+        return NULL;
+      }
+
+      std::getline(maze_file, input);             // Skipping the line delimiter.
+
+      if (maze_file.good() != true) {
+        return NULL;
+      }
+      
+      
+      for (std::size_t i = 0; i < rows; i++) {
+        std::getline(maze_file, input);
+
+        if (maze_file.good() != true || input.size() != (cols * 2 - 1)) {
+          return NULL;
+        }
+
+        maze_scheme << input << "\n";
+      }
+
+
+      input = maze_scheme.str();
+      p_layout = new game::maze_layout(static_cast<signed char>(rows), static_cast<signed char>(cols));
+      
+      std::size_t linear_pos {0};
+
+      for (std::size_t i = 0; i < rows; i++) {
+        for (std::size_t j = 0; j < cols; j++) {
+
+          linear_pos = (i * cols * 2) + (j * 2);
+
+          switch (input[linear_pos]) {
+            case ' ' :
+              p_layout->block_set(i, j, game::block::EMPTY);
+              break;
+
+            case 'X' :
+              p_layout->block_set(i, j, game::block::WALL);
+              break;
+
+            case '~' :
+              p_layout->block_set(i, j, game::block::GATE_CLOSED);
+              break;
+
+            case '*' :
+              p_layout->block_set(i, j, game::block::KEY);
+              input[linear_pos] = ' ';
+              break;
+
+            case 'G' :
+              p_layout->block_set(i, j, game::block::TARGET);
+              break;
+            
+            case '1' :
+              p_layout->players_start_coords_[0].first = i;
+              p_layout->players_start_coords_[0].second = j;
+              input[linear_pos] = ' ';
+              break;
+              
+            case '2' :
+              p_layout->players_start_coords_[1].first = i;
+              p_layout->players_start_coords_[1].second = j;
+              input[linear_pos] = ' ';
+              break;
+              
+            case '3' :
+              p_layout->players_start_coords_[2].first = i;
+              p_layout->players_start_coords_[2].second = j;
+              input[linear_pos] = ' ';
+              break;
+              
+            case '4' :
+              p_layout->players_start_coords_[3].first = i;
+              p_layout->players_start_coords_[3].second = j;
+              input[linear_pos] = ' ';
+              break;
+              
+            case '@' :
+              p_layout->guardians_.emplace_back(i, j);
+              input[linear_pos] = ' ';
+              break;
+
+            default :
+              delete p_layout;
+              return NULL;
+          }
+        }
+      }
+
+      p_layout->slides_.build();
+      p_layout->analyse();
+
+      p_layout->version_ = version;
+      p_layout->scheme_ = input;
+      p_layout->scheme_.back() = ' ';
+      p_layout->fingerprint_ = fingerprint(*p_layout);
+
+      return p_layout;
+    }
+    catch (const std::exception &) {
+      return NULL;
+    }
+  }}}
+
+  // // // // // // // // // // // //
+
+  /**
+   * Writes the layout as the compiled maze. The file is written aside first and renamed then, so the server never
+   * maps the half-written maze.
+   *
+   * @return  true if the compiled maze was written, false otherwise.
+   */
+  bool maze_file::compile(const game::maze_layout &layout, const std::string &path)
+  {{{
+    std::size_t cells = layout.dimensions_.first * layout.dimensions_.second;
+
+    if (layout.scheme_.size() != cells * 2 || layout.version_.size() > 0xFFFF || layout.gates_.size() > 0xFFFF ||
+        layout.keys_.size() > 0xFFFF || layout.guardians_.size() > 0xFFFF) {
+      return false;
+    }
+
+    std::vector<unsigned char> payload;
+    std::vector<std::pair<signed char, signed char>>::const_iterator it_coords;
+
+    payload.reserve(layout.version_.size() + cells * 7 + GAME_MAX_PLAYERS * 2 +
+                    (layout.gates_.size() + layout.keys_.size() + layout.guardians_.size()) * 2);
+
+    payload.insert(payload.end(), layout.version_.begin(), layout.version_.end());
+    payload.insert(payload.end(), layout.scheme_.begin(), layout.scheme_.end());
+
+    for (std::size_t i = 0; i < cells; i++) {
+      payload.push_back(layout.blocks_[i].get());
+    }
+
+    for (unsigned i = 0; i < GAME_MAX_PLAYERS; i++) {
+      payload.push_back(layout.players_start_coords_[i].first);
+      payload.push_back(layout.players_start_coords_[i].second);
+    }
+
+    const std::vector<std::pair<signed char, signed char>> *lists[] = {&layout.gates_, &layout.keys_,
+                                                                        &layout.guardians_};
+
+    for (unsigned i = 0; i < sizeof(lists) / sizeof(lists[0]); i++) {
+      for (it_coords = lists[i]->begin(); it_coords != lists[i]->end(); it_coords++) {
+        payload.push_back((*it_coords).first);
+        payload.push_back((*it_coords).second);
+      }
+    }
+
+    payload.insert(payload.end(), layout.slides_.data(), layout.slides_.data() + cells * 4);
+
+    compiled_header header;
+
+    std::memcpy(header.magic, "MAZC", sizeof(header.magic));
+    header.format = MAZEC_FORMAT;
+    header.checksum = checksum(payload.data(), payload.size());
+    header.rows = layout.dimensions_.first;
+    header.cols = layout.dimensions_.second;
+    header.version_length = layout.version_.size();
+    header.gates_num = layout.gates_.size();
+    header.keys_num = layout.keys_.size();
+    header.guardians_num = layout.guardians_.size();
+    header.reserved = 0;
+
+    std::string tmp_path = path + ".tmp";
+    std::ofstream output(tmp_path, std::ios::binary | std::ios::trunc);
+
+    output.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    output.write(reinterpret_cast<const char *>(payload.data()), payload.size());
+    output.close();
+
+    if (output.fail() == true || std::rename(tmp_path.c_str(), path.c_str()) != 0) {
+      std::remove(tmp_path.c_str());
+      return false;
+    }
+
+    return true;
+  }}}
+
+
+  /**
+   * Maps the compiled maze into the memory and creates the layout of it.
+   *
+   * @param[in]   path      Path to the compiled maze, relative paths are relative to the dir_fd.
+   * @param[in]   dir_fd    Opened folder, or AT_FDCWD for the working directory.
+   * @return      Layout of the maze | NULL if the file doesn't exist or it's not valid compiled maze.
+   */
+  game::maze_layout *maze_file::load_compiled(const std::string &path, int dir_fd)
+  {{{
+    int fd = openat(dir_fd, path.c_str(), O_RDONLY | O_CLOEXEC);
+
+    if (fd < 0) {
+      return NULL;
+    }
+
+    struct stat file_stat;
+
+    if (fstat(fd, &file_stat) != 0 || file_stat.st_size < static_cast<off_t>(sizeof(compiled_header))) {
+      close(fd);
+      return NULL;
+    }
+
+    void *p_mapped = mmap(NULL, file_stat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+
+    if (p_mapped == MAP_FAILED) {
+      return NULL;
+    }
+
+    game::maze_layout *p_layout = NULL;
+
+    try {
+      p_layout = decode(static_cast<const unsigned char *>(p_mapped), file_stat.st_size);
+    }
+    catch (const std::exception &) {
+      p_layout = NULL;
+    }
+
+    munmap(p_mapped, file_stat.st_size);
+    return p_layout;
+  }}}
+
+  // // // // // // // // // // // //
+
+  /**
+   * FNV-1a hash, it's good enough for detecting damaged or truncated files.
+   */
+  std::uint32_t maze_file::checksum(const unsigned char *data, std::size_t length)
+  {{{
+    std::uint32_t hash {2166136261U};
+
+    for (std::size_t i = 0; i < length; i++) {
+      hash ^= data[i];
+      hash *= 16777619U;
+    }
+
+    return hash;
+  }}}
+
+
+  /**
+   * @return  Checksum of the layout's content - the version, the scheme and the positions of the keys, the guardians &
+   *          the players, so it's the same for the text & compiled maze, and it changes upon every change of the maze.
+   */
+  std::uint32_t maze_file::fingerprint(const game::maze_layout &layout)
+  {{{
+    std::vector<unsigned char> content(layout.version_.begin(), layout.version_.end());
+
+    content.insert(content.end(), layout.scheme_.begin(), layout.scheme_.end());
+
+    const std::vector<std::pair<signed char, signed char>> *lists[] = {&layout.keys_, &layout.guardians_};
+    std::vector<std::pair<signed char, signed char>>::const_iterator it_coords;
+
+    for (unsigned i = 0; i < sizeof(lists) / sizeof(lists[0]); i++) {
+      for (it_coords = lists[i]->begin(); it_coords != lists[i]->end(); it_coords++) {
+        content.push_back((*it_coords).first);
+        content.push_back((*it_coords).second);
+      }
+    }
+
+    for (unsigned i = 0; i < GAME_MAX_PLAYERS; i++) {
+      content.push_back(layout.players_start_coords_[i].first);
+      content.push_back(layout.players_start_coords_[i].second);
+    }
+
+    return checksum(content.data(), content.size());
+  }}}
+
+
+  /**
+   * Creates the layout from the mapped compiled maze. The coordinates & blocks are checked to be within the maze and
+   * the slide table is built from the blocks, the stored slide table is only compared with it. So the layout is safe
+   * to use even if the file wasn't written by the compile().
+   */
+  game::maze_layout *maze_file::decode(const unsigned char *data, std::size_t length)
+  {{{
+    compiled_header header;
+    std::memcpy(&header, data, sizeof(header));
+
+    if (std::memcmp(header.magic, "MAZC", sizeof(header.magic)) != 0 || header.format != MAZEC_FORMAT) {
+      return NULL;
+    }
+
+    if (header.rows < MAZE_MIN_SIZE || header.rows > MAZE_MAX_SIZE || header.cols < MAZE_MIN_SIZE ||
+        header.cols > MAZE_MAX_SIZE) {
+      return NULL;
+    }
+
+    signed char rows = header.rows;
+    signed char cols = header.cols;
+    std::size_t cells = rows * cols;
+    std::size_t coords_num = header.gates_num + header.keys_num + header.guardians_num;
+
+    if (length != sizeof(header) + header.version_length + cells * 7 + (GAME_MAX_PLAYERS + coords_num) * 2) {
+      return NULL;
+    }
+
+    const unsigned char *p_data = data + sizeof(header);
+
+    if (checksum(p_data, length - sizeof(header)) != header.checksum) {
+      return NULL;
+    }
+
+    std::unique_ptr<game::maze_layout> pu_layout(new game::maze_layout(rows, cols));
+
+    pu_layout->version_.assign(reinterpret_cast<const char *>(p_data), header.version_length);
+    p_data += header.version_length;
+
+    pu_layout->scheme_.assign(reinterpret_cast<const char *>(p_data), cells * 2);
+    p_data += cells * 2;
+
+    for (signed char row = 0; row < rows; row++) {
+      for (signed char col = 0; col < cols; col++, p_data++) {
+        switch (*p_data) {
+          case game::block::WALL :
+            pu_layout->bb_walls_.set(row, col);
+            pu_layout->bb_blocked_.set(row, col);
+            pu_layout->slides_.set_blocked(row, col, true);
+            break;
+
+          case game::block::GATE_CLOSED :
+            pu_layout->bb_blocked_.set(row, col);
+            pu_layout->slides_.set_blocked(row, col, true);
+            break;
+
+          case game::block::TARGET :
+            pu_layout->bb_targets_.set(row, col);
+            break;
+
+          case game::block::EMPTY :
+            break;
+
+          default :
+            return NULL;
+        }
+
+        pu_layout->blocks_[row * cols + col].set(static_cast<game::block::E_block_type>(*p_data));
+      }
+    }
+
+    std::pair<signed char, signed char> coords;
+
+    for (std::size_t i = 0; i < GAME_MAX_PLAYERS + coords_num; i++, p_data += 2) {
+      coords.first = p_data[0];
+      coords.second = p_data[1];
+
+      if (coords.first < 0 || coords.first >= rows || coords.second < 0 || coords.second >= cols) {
+        return NULL;
+      }
+
+      game::block::E_block_type type = pu_layout->blocks_[coords.first * cols + coords.second].get();
+
+      if (i < GAME_MAX_PLAYERS) {
+        pu_layout->players_start_coords_[i] = coords;
+      }
+      else if (i < GAME_MAX_PLAYERS + header.gates_num) {
+        if (type != game::block::GATE_CLOSED) {
+          return NULL;
+        }
+
+        pu_layout->gates_.push_back(coords);
+      }
+      else if (i < GAME_MAX_PLAYERS + header.gates_num + header.keys_num) {
+        if (type != game::block::EMPTY) {
+          return NULL;
+        }
+
+        pu_layout->keys_.push_back(coords);
+        pu_layout->bb_keys_.set(coords.first, coords.second);
+        pu_layout->bb_blocked_.set(coords.first, coords.second);
+        pu_layout->slides_.set_blocked(coords.first, coords.second, true);
+      }
+      else {
+        pu_layout->guardians_.push_back(coords);
+      }
+    }
+
+    // The slide table is built from the decoded blocks, the stored one has to match it:
+    pu_layout->slides_.build();
+
+    if (std::memcmp(pu_layout->slides_.data(), p_data, cells * 4) != 0) {
+      return NULL;
+    }
+
+    pu_layout->analyse();
+    pu_layout->fingerprint_ = fingerprint(*pu_layout);
+
+    return pu_layout.release();
+  }}}
+}
+
+/* ****************************************************************************************************************** *
+ * ***[ END OF MAZED_MAZE_FILE.CC ]********************************************************************************** *
+ * ****************************************************************************************************************** */
+
@@ -0,0 +1,79 @@
+/**
+ * @file      mazed_maze_file.hh
+ * @author    Dee'Kej (David Kaspar - xkaspa34)
+ * @version   0.1
+ * @brief     Contains declaration of the readers & writer of the maze files, both the text and the compiled one.
+ */
+
+
+/* ****************************************************************************************************************** *
+ * ***[ START OF MAZED_MAZE_FILE.HH ]******************************************************************************** *
+ * ****************************************************************************************************************** */
+
+#ifndef H_GUARD_MAZED_MAZE_FILE_HH
+#define H_GUARD_MAZED_MAZE_FILE_HH
+
+
+/* ****************************************************************************************************************** *
+ ~ ~~~[ HEADER FILES ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ ~
+ * ****************************************************************************************************************** */
+
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <string>
+
+#include <fcntl.h>
+
+#include "mazed_game_maze_layout.hh"
+
+
+/* ****************************************************************************************************************** *
+ ~ ~~~[ MAZE_FILE CLASS ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ ~
+ * ****************************************************************************************************************** */
+
+namespace mazed {
+
+  #define MAZEC_SUFFIX          "c"         // Compiled maze is named as the text one plus this suffix, e.g. *.mazec.
+  #define MAZEC_FORMAT          1U          // Version of the compiled format, not of the maze.
+
+  /**
+   * Reading of the text maze files and writing & reading of the compiled ones. The compiled maze holds the validated
+   * blocks, the lists of gates, keys, starting coordinates & guardians and the slide table in the binary form with a
+   * checksum, so it's loaded by mmap() without any parsing. It's written in the native byte order, the compiled maze
+   * of different byte order is refused (as any other invalid one) and the text maze is used instead.
+   */
+  class maze_file {
+      // Header of the compiled maze, followed by the sections in this order: version string, scheme, blocks, players'
+      // starting coordinates, gates, keys, guardians, slide table. Coordinates are stored as 2 bytes (row, column).
+      struct compiled_header {
+        char                                        magic[4];
+        std::uint32_t                               format;
+        std::uint32_t                               checksum;       // FNV-1a of everything behind the header.
+        std::uint8_t                                rows;
+        std::uint8_t                                cols;
+        std::uint16_t                               version_length;
+        std::uint16_t                               gates_num;
+        std::uint16_t                               keys_num;
+        std::uint16_t                               guardians_num;
+        std::uint16_t                               reserved;
+      };
+
+      static std::uint32_t fingerprint(const game::maze_layout &layout);
+      static game::maze_layout *decode(const unsigned char *data, std::size_t length);
+
+    public:
+      static std::uint32_t checksum(const unsigned char *data, std::size_t length);
+
+      static game::maze_layout *parse(std::istream &maze_file);
+
+      static bool compile(const game::maze_layout &layout, const std::string &path);
+      static game::maze_layout *load_compiled(const std::string &path, int dir_fd = AT_FDCWD);
+  };
+}
+
+/* ****************************************************************************************************************** *
+ * ***[ END OF MAZED_MAZE_FILE.HH ]********************************************************************************** *
+ * ****************************************************************************************************************** */
+
+#endif
@@ -15,16 +15,20 @@
  ~ ~~~[ HEADER FILES ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ ~
  * ****************************************************************************************************************** */
 
-#include <fstream>
-#include <list>
+#include <cerrno>
 #include <sstream>
 #include <string>
 #include <tuple>
 #include <vector>
 
-#include <boost/algorithm/string.hpp>
+#include <boost/bind.hpp>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 #include "mazed_mazes_manager.hh"
+#include "mazed_save_file.hh"
 
 
 /* ****************************************************************************************************************** *
@@ -39,6 +43,26 @@ namespace mazed {
     mazes_extension_{std::get<MAZES_EXTENSION>(settings)}, saves_extension_{std::get<SAVES_EXTENSION>(settings)},
     mazes_dir_path_(std::get<MAZES_FOLDER>(settings)), saves_dir_path_(std::get<SAVES_FOLDER>(settings)),
     daemon_dir_path_{std::get<DAEMON_FOLDER>(settings)}
+  {{{
+    // Relative paths are relative to the daemon's folder:
+    if (mazes_dir_path_.is_relative() == true) {
+      mazes_dir_path_ = daemon_dir_path_ / mazes_dir_path_;
+    }
+
+    if (saves_dir_path_.is_relative() == true) {
+      saves_dir_path_ = daemon_dir_path_ / saves_dir_path_;
+    }
+
+    pu_mazes_index_ = std::unique_ptr<directory_index>(new directory_index(mazes_dir_path_, mazes_extension_));
+    pu_saves_index_ = std::unique_ptr<directory_index>(new directory_index(saves_dir_path_, saves_extension_));
+
+    pu_mazes_index_->on_change(boost::bind(&mazes_manager::templates_changed, this, _1));
+
+    return;
+  }}}
+
+
+  mazes_manager::~mazes_manager()
   {{{
     return;
   }}}
@@ -47,221 +71,464 @@ namespace mazed {
 
   std::vector<std::string> mazes_manager::list_mazes()
   {{{
-    try {
-      filesys::current_path(daemon_dir_path_);
-      return list_directory(mazes_dir_path_, mazes_extension_);
-    }
-    catch (filesys::filesystem_error) {
-      return {};
-    }
+    return *pu_mazes_index_->get_listing();
   }}}
 
   std::vector<std::string> mazes_manager::list_saves()
   {{{
-    try {
-      filesys::current_path(daemon_dir_path_);
-      return list_directory(saves_dir_path_, saves_extension_);
+    return *pu_saves_index_->get_listing();
+  }}}
+
+
+  /**
+   * @return  File descriptor of the opened saves folder | -1 if it couldn't be opened.
+   */
+  int mazes_manager::get_saves_fd()
+  {{{
+    return pu_saves_index_->get_fd();
+  }}}
+
+
+  /**
+   * @return  Name of the save file within the saves folder, with the saves extension appended if it's missing | empty
+   *          string if the name of the save is not valid.
+   */
+  std::string mazes_manager::save_file_name(const std::string &save_name)
+  {{{
+    if (save_name.empty() == true || save_name.find('/') != std::string::npos || save_name == "." ||
+        save_name == "..") {
+      return "";
     }
-    catch (filesys::filesystem_error) {
-      return {};
+
+    if (save_name.length() >= saves_extension_.length() &&
+        save_name.compare(save_name.length() - saves_extension_.length(), saves_extension_.length(),
+                          saves_extension_) == 0) {
+      return save_name;
     }
+
+    return save_name + saves_extension_;
   }}}
 
+  /**
+   * Creates new maze of the given name.
+   *
+   * @param[in]   maze_name   Name of the maze file within the mazes folder.
+   * @return      New maze | NULL if the maze file doesn't exist or it's not valid.
+   */
   game::maze *mazes_manager::load_maze(const std::string &maze_name)
   {{{
+    std::shared_ptr<const game::maze_layout> ps_layout = load_layout(maze_name, true);
+
+    if (!ps_layout) {
+      return NULL;
+    }
+
+    game::maze *p_maze = new game::maze(ps_layout);
+    p_maze->maze_name_ = maze_name;
+
+    return p_maze;
+  }}}
+
+
+  /**
+   * Creates new maze restored from the saved game. The layout is taken from the cache of the mazes as usual, so only
+   * the mutable state of the game is read & decoded. The save is refused if the maze has changed since it was saved.
+   *
+   * @param[in]   save_name   Name of the save file within the saves folder, the extension is optional.
+   * @return      New maze | NULL if the save doesn't exist, it's not valid or its maze has changed.
+   */
+  game::maze *mazes_manager::load_game(const std::string &save_name)
+  {{{
+    std::string file_name = save_file_name(save_name);
+    std::string content;
+    game::snapshot state;
+
+    if (file_name.empty() == true || read_file(get_saves_fd(), file_name, content) == false ||
+        save_file::decode(content, state) == false) {
+      return NULL;
+    }
+
+    std::shared_ptr<const game::maze_layout> ps_layout = load_layout(state.maze_name, true);
+
+    if (!ps_layout || ps_layout->get_fingerprint() != state.maze_fingerprint) {
+      return NULL;
+    }
+
+    game::maze *p_maze = new game::maze(ps_layout);
+    p_maze->maze_name_ = state.maze_name;
+
+    if (p_maze->restore(state) == false) {
+      delete p_maze;
+      return NULL;
+    }
+
+    return p_maze;
+  }}}
+
+
+  /**
+   * Loads the layout of the maze of the given name. The compiled maze (maze name + MAZEC_SUFFIX) is preferred, unless
+   * it's older than the text one or it's not valid. The maze file is loaded only when it hasn't been loaded yet, or it
+   * has been modified since, otherwise the cached layout of the maze is shared. While the mazes folder is watched, the
+   * cached layouts are dropped upon the change notifications and the files aren't touched at all for them. The
+   * metadata of the maze are stored upon every load of the maze file.
+   *
+   * @param[in]   maze_name   Name of the maze file within the mazes folder.
+   * @param[in]   keep        Whether to cache the loaded layout, which is not desired for the metadata only.
+   * @return      Layout of the maze | nullptr if the maze file doesn't exist or it's not valid.
+   */
+  std::shared_ptr<const game::maze_layout> mazes_manager::load_layout(const std::string &maze_name, bool keep)
+  {{{
+    int mazes_dir_fd = pu_mazes_index_->get_fd();
+
+    // Only the files directly within the mazes folder can be loaded:
+    if (mazes_dir_fd < 0 || maze_name.empty() == true || maze_name.find('/') != std::string::npos ||
+        maze_name == "." || maze_name == "..") {
+      return nullptr;
+    }
+
     try {
-      filesys::current_path(daemon_dir_path_);
-      filesys::current_path(mazes_dir_path_);
-      
-      std::ifstream maze_file(maze_name);
+      bool watched = pu_mazes_index_->refresh();
+      unsigned long generation;
 
-      if (maze_file.fail() == true) {
-        return NULL;
-      }
+      {
+        boost::lock_guard<boost::mutex> templates_lock(templates_mutex_);
+
+        generation = templates_generation_;
+        std::unordered_map<std::string, maze_template>::iterator it_template = templates_.find(maze_name);
 
+        if (it_template != templates_.end() && watched == true) {
+          templates_hits_ += (keep == true) ? 1 : 0;
+          return it_template->second.ps_layout;
+        }
+      }
 
-      std::string input, version;
-      std::vector<std::string> input_tokens;
-      std::size_t rows, cols;
-      std::stringstream maze_scheme;
+      std::string compiled_name = maze_name + MAZEC_SUFFIX;
+      struct stat text_stat, compiled_stat;
 
-      game::maze *p_maze = NULL;
+      bool text_error = (fstatat(mazes_dir_fd, maze_name.c_str(), &text_stat, 0) != 0);
+      bool compiled_error = (fstatat(mazes_dir_fd, compiled_name.c_str(), &compiled_stat, 0) != 0);
 
+      std::time_t text_mtime = (text_error == true) ? 0 : text_stat.st_mtime;
+      std::time_t compiled_mtime = (compiled_error == true) ? 0 : compiled_stat.st_mtime;
 
-      std::getline(maze_file, input);
+      bool compiled = (compiled_error == false && (text_error == true || compiled_mtime >= text_mtime));
 
-      if (maze_file.good() != true) {
-        return NULL;
+      if (compiled == false && text_error == true) {
+        return nullptr;
       }
 
-      boost::split(input_tokens, input, boost::is_any_of("="));
-      
-      if (input_tokens.size() != 2 || input_tokens[0] != "version") {
-        return NULL;
+      if (watched == false) {
+        boost::lock_guard<boost::mutex> templates_lock(templates_mutex_);
+
+        std::unordered_map<std::string, maze_template>::iterator it_template = templates_.find(maze_name);
+
+        if (it_template != templates_.end() && it_template->second.compiled == compiled &&
+            it_template->second.mtime == ((compiled == true) ? compiled_mtime : text_mtime)) {
+          templates_hits_ += (keep == true) ? 1 : 0;
+          return it_template->second.ps_layout;
+        }
       }
 
-      version = input_tokens[1];
-      std::getline(maze_file, input);
-      
-      if (maze_file.good() != true) {
-        return NULL;
+      std::shared_ptr<const game::maze_layout> ps_layout;
+
+      if (compiled == true) {
+        ps_layout.reset(maze_file::load_compiled(compiled_name, mazes_dir_fd));
       }
 
-      boost::split(input_tokens, input, boost::is_any_of("=xX"));
+      if (!ps_layout && text_error == false) {
+        std::string content;
+
+        if (read_file(mazes_dir_fd, maze_name, content) == false) {
+          return nullptr;
+        }
+
+        std::istringstream text_file(content);
 
-      if (input_tokens.size() != 3 || input_tokens[0] != "size") {
-        return NULL;
+        compiled = false;
+        ps_layout.reset(maze_file::parse(text_file));
       }
-      
-      rows = std::stoul(input_tokens[1], nullptr, 0);
-      cols = std::stoul(input_tokens[2], nullptr, 0);
 
-      if (rows < MAZE_MIN_SIZE || rows > MAZE_MAX_SIZE || cols < MAZE_MIN_SIZE || cols > MAZE_MAX_SIZE) {
-        return NULL;
+      if (!ps_layout) {
+        return nullptr;
       }
 
-      std::getline(maze_file, input);             // Skipping the line delimiter.
+      maze_info info;
+
+      info.rows = ps_layout->get_rows();
+      info.cols = ps_layout->get_cols();
+      info.keys = ps_layout->get_keys_num();
+      info.gates = ps_layout->get_gates_num();
+      info.guardians = ps_layout->get_guardians_num();
+      info.reachable = ps_layout->get_analysis(0).solvable;
+      info.bytes = (text_error == false) ? text_stat.st_size : compiled_stat.st_size;
+      info.text_mtime = text_mtime;
+      info.compiled_mtime = compiled_mtime;
+
+      {
+        boost::lock_guard<boost::mutex> templates_lock(templates_mutex_);
+
+        // The maze file could have changed while it was being loaded, the layout might be outdated then:
+        if (templates_generation_ == generation) {
+          infos_[maze_name] = info;
 
-      if (maze_file.good() != true) {
-        return NULL;
+          if (keep == true) {
+            templates_[maze_name] = maze_template {(compiled == true) ? compiled_mtime : text_mtime, compiled,
+                                                   ps_layout};
+          }
+        }
+
+        templates_misses_ += (keep == true) ? 1 : 0;
       }
-      
-      
-      for (std::size_t i = 0; i < rows; i++) {
-        std::getline(maze_file, input);
 
-        if (maze_file.good() != true || input.size() != (cols * 2 - 1)) {
-          return NULL;
+      return ps_layout;
+    }
+    catch (const std::exception &) {
+      return nullptr;
+    }
+  }}}
+
+
+  /**
+   * @return  Number of the mazes created from the cached layouts & number of the mazes loaded from their files.
+   */
+  std::pair<unsigned long, unsigned long> mazes_manager::templates_stats()
+  {{{
+    boost::lock_guard<boost::mutex> templates_lock(templates_mutex_);
+    return std::pair<unsigned long, unsigned long>(templates_hits_, templates_misses_);
+  }}}
+
+  /**
+   * Parses the parameters of the LIST_MAZES QUERY. Unknown parameters and empty strings are ignored.
+   *
+   * @return  true if all the known parameters are valid, false otherwise.
+   */
+  bool mazes_manager::parse_filter(const std::vector<std::string> &params, mazes_filter &filter)
+  {{{
+    std::vector<std::string>::const_iterator it_param;
+
+    try {
+      for (it_param = params.begin(); it_param != params.end(); it_param++) {
+        if ((*it_param).empty() == true) {
+          continue;
         }
 
-        maze_scheme << input << "\n";
+        std::size_t separator = (*it_param).find('=');
+
+        if (separator == std::string::npos) {
+          return false;
+        }
+
+        std::string key = (*it_param).substr(0, separator);
+        std::string value = (*it_param).substr(separator + 1);
+
+        if (key == LIST_MAZES_NAME) {
+          filter.name = value;
+        }
+        else if (key == LIST_MAZES_PAGE) {
+          filter.page = std::stoul(value);
+        }
+        else if (key == LIST_MAZES_PAGE_SIZE) {
+          filter.page_size = std::stoul(value);
+        }
+        else if (key == LIST_MAZES_MIN_SIZE) {
+          filter.min_size = std::stoul(value);
+        }
+        else if (key == LIST_MAZES_MAX_SIZE) {
+          filter.max_size = std::stoul(value);
+        }
+        else if (key == LIST_MAZES_MAX_GUARDIANS) {
+          filter.max_guardians = std::stoul(value);
+        }
+        else if (key == LIST_MAZES_REACHABLE) {
+          filter.reachable = (std::stoul(value) != 0);
+        }
+      }
+    }
+    catch (const std::exception &) {
+      return false;
+    }
+
+    return filter.page_size > 0 && filter.page_size <= LIST_MAZES_PAGE_MAX;
+  }}}
+
+
+  /**
+   * Lists one page of the mazes matching the filter, with their metadata. The metadata are needed only for the listed
+   * mazes, unless the filter depends on them. They're taken from the metadata index, the maze file is loaded only when
+   * its metadata aren't known yet.
+   *
+   * @param[out]  page    Entries of the mazes on the requested page, see the LIST_MAZES_* of the protocol.
+   * @return      Number of all the mazes matching the filter.
+   */
+  std::size_t mazes_manager::query_mazes(const mazes_filter &filter, std::vector<std::string> &page)
+  {{{
+    std::shared_ptr<const directory_index::listing> ps_listing = pu_mazes_index_->get_listing();
+    directory_index::listing::const_iterator it_maze;
+
+    bool info_needed = (filter.min_size > 0 || filter.max_size < MAZE_MAX_SIZE || filter.reachable == true ||
+                        filter.max_guardians != mazes_filter().max_guardians);
+
+    std::size_t first = filter.page * filter.page_size;
+    std::size_t total {0};
+    maze_info info;
+
+    page.clear();
+
+    for (it_maze = ps_listing->begin(); it_maze != ps_listing->end(); it_maze++) {
+      if (filter.name.empty() == false && (*it_maze).find(filter.name) == std::string::npos) {
+        continue;
       }
 
+      bool on_page = (total >= first && total < first + filter.page_size);
+      bool valid = (info_needed == true || on_page == true) ? maze_info_get(*it_maze, info) : true;
 
-      input = maze_scheme.str();
-      p_maze = new game::maze(static_cast<signed char>(rows), static_cast<signed char>(cols));
-      
-      std::size_t linear_pos {0};
-
-      for (std::size_t i = 0; i < rows; i++) {
-        for (std::size_t j = 0; j < cols; j++) {
-
-          linear_pos = (i * cols * 2) + (j * 2);
-
-          switch (input[linear_pos]) {
-            case ' ' :
-              p_maze->matrix_[i][j].set(game::block::EMPTY);
-              break;
-
-            case 'X' :
-              p_maze->matrix_[i][j].set(game::block::WALL);
-              break;
-
-            case '~' :
-              p_maze->matrix_[i][j].set(game::block::GATE_CLOSED);
-              p_maze->gates_.emplace_back(std::pair<signed char, signed char>(i, j));
-              break;
-
-            case '*' :
-              p_maze->matrix_[i][j].set(game::block::KEY);
-              p_maze->keys_.emplace_back(std::pair<signed char, signed char>(i, j));
-              input[linear_pos] = ' ';
-              break;
-
-            case 'G' :
-              p_maze->matrix_[i][j].set(game::block::TARGET);
-              break;
-            
-            case '1' :
-              p_maze->players_start_coords_[0].first = i;
-              p_maze->players_start_coords_[0].second = j;
-              input[linear_pos] = ' ';
-              break;
-              
-            case '2' :
-              p_maze->players_start_coords_[1].first = i;
-              p_maze->players_start_coords_[1].second = j;
-              input[linear_pos] = ' ';
-              break;
-              
-            case '3' :
-              p_maze->players_start_coords_[2].first = i;
-              p_maze->players_start_coords_[2].second = j;
-              input[linear_pos] = ' ';
-              break;
-              
-            case '4' :
-              p_maze->players_start_coords_[3].first = i;
-              p_maze->players_start_coords_[3].second = j;
-              input[linear_pos] = ' ';
-              break;
-              
-            case '@' :
-              p_maze->guardians_.emplace_back(i, j, p_maze);
-              input[linear_pos] = ' ';
-              break;
-
-            default :
-              delete p_maze;
-              return NULL;
-          }
+      if (info_needed == true) {
+        if (valid == false || info.rows < filter.min_size || info.cols < filter.min_size ||
+            info.rows > filter.max_size || info.cols > filter.max_size || info.guardians > filter.max_guardians ||
+            (filter.reachable == true && info.reachable == false)) {
+          continue;
         }
       }
 
-      p_maze->maze_version_ = version;
-      p_maze->maze_scheme_ = input;
-      p_maze->maze_scheme_.back() = ' ';
+      if (on_page == true && valid == false) {
+        page.push_back(*it_maze);                   // Not valid maze, listed by the name only as before.
+      }
+      else if (on_page == true) {
+        page.push_back(*it_maze + ";" + std::to_string(info.rows) + ";" + std::to_string(info.cols) + ";" +
+                       std::to_string(info.keys) + ";" + std::to_string(info.gates) + ";" +
+                       std::to_string(info.guardians) + ";" + ((info.reachable == true) ? "1" : "0") + ";" +
+                       std::to_string(info.bytes));
+      }
 
-      return p_maze;
+      total++;
     }
-    catch (filesys::filesystem_error) {
-      return NULL;
+
+    return total;
+  }}}
+
+  // // // // // // // // // // // //
+
+  /**
+   * Gets the metadata of the maze from the index, or loads the maze file for them. When the mazes folder isn't
+   * watched, the indexed metadata are checked against the files' modification times.
+   *
+   * @return  true if the metadata were found, false if the maze is not valid.
+   */
+  bool mazes_manager::maze_info_get(const std::string &maze_name, maze_info &info)
+  {{{
+    bool watched = pu_mazes_index_->refresh();
+    bool found {false};
+
+    {
+      boost::lock_guard<boost::mutex> templates_lock(templates_mutex_);
+
+      std::unordered_map<std::string, maze_info>::iterator it_info = infos_.find(maze_name);
+
+      if (it_info != infos_.end()) {
+        info = it_info->second;
+        found = true;
+      }
     }
-    catch (std::exception) {
-      return NULL;
+
+    if (found == true && watched == false) {
+      struct stat text_stat, compiled_stat;
+      std::string compiled_name = maze_name + MAZEC_SUFFIX;
+      int mazes_dir_fd = pu_mazes_index_->get_fd();
+
+      bool text_error = (fstatat(mazes_dir_fd, maze_name.c_str(), &text_stat, 0) != 0);
+      bool compiled_error = (fstatat(mazes_dir_fd, compiled_name.c_str(), &compiled_stat, 0) != 0);
+
+      std::time_t text_mtime = (text_error == true) ? 0 : text_stat.st_mtime;
+      std::time_t compiled_mtime = (compiled_error == true) ? 0 : compiled_stat.st_mtime;
+
+      found = (text_mtime == info.text_mtime && compiled_mtime == info.compiled_mtime);
     }
+
+    if (found == true) {
+      return true;
+    }
+
+    if (!load_layout(maze_name, false)) {
+      return false;
+    }
+
+    boost::lock_guard<boost::mutex> templates_lock(templates_mutex_);
+
+    std::unordered_map<std::string, maze_info>::iterator it_info = infos_.find(maze_name);
+
+    if (it_info == infos_.end()) {
+      return false;                                 // Changed while it was being loaded.
+    }
+
+    info = it_info->second;
+    return true;
   }}}
 
-  // // // // // // // // // // // //
 
-  std::vector<std::string> mazes_manager::list_directory(filesys::path dir_path, std::string extension)
+  /**
+   * Change handler of the mazes folder's index, drops the cached layout of the changed maze file.
+   */
+  void mazes_manager::templates_changed(const std::string &file_name)
   {{{
-    std::list<std::string> files;
-    
-    try {
-      filesys::current_path(dir_path);
-      
-      filesys::directory_iterator it_dir_end;
-      boost::system::error_code error;
-      std::string fname;
-      std::size_t fname_length;
+    boost::lock_guard<boost::mutex> templates_lock(templates_mutex_);
 
-      std::size_t ext_length {extension.length()};
+    templates_generation_++;
 
-      for (filesys::directory_iterator it_dir("."); it_dir != it_dir_end; it_dir++) {
+    if (file_name.empty() == true) {
+      templates_.clear();
+      infos_.clear();
+      return;
+    }
 
-        if (filesys::is_regular_file(it_dir->path(), error) == true && !error) {
-          fname = it_dir->path().filename().native();
-          fname_length = fname.length();
+    templates_.erase(file_name);
+    infos_.erase(file_name);
 
-          if (fname_length < ext_length) {
-            continue;
-          }
-          
-          if (ext_length == 0 || fname.find(extension, fname_length - ext_length) != std::string::npos) {
-            files.push_back(fname);
-          }
+    std::size_t suffix_length = std::string(MAZEC_SUFFIX).length();
+
+    if (file_name.length() > suffix_length &&
+        file_name.compare(file_name.length() - suffix_length, suffix_length, MAZEC_SUFFIX) == 0) {
+      templates_.erase(file_name.substr(0, file_name.length() - suffix_length));
+      infos_.erase(file_name.substr(0, file_name.length() - suffix_length));
+    }
+
+    return;
+  }}}
+
+
+  /**
+   * Reads the whole file within the opened folder.
+   *
+   * @return  true if the file was read, false otherwise.
+   */
+  bool mazes_manager::read_file(int dir_fd, const std::string &file_name, std::string &content)
+  {{{
+    int fd = openat(dir_fd, file_name.c_str(), O_RDONLY | O_CLOEXEC);
+
+    if (fd < 0) {
+      return false;
+    }
+
+    char buffer[4096];
+    ssize_t length;
+
+    content.clear();
+
+    while ((length = read(fd, buffer, sizeof(buffer))) != 0) {
+      if (length < 0) {
+        if (errno == EINTR) {
+          continue;
         }
 
+        close(fd);
+        return false;
       }
-      
-      files.sort();
 
-      return {std::make_move_iterator(std::begin(files)), std::make_move_iterator(std::end(files))};
-    }
-    catch (filesys::filesystem_error) {
-      return {};
+      content.append(buffer, length);
     }
+
+    close(fd);
+    return true;
   }}}
 }
 
@@ -19,13 +19,22 @@
  ~ ~~~[ HEADER FILES ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ ~
  * ****************************************************************************************************************** */
 
+#include <ctime>
+#include <memory>
 #include <string>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include <boost/filesystem.hpp>
+#include <boost/thread.hpp>
+
+#include "../protocol.hh"
 
 #include "mazed_globals.hh"
+#include "mazed_directory_index.hh"
 #include "mazed_game_maze.hh"
+#include "mazed_maze_file.hh"
 
 
 /* ****************************************************************************************************************** *
@@ -40,24 +49,81 @@ namespace mazed {
    * Class encapsulating all operations with listing available mazes, loading them and saving them back.
    */
   class mazes_manager {
+    public:
+      struct maze_info {
+        unsigned                                    rows;
+        unsigned                                    cols;
+        unsigned                                    keys;
+        unsigned                                    gates;
+        unsigned                                    guardians;
+        bool                                        reachable;            // Solvable by the 1st player.
+        unsigned long                               bytes;                // Size of the maze file.
+        std::time_t                                 text_mtime;
+        std::time_t                                 compiled_mtime;
+      };
+
+      // Filter & page of the LIST_MAZES QUERY:
+      struct mazes_filter {
+        std::string                                 name;
+        unsigned long                               page {0};
+        unsigned long                               page_size {LIST_MAZES_PAGE_DEFAULT};
+        unsigned long                               min_size {0};
+        unsigned long                               max_size {MAZE_MAX_SIZE};
+        unsigned long                               max_guardians {~0UL};
+        bool                                        reachable {false};
+      };
+
+    private:
       std::string mazes_extension_;
       std::string saves_extension_;
       
       filesys::path mazes_dir_path_;
       filesys::path saves_dir_path_;
       filesys::path daemon_dir_path_;
+
+      // Folders are opened once and all the files are accessed relatively to them, so the working directory of the
+      // process is never changed and the client handlers don't have to serialize the file operations:
+      std::unique_ptr<directory_index> pu_mazes_index_;
+      std::unique_ptr<directory_index> pu_saves_index_;
+
+      // Parsed and validated layouts of the mazes, shared by the new mazes until the maze file is modified:
+      struct maze_template {
+        std::time_t                                 mtime;
+        bool                                        compiled;
+        std::shared_ptr<const game::maze_layout>    ps_layout;
+      };
+
+      boost::mutex                                  templates_mutex_;
+      std::unordered_map<std::string, maze_template> templates_;
+      unsigned long                                 templates_hits_ {0};
+      unsigned long                                 templates_misses_ {0};
+      unsigned long                                 templates_generation_ {0};  // Incremented upon every change.
+      
+      // Metadata index of the mazes, filled upon every load of the maze file:
+      std::unordered_map<std::string, maze_info>    infos_;               // Guarded by the templates_mutex_.
       
       // // // // // // // // // // //
 
-      std::vector<std::string> list_directory(filesys::path dir_path, std::string extension);
+      std::shared_ptr<const game::maze_layout> load_layout(const std::string &maze_name, bool keep);
+      bool maze_info_get(const std::string &maze_name, maze_info &info);
+      void templates_changed(const std::string &file_name);
+      bool read_file(int dir_fd, const std::string &file_name, std::string &content);
 
     public:
       mazes_manager(mazed::settings_tuple settings);
+     ~mazes_manager();
 
       std::vector<std::string> list_mazes();
       std::vector<std::string> list_saves();
+      int get_saves_fd();
+      std::string save_file_name(const std::string &save_name);
+
+      static bool parse_filter(const std::vector<std::string> &params, mazes_filter &filter);
+      std::size_t query_mazes(const mazes_filter &filter, std::vector<std::string> &page);
 
       game::maze *load_maze(const std::string &maze_name);
+      game::maze *load_game(const std::string &save_name);
+      std::pair<unsigned long, unsigned long> templates_stats();
   };
 }
 
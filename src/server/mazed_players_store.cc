@@ -0,0 +1,474 @@
+/**
+ * @file      mazed_players_store.cc
+ * @author    Dee'Kej (David Kaspar - xkaspa34)
+ * @version   0.1
+ * @brief     Contains implementations of class member functions of mazed::players_store.
+ */
+
+
+/* ****************************************************************************************************************** *
+ * ***[ START OF MAZED_PLAYERS_STORE.CC ]**************************************************************************** *
+ * ****************************************************************************************************************** */
+
+
+/* ****************************************************************************************************************** *
+ ~ ~~~[ HEADER FILES ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ ~
+ * ****************************************************************************************************************** */
+
+#include <cctype>
+#include <cerrno>
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "mazed_maze_file.hh"
+#include "mazed_players_store.hh"
+
+
+/* ****************************************************************************************************************** *
+ ~ ~~~[ MEMBER FUNCTIONS IMPLEMENTATIONS ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ ~
+ * ****************************************************************************************************************** */
+
+namespace filesys = boost::filesystem;
+
+namespace mazed {
+
+  /**
+   * Opens the players file and builds the index of the players. The store is unusable (every change fails) when the
+   * file can't be opened or it's not a players file, which is never overwritten then.
+   */
+  players_store::players_store(mazed::settings_tuple settings) :
+    dir_path_(std::get<PLAYERS_FOLDER>(settings))
+  {{{
+    // Relative paths are relative to the daemon's folder:
+    if (dir_path_.is_relative() == true) {
+      dir_path_ = filesys::path(std::get<DAEMON_FOLDER>(settings)) / dir_path_;
+    }
+
+    if (load() == false && fd_ >= 0) {
+      close(fd_);
+      fd_ = -1;
+    }
+
+    return;
+  }}}
+
+
+  players_store::~players_store()
+  {{{
+    if (fd_ >= 0) {
+      close(fd_);
+    }
+
+    return;
+  }}}
+
+  // // // // // // // // // // //
+
+  /**
+   * Logs in the player of the given UID, the player is created first if it doesn't exist yet.
+   *
+   * @param[in]     uid     UID of the player.
+   * @param[in,out] nick    Nick of the created player (the UID is used if it's empty), replaced by the stored nick.
+   * @return        OK if the player has logged in, CREATED if it has been created, the error otherwise.
+   */
+  players_store::E_result players_store::login_or_create(const std::string &uid, std::string &nick)
+  {{{
+    if (is_valid_uid(uid) == false) {
+      return INVALID;
+    }
+
+    E_result retval {CREATED};
+
+    store_mutex_.lock();
+    {
+      std::unordered_map<std::string, std::string>::const_iterator it_player = nicks_.find(uid);
+
+      if (it_player != nicks_.end()) {
+        nick = (*it_player).second;
+        store_mutex_.unlock();
+        return OK;
+      }
+
+      if (nick.empty() == true) {
+        nick = uid.substr(0, PLAYER_NICK_MAX);
+      }
+
+      if (is_valid_nick(nick) == false) {
+        retval = INVALID;
+      }
+      else if (uids_.count(nick) > 0) {
+        retval = NICK_TAKEN;
+      }
+      else if (append(uid, nick) == false) {
+        retval = FAILED;
+      }
+    }
+    store_mutex_.unlock();
+
+    return retval;
+  }}}
+
+
+  /**
+   * Changes the nick of the existing player. The nicks are unique among all the players.
+   *
+   * @return  OK if the nick has been changed, the error otherwise.
+   */
+  players_store::E_result players_store::change_nick(const std::string &uid, const std::string &nick)
+  {{{
+    if (is_valid_nick(nick) == false) {
+      return INVALID;
+    }
+
+    E_result retval {OK};
+
+    store_mutex_.lock();
+    {
+      std::unordered_map<std::string, std::string>::const_iterator it_player = nicks_.find(uid);
+      std::unordered_map<std::string, std::string>::const_iterator it_owner = uids_.find(nick);
+
+      if (it_player == nicks_.end()) {
+        retval = INVALID;
+      }
+      else if (it_owner != uids_.end()) {
+        retval = ((*it_owner).second == uid) ? OK : NICK_TAKEN;
+      }
+      else if (append(uid, nick) == false) {
+        retval = FAILED;
+      }
+    }
+    store_mutex_.unlock();
+
+    return retval;
+  }}}
+
+
+  /**
+   * @return  Number of the players & number of the records in the players file.
+   */
+  std::pair<std::size_t, std::size_t> players_store::stats()
+  {{{
+    std::pair<std::size_t, std::size_t> retval;
+
+    store_mutex_.lock();
+    {
+      retval = std::make_pair(nicks_.size(), records_);
+    }
+    store_mutex_.unlock();
+
+    return retval;
+  }}}
+
+  // // // // // // // // // // //
+
+  /**
+   * Opens the players file (it's created if it doesn't exist) and builds the index from its records. The file is
+   * mapped, so it's scanned without copying. The file is truncated after the last valid record.
+   *
+   * @return  true if the file has been loaded, false otherwise.
+   */
+  bool players_store::load()
+  {{{
+    boost::system::error_code error;
+    filesys::create_directories(dir_path_, error);
+
+    fd_ = open((dir_path_ / PLAYERS_FILE).c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+
+    struct stat file_stat;
+
+    if (fd_ < 0 || fstat(fd_, &file_stat) != 0) {
+      return false;
+    }
+
+    std::size_t size = file_stat.st_size;
+
+    // New file, or it has been torn before its header was written:
+    if (size < sizeof(file_header)) {
+      std::string content = encode_header();
+
+      if (ftruncate(fd_, 0) != 0 || write_all(fd_, content, 0) == false) {
+        return false;
+      }
+
+      file_size_ = content.size();
+      return true;
+    }
+
+    void *p_mapped = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd_, 0);
+
+    if (p_mapped == MAP_FAILED) {
+      return false;
+    }
+
+    const unsigned char *p_data = static_cast<const unsigned char *>(p_mapped);
+    file_header header;
+
+    std::memcpy(&header, p_data, sizeof(header));
+
+    if (std::memcmp(header.magic, "MAZP", sizeof(header.magic)) != 0 || header.format != PLAYERS_FORMAT) {
+      munmap(p_mapped, size);
+      return false;
+    }
+
+    std::size_t offset = sizeof(header);
+
+    // Upper estimate of the players, so the indexes aren't rehashed during the scan:
+    nicks_.reserve(size / (sizeof(record_header) + 8));
+    uids_.reserve(size / (sizeof(record_header) + 8));
+
+    while (offset + sizeof(record_header) <= size) {
+      record_header record;
+
+      std::memcpy(&record, p_data + offset, sizeof(record));
+
+      std::size_t length = sizeof(record) + record.uid_length + record.nick_length;
+
+      if (offset + length > size || maze_file::checksum(p_data + offset + sizeof(record.checksum),
+                                                        length - sizeof(record.checksum)) != record.checksum) {
+        break;
+      }
+
+      const char *p_strings = reinterpret_cast<const char *>(p_data + offset + sizeof(record));
+
+      index_set(std::string(p_strings, record.uid_length),
+                std::string(p_strings + record.uid_length, record.nick_length));
+
+      records_++;
+      offset += length;
+    }
+
+    munmap(p_mapped, size);
+
+    // The torn record is dropped, so the next records are appended right behind the valid ones:
+    if (offset < size && ftruncate(fd_, offset) != 0) {
+      return false;
+    }
+
+    file_size_ = offset;
+
+    if (records_ - nicks_.size() >= PLAYERS_COMPACT_MIN && records_ - nicks_.size() > nicks_.size()) {
+      compact();
+    }
+
+    return true;
+  }}}
+
+
+  /**
+   * Appends the record of the player to the players file and updates the index. The file is compacted when it has
+   * more dead records than the live ones. Expects the store to be locked.
+   *
+   * @return  true if the record has been written, false otherwise.
+   */
+  bool players_store::append(const std::string &uid, const std::string &nick)
+  {{{
+    if (fd_ < 0) {
+      return false;
+    }
+
+    std::string record = encode_record(uid, nick);
+
+    // The half-written record is overwritten by the next one:
+    if (write_all(fd_, record, file_size_) == false) {
+      return false;
+    }
+
+    file_size_ += record.size();
+    records_++;
+    index_set(uid, nick);
+
+    if (records_ - nicks_.size() >= PLAYERS_COMPACT_MIN && records_ - nicks_.size() > nicks_.size()) {
+      compact();
+    }
+
+    return true;
+  }}}
+
+
+  /**
+   * Sets the nick of the player in both indexes, the previous nick of the player is released.
+   */
+  void players_store::index_set(const std::string &uid, const std::string &nick)
+  {{{
+    std::unordered_map<std::string, std::string>::iterator it_player = nicks_.find(uid);
+
+    if (it_player != nicks_.end()) {
+      uids_.erase((*it_player).second);
+      (*it_player).second = nick;
+    }
+    else {
+      nicks_.emplace(uid, nick);
+    }
+
+    uids_[nick] = uid;
+
+    return;
+  }}}
+
+
+  /**
+   * Writes only the live records aside, syncs them and renames them over the players file. The players file is kept
+   * as it was if anything fails. Expects the store to be locked.
+   *
+   * @return  true if the players file has been compacted, false otherwise.
+   */
+  bool players_store::compact()
+  {{{
+    filesys::path file_path = dir_path_ / PLAYERS_FILE;
+    filesys::path tmp_path = dir_path_ / (PLAYERS_FILE ".tmp");
+
+    std::string content = encode_header();
+
+    std::unordered_map<std::string, std::string>::const_iterator it_player;
+
+    for (it_player = nicks_.begin(); it_player != nicks_.end(); it_player++) {
+      content += encode_record((*it_player).first, (*it_player).second);
+    }
+
+    int fd = open(tmp_path.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+
+    if (fd < 0) {
+      return false;
+    }
+
+    if (write_all(fd, content, 0) == false || fsync(fd) != 0 || rename(tmp_path.c_str(), file_path.c_str()) != 0) {
+      close(fd);
+      unlink(tmp_path.c_str());
+      return false;
+    }
+
+    // The rename itself has to survive the crash as well:
+    int dir_fd = open(dir_path_.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+
+    if (dir_fd >= 0) {
+      fsync(dir_fd);
+      close(dir_fd);
+    }
+
+    close(fd_);
+
+    fd_ = fd;
+    file_size_ = content.size();
+    records_ = nicks_.size();
+
+    return true;
+  }}}
+
+  // // // // // // // // // // //
+
+  /**
+   * @return  Header of the players file.
+   */
+  std::string players_store::encode_header()
+  {{{
+    file_header header;
+
+    std::memcpy(header.magic, "MAZP", sizeof(header.magic));
+    header.format = PLAYERS_FORMAT;
+
+    return std::string(reinterpret_cast<const char *>(&header), sizeof(header));
+  }}}
+
+
+  /**
+   * @return  Record of the player - the record's header, the UID & the nick.
+   */
+  std::string players_store::encode_record(const std::string &uid, const std::string &nick)
+  {{{
+    record_header record;
+
+    record.uid_length = uid.size();
+    record.nick_length = nick.size();
+    record.reserved = 0;
+
+    std::string content(reinterpret_cast<const char *>(&record), sizeof(record));
+    content += uid;
+    content += nick;
+
+    record.checksum = maze_file::checksum(reinterpret_cast<const unsigned char *>(content.data()) +
+                                          sizeof(record.checksum), content.size() - sizeof(record.checksum));
+    content.replace(0, sizeof(record.checksum), reinterpret_cast<const char *>(&record.checksum),
+                    sizeof(record.checksum));
+
+    return content;
+  }}}
+
+
+  /**
+   * Writes the whole content at the given offset of the file.
+   *
+   * @return  true if the content has been written, false otherwise.
+   */
+  bool players_store::write_all(int fd, const std::string &content, std::size_t offset)
+  {{{
+    std::size_t written {0};
+
+    while (written < content.size()) {
+      ssize_t retval = pwrite(fd, content.data() + written, content.size() - written, offset + written);
+
+      if (retval < 0 && errno == EINTR) {
+        continue;
+      }
+      else if (retval < 0) {
+        return false;
+      }
+
+      written += retval;
+    }
+
+    return true;
+  }}}
+
+
+  /**
+   * @return  true if the UID consists of the alphanumeric characters, '-', '_' or '.' only & it's not too long.
+   */
+  bool players_store::is_valid_uid(const std::string &uid)
+  {{{
+    if (uid.empty() == true || uid.size() > PLAYER_UID_MAX) {
+      return false;
+    }
+
+    std::string::const_iterator it_char;
+
+    for (it_char = uid.begin(); it_char != uid.end(); it_char++) {
+      if (std::isalnum(static_cast<unsigned char>(*it_char)) == 0 && *it_char != '-' && *it_char != '_' &&
+          *it_char != '.') {
+        return false;
+      }
+    }
+
+    return true;
+  }}}
+
+
+  /**
+   * @return  true if the nick consists of the printable characters only & it's not too long. The ';' separates the
+   *          nicks in the LIST_RUNNING, so it's not allowed.
+   */
+  bool players_store::is_valid_nick(const std::string &nick)
+  {{{
+    if (nick.empty() == true || nick.size() > PLAYER_NICK_MAX) {
+      return false;
+    }
+
+    std::string::const_iterator it_char;
+
+    for (it_char = nick.begin(); it_char != nick.end(); it_char++) {
+      if (std::isprint(static_cast<unsigned char>(*it_char)) == 0 || *it_char == ';') {
+        return false;
+      }
+    }
+
+    return true;
+  }}}
+}
+
+/* ****************************************************************************************************************** *
+ * ***[ END OF MAZED_PLAYERS_STORE.CC ]****************************************************************************** *
+ * ****************************************************************************************************************** */
+
@@ -0,0 +1,115 @@
+/**
+ * @file      mazed_players_store.hh
+ * @author    Dee'Kej (David Kaspar - xkaspa34)
+ * @version   0.1
+ * @brief     Contains declaration of the on-disk store of the players' records.
+ */
+
+
+/* ****************************************************************************************************************** *
+ * ***[ START OF MAZED_PLAYERS_STORE.HH ]**************************************************************************** *
+ * ****************************************************************************************************************** */
+
+#ifndef H_GUARD_MAZED_PLAYERS_STORE_HH
+#define H_GUARD_MAZED_PLAYERS_STORE_HH
+
+
+/* ****************************************************************************************************************** *
+ ~ ~~~[ HEADER FILES ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ ~
+ * ****************************************************************************************************************** */
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+#include <boost/filesystem.hpp>
+#include <boost/thread.hpp>
+
+#include "mazed_globals.hh"
+
+
+/* ****************************************************************************************************************** *
+ ~ ~~~[ PLAYERS_STORE CLASS ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ ~
+ * ****************************************************************************************************************** */
+
+namespace mazed {
+
+  #define PLAYERS_FILE          "players.db"
+  #define PLAYERS_FORMAT        1U          // Version of the players file format.
+  #define PLAYER_UID_MAX        32U
+  #define PLAYER_NICK_MAX       24U
+  #define PLAYERS_COMPACT_MIN   4096U       // Dead records needed before the compaction is considered.
+
+  /**
+   * Records of the players (UID & nick) stored in one append-only file of the players folder. The file is mapped and
+   * scanned only once, when the store is created, and the whole index is kept in the memory then - both the UID and
+   * the nick are looked up in O(1) without touching the disk. Every change appends the new record of the player, the
+   * last one wins. When the dead records outnumber the live ones, the file is compacted by writing the live records
+   * aside and renaming them over the file.
+   *
+   * The appended records aren't synced (only the compacted file is), so the last changes survive the crash of the
+   * daemon, but not the crash of the system. The torn record at the end of the file is dropped upon the next start.
+   */
+  class players_store {
+    public:
+      enum E_result {
+        OK = 0,
+        CREATED,
+        INVALID,                                    // UID or nick is not valid.
+        NICK_TAKEN,
+        FAILED,                                     // The store couldn't be written.
+      };
+
+    private:
+      struct file_header {
+        char                                        magic[4];
+        std::uint32_t                               format;
+      };
+
+      // Header of every record, followed by the UID & nick:
+      struct record_header {
+        std::uint32_t                               checksum;       // FNV-1a of everything behind the checksum.
+        std::uint8_t                                uid_length;
+        std::uint8_t                                nick_length;
+        std::uint16_t                               reserved;
+      };
+
+      boost::filesystem::path                       dir_path_;
+      int                                           fd_ {-1};
+      std::size_t                                   file_size_ {0};
+      std::size_t                                   records_ {0};   // Live & dead ones.
+
+      boost::mutex                                  store_mutex_;
+      std::unordered_map<std::string, std::string>  nicks_;         // Indexed by the UID.
+      std::unordered_map<std::string, std::string>  uids_;          // Indexed by the nick.
+
+      // // // // // // // // // // //
+
+      bool load();
+      bool append(const std::string &uid, const std::string &nick);
+      void index_set(const std::string &uid, const std::string &nick);
+      bool compact();
+
+      static std::string encode_header();
+      static std::string encode_record(const std::string &uid, const std::string &nick);
+      static bool write_all(int fd, const std::string &content, std::size_t offset);
+      static bool is_valid_uid(const std::string &uid);
+      static bool is_valid_nick(const std::string &nick);
+
+    public:
+      players_store(mazed::settings_tuple settings);
+     ~players_store();
+
+      E_result login_or_create(const std::string &uid, std::string &nick);
+      E_result change_nick(const std::string &uid, const std::string &nick);
+      std::pair<std::size_t, std::size_t> stats();
+  };
+}
+
+/* ****************************************************************************************************************** *
+ * ***[ END OF MAZED_PLAYERS_STORE.HH ]****************************************************************************** *
+ * ****************************************************************************************************************** */
+
+#endif
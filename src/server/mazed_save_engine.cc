@@ -0,0 +1,201 @@
+/**
+ * @file      mazed_save_engine.cc
+ * @author    Dee'Kej (David Kaspar - xkaspa34)
+ * @version   0.1
+ * @brief     Contains implementations of class member functions of mazed::save_engine.
+ */
+
+
+/* ****************************************************************************************************************** *
+ * ***[ START OF MAZED_SAVE_ENGINE.CC ]****************************************************************************** *
+ * ****************************************************************************************************************** */
+
+
+/* ****************************************************************************************************************** *
+ ~ ~~~[ HEADER FILES ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ ~
+ * ****************************************************************************************************************** */
+
+#include <cerrno>
+#include <sstream>
+#include <string>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <boost/bind.hpp>
+
+#include "mazed_save_engine.hh"
+#include "mazed_save_file.hh"
+
+
+/* ****************************************************************************************************************** *
+ ~ ~~~[ MEMBER FUNCTIONS IMPLEMENTATIONS ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ ~
+ * ****************************************************************************************************************** */
+
+namespace mazed {
+
+  /**
+   * Starts the thread of the engine. It has to be created after the daemon has forked, as the game::scheduler.
+   *
+   * @param[in]   dir_fd    Opened saves folder, the saves are written relatively to it.
+   * @param[in]   log       Function used for logging from the engine's thread.
+   */
+  save_engine::save_engine(int dir_fd, log_function log) :
+    dir_fd_{dir_fd}, log_{log}, thread_(boost::bind(&save_engine::worker, this))
+  {{{
+    return;
+  }}}
+
+
+  /**
+   * Stops the engine's thread. The saves already submitted are written first.
+   */
+  save_engine::~save_engine()
+  {{{
+    queue_mutex_.lock();
+    {
+      stop_ = true;
+    }
+    queue_mutex_.unlock();
+
+    queue_changed_.notify_one();
+    thread_.join();
+
+    return;
+  }}}
+
+  // // // // // // // // // // //
+
+  /**
+   * Hands the snapshot over to the engine's thread for writing.
+   *
+   * @param[in]   ps_snapshot   Snapshot of the game, it's not modified anymore.
+   * @param[in]   file_name     Name of the save file within the saves folder.
+   * @param[in]   stall_us      Time the snapshot has held the maze lock, for the logging.
+   * @return      true if the save has been queued, false if there are too many saves waiting already.
+   */
+  bool save_engine::submit(std::shared_ptr<const game::snapshot> ps_snapshot, const std::string &file_name,
+                           long stall_us)
+  {{{
+    queue_mutex_.lock();
+    {
+      if (queue_.size() >= SAVES_QUEUE_MAX || stop_ == true) {
+        queue_mutex_.unlock();
+        return false;
+      }
+
+      queue_.push_back(job {ps_snapshot, file_name, std::chrono::steady_clock::now(), stall_us});
+    }
+    queue_mutex_.unlock();
+
+    queue_changed_.notify_one();
+
+    return true;
+  }}}
+
+  // // // // // // // // // // //
+
+  /**
+   * Loop of the engine's thread, which writes the queued saves one by one until the engine is stopped.
+   */
+  void save_engine::worker()
+  {{{
+    while (true) {
+      job save_job;
+
+      {
+        boost::unique_lock<boost::mutex> queue_lock(queue_mutex_);
+
+        while (queue_.empty() == true && stop_ == false) {
+          queue_changed_.wait(queue_lock);
+        }
+
+        if (queue_.empty() == true) {
+          return;                                   // Stopped and nothing left to write.
+        }
+
+        save_job = queue_.front();
+        queue_.pop_front();
+      }
+
+      std::chrono::steady_clock::time_point started = std::chrono::steady_clock::now();
+
+      std::string content = save_file::encode(*save_job.ps_snapshot);
+      long sync_us {0};
+      bool written = write_file(save_job.file_name, content, sync_us);
+
+      std::chrono::steady_clock::time_point finished = std::chrono::steady_clock::now();
+
+      std::ostringstream info;
+
+      if (written == true) {
+        info << "Game saved as " << save_job.file_name << " (" << content.size() << " B): latency "
+             << std::chrono::duration_cast<std::chrono::microseconds>(finished - save_job.submitted).count()
+             << " us (queued "
+             << std::chrono::duration_cast<std::chrono::microseconds>(started - save_job.submitted).count()
+             << " us, fsync " << sync_us << " us), tick stall " << save_job.stall_us << " us";
+        log_(mazed::log_level::INFO, info.str().c_str());
+      }
+      else {
+        info << "Failed to save game as " << save_job.file_name;
+        log_(mazed::log_level::ERROR, info.str().c_str());
+      }
+    }
+  }}}
+
+
+  /**
+   * Writes the save file aside, syncs it and renames it then, so the half-written save is never seen by LIST_SAVES.
+   *
+   * @param[out]  sync_us   Time spent by syncing the file & the folder to the disk.
+   * @return      true if the save file has been written, false otherwise.
+   */
+  bool save_engine::write_file(const std::string &file_name, const std::string &content, long &sync_us)
+  {{{
+    std::string tmp_name = file_name + ".tmp";
+
+    int fd = openat(dir_fd_, tmp_name.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+
+    if (fd < 0) {
+      return false;
+    }
+
+    std::size_t written {0};
+
+    while (written < content.size()) {
+      ssize_t retval = write(fd, content.data() + written, content.size() - written);
+
+      if (retval < 0 && errno == EINTR) {
+        continue;
+      }
+      else if (retval < 0) {
+        break;
+      }
+
+      written += retval;
+    }
+
+    std::chrono::steady_clock::time_point sync_start = std::chrono::steady_clock::now();
+
+    bool success = (written == content.size() && fsync(fd) == 0);
+
+    close(fd);
+
+    if (success == false || renameat(dir_fd_, tmp_name.c_str(), dir_fd_, file_name.c_str()) != 0) {
+      unlinkat(dir_fd_, tmp_name.c_str(), 0);
+      return false;
+    }
+
+    fsync(dir_fd_);                                 // The rename itself has to survive the crash as well.
+
+    sync_us = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() -
+                                                                    sync_start).count();
+    return true;
+  }}}
+}
+
+/* ****************************************************************************************************************** *
+ * ***[ END OF MAZED_SAVE_ENGINE.CC ]******************************************************************************** *
+ * ****************************************************************************************************************** */
+
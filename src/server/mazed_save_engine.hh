@@ -0,0 +1,86 @@
+/**
+ * @file      mazed_save_engine.hh
+ * @author    Dee'Kej (David Kaspar - xkaspa34)
+ * @version   0.1
+ * @brief     Contains declaration of the writer of the saved games, which runs in its own thread.
+ */
+
+
+/* ****************************************************************************************************************** *
+ * ***[ START OF MAZED_SAVE_ENGINE.HH ]****************************************************************************** *
+ * ****************************************************************************************************************** */
+
+#ifndef H_GUARD_MAZED_SAVE_ENGINE_HH
+#define H_GUARD_MAZED_SAVE_ENGINE_HH
+
+
+/* ****************************************************************************************************************** *
+ ~ ~~~[ HEADER FILES ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ ~
+ * ****************************************************************************************************************** */
+
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <string>
+
+#include <boost/thread.hpp>
+
+#include "mazed_globals.hh"
+#include "mazed_game_snapshot.hh"
+
+
+/* ****************************************************************************************************************** *
+ ~ ~~~[ SAVE_ENGINE CLASS ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ ~
+ * ****************************************************************************************************************** */
+
+namespace mazed {
+
+  #define SAVES_QUEUE_MAX       64U         // Saves waiting for the writing, the next ones are refused.
+
+  /**
+   * Writer of the saved games. The snapshot of the game is taken by the game::instance under the maze lock, which is
+   * all the game loop has to wait for. The snapshot is then encoded, written aside, synced to the disk and renamed by
+   * the engine's own thread, so neither the game loop nor the client's handler waits for the disk. The latency of
+   * every save and the stall of the game loop it has caused are logged.
+   */
+  class save_engine {
+    public:
+      using log_function = std::function<void(mazed::log_level level, const char *str)>;
+
+    private:
+      struct job {
+        std::shared_ptr<const game::snapshot>       ps_snapshot;
+        std::string                                 file_name;
+        std::chrono::steady_clock::time_point       submitted;
+        long                                        stall_us;       // Time the snapshot held the maze lock.
+      };
+
+      int                                           dir_fd_;        // Saves folder, owned by the mazes_manager.
+      log_function                                  log_;
+
+      boost::mutex                                  queue_mutex_;
+      boost::condition_variable                     queue_changed_;
+      std::deque<job>                               queue_;
+      bool                                          stop_ {false};
+
+      boost::thread                                 thread_;        // Started as the last one.
+
+      // // // // // // // // // // //
+
+      void worker();
+      bool write_file(const std::string &file_name, const std::string &content, long &sync_us);
+
+    public:
+      save_engine(int dir_fd, log_function log);
+     ~save_engine();
+
+      bool submit(std::shared_ptr<const game::snapshot> ps_snapshot, const std::string &file_name, long stall_us);
+  };
+}
+
+/* ****************************************************************************************************************** *
+ * ***[ END OF MAZED_SAVE_ENGINE.HH ]******************************************************************************** *
+ * ****************************************************************************************************************** */
+
+#endif
@@ -0,0 +1,188 @@
+/**
+ * @file      mazed_save_file.cc
+ * @author    Dee'Kej (David Kaspar - xkaspa34)
+ * @version   0.1
+ * @brief     Contains implementations of class member functions of mazed::save_file.
+ */
+
+
+/* ****************************************************************************************************************** *
+ * ***[ START OF MAZED_SAVE_FILE.CC ]******************************************************************************** *
+ * ****************************************************************************************************************** */
+
+
+/* ****************************************************************************************************************** *
+ ~ ~~~[ HEADER FILES ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ ~
+ * ****************************************************************************************************************** */
+
+#include <cstddef>
+#include <cstring>
+#include <vector>
+
+#include "mazed_maze_file.hh"
+#include "mazed_save_file.hh"
+
+
+/* ****************************************************************************************************************** *
+ ~ ~~~[ MEMBER FUNCTIONS IMPLEMENTATIONS ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ ~
+ * ****************************************************************************************************************** */
+
+namespace mazed {
+
+  // The checksum covers everything behind itself, the rest of the header included:
+  const std::size_t save_file::CHECKED_OFFSET = offsetof(save_file::header, checksum) + sizeof(std::uint32_t);
+
+  // // // // // // // // // // //
+
+  /**
+   * Encodes the snapshot of the game as the binary save file.
+   *
+   * @return  Content of the save file.
+   */
+  std::string save_file::encode(const game::snapshot &state)
+  {{{
+    std::vector<unsigned char> payload(state.maze_name.begin(), state.maze_name.end());
+    payload.insert(payload.end(), state.game_owner.begin(), state.game_owner.end());
+
+    const std::vector<game::snapshot::coords_t> *lists[] = {&state.keys, &state.gates_open, &state.guardians};
+    std::vector<game::snapshot::coords_t>::const_iterator it_coords;
+
+    for (unsigned i = 0; i < sizeof(lists) / sizeof(lists[0]); i++) {
+      for (it_coords = lists[i]->begin(); it_coords != lists[i]->end(); it_coords++) {
+        payload.push_back((*it_coords).first);
+        payload.push_back((*it_coords).second);
+      }
+    }
+
+    header save_header;
+
+    std::memcpy(save_header.magic, "MAZS", sizeof(save_header.magic));
+    save_header.players_mask = 0;
+
+    for (unsigned i = 0; i < GAME_MAX_PLAYERS; i++) {
+      const game::snapshot::player_state &player = state.players[i];
+
+      if (player.present == false) {
+        continue;
+      }
+
+      std::size_t nick_length = (player.nick.size() > 255) ? 255 : player.nick.size();
+
+      save_header.players_mask |= 1U << i;
+      payload.push_back(nick_length);
+      payload.insert(payload.end(), player.nick.begin(), player.nick.begin() + nick_length);
+      payload.push_back(player.coords.first);
+      payload.push_back(player.coords.second);
+      payload.push_back(player.lifes);
+      payload.push_back((player.has_key == true) ? 1 : 0);
+    }
+
+    save_header.format = SAVE_FORMAT;
+    save_header.checksum = 0;
+    save_header.maze_fingerprint = state.maze_fingerprint;
+    save_header.ticks = state.ticks;
+    save_header.game_speed = state.game_speed;
+    save_header.maze_name_length = state.maze_name.size();
+    save_header.owner_length = state.game_owner.size();
+    save_header.keys_num = state.keys.size();
+    save_header.gates_num = state.gates_open.size();
+    save_header.guardians_num = state.guardians.size();
+    save_header.reserved = 0;
+
+    std::string content(reinterpret_cast<const char *>(&save_header), sizeof(save_header));
+    content.append(reinterpret_cast<const char *>(payload.data()), payload.size());
+
+    save_header.checksum = maze_file::checksum(reinterpret_cast<const unsigned char *>(content.data()) + CHECKED_OFFSET,
+                                               content.size() - CHECKED_OFFSET);
+    content.replace(offsetof(header, checksum), sizeof(save_header.checksum),
+                    reinterpret_cast<const char *>(&save_header.checksum), sizeof(save_header.checksum));
+
+    return content;
+  }}}
+
+
+  /**
+   * Decodes the save file. Only the format is checked here, the coordinates are checked against the maze when the game
+   * is restored.
+   *
+   * @return  true if the save file is valid, false otherwise.
+   */
+  bool save_file::decode(const std::string &content, game::snapshot &state)
+  {{{
+    static_assert(sizeof(header) == 40, "header of the save file has to be packed");
+
+    header save_header;
+
+    if (content.size() < sizeof(save_header)) {
+      return false;
+    }
+
+    std::memcpy(&save_header, content.data(), sizeof(save_header));
+
+    const unsigned char *p_data = reinterpret_cast<const unsigned char *>(content.data()) + sizeof(save_header);
+    std::size_t length = content.size() - sizeof(save_header);
+
+    if (std::memcmp(save_header.magic, "MAZS", sizeof(save_header.magic)) != 0 || save_header.format != SAVE_FORMAT ||
+        maze_file::checksum(reinterpret_cast<const unsigned char *>(content.data()) + CHECKED_OFFSET,
+                            content.size() - CHECKED_OFFSET) != save_header.checksum) {
+      return false;
+    }
+
+    std::size_t coords_num = save_header.keys_num + save_header.gates_num + save_header.guardians_num;
+
+    if (length < save_header.maze_name_length + save_header.owner_length + coords_num * 2) {
+      return false;
+    }
+
+    state.maze_name.assign(reinterpret_cast<const char *>(p_data), save_header.maze_name_length);
+    p_data += save_header.maze_name_length;
+    state.game_owner.assign(reinterpret_cast<const char *>(p_data), save_header.owner_length);
+    p_data += save_header.owner_length;
+
+    std::vector<game::snapshot::coords_t> *lists[] = {&state.keys, &state.gates_open, &state.guardians};
+    std::size_t counts[] = {save_header.keys_num, save_header.gates_num, save_header.guardians_num};
+
+    for (unsigned i = 0; i < sizeof(lists) / sizeof(lists[0]); i++) {
+      lists[i]->clear();
+
+      for (std::size_t j = 0; j < counts[i]; j++, p_data += 2) {
+        lists[i]->emplace_back(p_data[0], p_data[1]);
+      }
+    }
+
+    const unsigned char *p_end = reinterpret_cast<const unsigned char *>(content.data()) + content.size();
+
+    for (unsigned i = 0; i < GAME_MAX_PLAYERS; i++) {
+      game::snapshot::player_state &player = state.players[i];
+
+      player = game::snapshot::player_state();
+
+      if ((save_header.players_mask & (1U << i)) == 0) {
+        continue;
+      }
+
+      if (p_data >= p_end || p_end - p_data < 1 + p_data[0] + 4) {
+        return false;
+      }
+
+      player.present = true;
+      player.nick.assign(reinterpret_cast<const char *>(p_data + 1), p_data[0]);
+      p_data += 1 + p_data[0];
+      player.coords = game::snapshot::coords_t(p_data[0], p_data[1]);
+      player.lifes = p_data[2];
+      player.has_key = (p_data[3] != 0);
+      p_data += 4;
+    }
+
+    state.maze_fingerprint = save_header.maze_fingerprint;
+    state.ticks = save_header.ticks;
+    state.game_speed = save_header.game_speed;
+
+    return p_data == p_end;
+  }}}
+}
+
+/* ****************************************************************************************************************** *
+ * ***[ END OF MAZED_SAVE_FILE.CC ]********************************************************************************** *
+ * ****************************************************************************************************************** */
+
@@ -0,0 +1,73 @@
+/**
+ * @file      mazed_save_file.hh
+ * @author    Dee'Kej (David Kaspar - xkaspa34)
+ * @version   0.1
+ * @brief     Contains declaration of the encoder & decoder of the binary save files.
+ */
+
+
+/* ****************************************************************************************************************** *
+ * ***[ START OF MAZED_SAVE_FILE.HH ]******************************************************************************** *
+ * ****************************************************************************************************************** */
+
+#ifndef H_GUARD_MAZED_SAVE_FILE_HH
+#define H_GUARD_MAZED_SAVE_FILE_HH
+
+
+/* ****************************************************************************************************************** *
+ ~ ~~~[ HEADER FILES ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ ~
+ * ****************************************************************************************************************** */
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "mazed_game_snapshot.hh"
+
+
+/* ****************************************************************************************************************** *
+ ~ ~~~[ SAVE_FILE CLASS ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ ~
+ * ****************************************************************************************************************** */
+
+namespace mazed {
+
+  #define SAVE_FORMAT           1U          // Version of the save format.
+
+  /**
+   * Binary save file of the game. Only the mutable state of the game is saved, the maze is referred by its name and by
+   * the fingerprint of its layout, so the game is restored from the cached maze template and the save can't be loaded
+   * into the maze which has changed since. Written in the native byte order with a checksum, as the compiled maze.
+   */
+  class save_file {
+      // Header of the save, followed by the sections in this order: maze name, game owner, keys, open gates, guardians
+      // and the players of the players_mask. Coordinates are stored as 2 bytes (row, column), every player as the nick
+      // length (1 byte), the nick, the coordinates, lifes and has_key (1 byte each).
+      struct header {
+        char                                        magic[4];
+        std::uint32_t                               format;
+        std::uint32_t                               checksum;       // FNV-1a of everything behind the checksum.
+        std::uint32_t                               maze_fingerprint;
+        std::uint64_t                               ticks;
+        std::int32_t                                game_speed;
+        std::uint16_t                               maze_name_length;
+        std::uint16_t                               owner_length;
+        std::uint16_t                               keys_num;
+        std::uint16_t                               gates_num;
+        std::uint16_t                               guardians_num;
+        std::uint8_t                                players_mask;   // Bit N is set for the player N saved.
+        std::uint8_t                                reserved;
+      };
+
+      static const std::size_t                      CHECKED_OFFSET;
+
+    public:
+      static std::string encode(const game::snapshot &state);
+      static bool decode(const std::string &content, game::snapshot &state);
+  };
+}
+
+/* ****************************************************************************************************************** *
+ * ***[ END OF MAZED_SAVE_FILE.HH ]********************************************************************************** *
+ * ****************************************************************************************************************** */
+
+#endif
@@ -39,6 +39,7 @@ namespace mazed {
   server::server(boost::asio::io_service &io_service, mazed::settings_tuple &settings) :
     io_service_(io_service),
     signals_(io_service, SIGINT, SIGTERM),
+    acceptor_(io_service),
     settings_(settings)
   {{{
     // Create a formatting object for the date_time_str():
@@ -52,6 +53,9 @@ namespace mazed {
 
   server::~server()
   {{{
+    // The saves being written are finished and logged yet:
+    ps_shared_res_->p_save_engine.reset();
+
     log(mazed::log_level::INFO, "Server has STOPPED");
     log_file_.close();
     return;
@@ -66,17 +70,34 @@ namespace mazed {
    */
   void server::run()
   {{{
-    chdir(std::get<mazed::LOG_FOLDER>(settings_).c_str());
-    log_file_.open(std::get<mazed::SERVER_LOG_FILE>(settings_), std::ofstream::out | std::ofstream::app);
+    log_file_.open(std::get<mazed::LOG_FOLDER>(settings_) + "/" + std::get<mazed::SERVER_LOG_FILE>(settings_),
+                   std::ofstream::out | std::ofstream::app);
 
     if (std::get<mazed::LOGGING_LEVEL>(settings_) != mazed::log_level::NONE) {
       log_file_ << "----------------------------" << std::endl;
     }
 
     log(mazed::log_level::INFO, "Server is RUNNING");
+
+    std::pair<std::size_t, std::size_t> players = ps_shared_res_->p_players_store->stats();
+    std::string players_str = "Players store: " + std::to_string(players.first) + " players, " +
+                              std::to_string(players.second) + " records";
+    log(mazed::log_level::INFO, players_str.c_str());
+
+    // Scheduler's & save engine's threads are created here, they wouldn't survive the forking of the daemon:
+    ps_shared_res_->p_scheduler = std::unique_ptr<game::scheduler>(
+      new game::scheduler(std::get<mazed::GAME_THREADS>(settings_)));
+    ps_shared_res_->p_save_engine = std::unique_ptr<mazed::save_engine>(
+      new mazed::save_engine(ps_shared_res_->p_mazes_manager->get_saves_fd(),
+                             boost::bind(&server::log, this, _1, _2)));
     
     signals_.async_wait(boost::bind(&server::signals_handler, this));
 
+    if (std::get<mazed::IO_THREADS>(settings_) > 0) {
+      run_pool();
+      return;
+    }
+
     boost::thread           thread_starter_loop(boost::bind(&server::thread_starter, this));
     boost::thread_guard<>   thread_starter_guard(thread_starter_loop);
     io_service_.run();
@@ -85,6 +106,101 @@ namespace mazed {
   }}}
 
 
+  /**
+   * Runs the server with one long-lived acceptor, which is serviced by the fixed-size pool of threads running the
+   * shared io_service. The calling thread is used as one of the pool's threads.
+   */
+  void server::run_pool()
+  {{{
+    tcp::endpoint endpoint(tcp::v4(), std::get<mazed::SERVER_PORT>(settings_));
+
+    acceptor_.open(endpoint.protocol());
+    acceptor_.set_option(tcp::acceptor::reuse_address(true));
+    acceptor_.bind(endpoint);
+    acceptor_.listen();
+
+    start_accept();
+
+    for (unsigned i = 1; i < std::get<mazed::IO_THREADS>(settings_); i++) {
+      io_threads_.create_thread(boost::bind(&asio::io_service::run, &io_service_));
+    }
+
+    io_service_.run();
+    io_threads_.join_all();
+
+    return;
+  }}}
+
+
+  /**
+   * Starts asynchronous accept of next connection on the shared acceptor. The connection is accepted directly into the
+   * socket of a new server_connection instance.
+   */
+  void server::start_accept()
+  {{{
+    pu_pending_connect_ = std::unique_ptr<mazed::server_connection>(new mazed::server_connection(settings_, this,
+                                                                                                 connect_ID_++,
+                                                                                                 io_service_));
+
+    acceptor_.async_accept(pu_pending_connect_->socket(), boost::bind(&server::handle_accept, this, _1));
+    return;
+  }}}
+
+
+  /**
+   * Handler of the shared acceptor. Starts servicing of the accepted connection and starts accepting again immediately.
+   * The connection is serviced by the shared io_service, no thread is dedicated to it.
+   */
+  void server::handle_accept(const boost::system::error_code &error)
+  {{{
+    if (error == asio::error::operation_aborted) {
+      return;                                   // Acceptor has been closed, the server is stopping.
+    }
+
+    if (error) {
+      log(mazed::log_level::ERROR, error.message().c_str());
+    }
+    else {
+      log_connect_new(pu_pending_connect_->connect_ID_);
+
+      mazed::server_connection *p_connect = pu_pending_connect_.get();
+
+      sessions_mutex_.lock();
+      {
+        sessions_[p_connect->connect_ID_] = std::move(pu_pending_connect_);
+      }
+      sessions_mutex_.unlock();
+
+      p_connect->serve();
+    }
+
+    start_accept();
+    return;
+  }}}
+
+
+  /**
+   * Called by the client handler of the connection when the client has been serviced. The connection is destroyed.
+   */
+  void server::session_finished(unsigned connect_ID)
+  {{{
+    std::unique_ptr<mazed::server_connection> pu_connect;
+
+    sessions_mutex_.lock();
+    {
+      std::map<unsigned, std::unique_ptr<mazed::server_connection>>::iterator it = sessions_.find(connect_ID);
+
+      if (it != sessions_.end()) {
+        pu_connect = std::move(it->second);
+        sessions_.erase(it);
+      }
+    }
+    sessions_mutex_.unlock();
+
+    return;                             // The connection is destroyed outside of the critical section.
+  }}}
+
+
   /**
    * Member function for starting of accepting new connection after the previous one was established.
    */
@@ -136,6 +252,9 @@ namespace mazed {
     }
     run_mutex_.unlock();
 
+    boost::system::error_code ignored_error;
+    acceptor_.close(ignored_error);
+
     io_service_.stop();
     return;
   }}}
@@ -21,6 +21,7 @@
 #include <fstream>
 #include <list>
 #include <locale>
+#include <map>
 #include <memory>
 #include <string>
 #include <utility>
@@ -40,6 +41,7 @@
  * ****************************************************************************************************************** */
 
 namespace asio = boost::asio;
+using     tcp = boost::asio::ip::tcp;
 
 namespace mazed {
   class server_connection;
@@ -52,6 +54,15 @@ namespace mazed {
 
       asio::io_service                            &io_service_;
       asio::signal_set                            signals_;
+
+      // Shared acceptor & threads running the io_service, used only when the IO_THREADS setting is non-zero:
+      tcp::acceptor                               acceptor_;
+      boost::thread_group                         io_threads_;
+      std::unique_ptr<mazed::server_connection>   pu_pending_connect_;
+
+      // Connections being serviced by the shared io_service, indexed by their connect_ID:
+      std::map<unsigned, std::unique_ptr<mazed::server_connection>> sessions_;
+      boost::mutex                                sessions_mutex_;
       
       boost::condition_variable                   new_connection_;
       boost::mutex                                connection_mutex_;
@@ -78,6 +89,11 @@ namespace mazed {
       void thread_starter();
       void connection_thread();
 
+      void run_pool();
+      void start_accept();
+      void handle_accept(const boost::system::error_code &error);
+      void session_finished(unsigned connect_ID);
+
       void signals_handler();
 
       inline std::string date_time_str();
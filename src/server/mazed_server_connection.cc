@@ -28,8 +28,9 @@ using     tcp = boost::asio::ip::tcp;
 
 namespace mazed {
   server_connection::server_connection(mazed::settings_tuple &settings, mazed::server *p_server_instance) :
+    session_io_service_(io_service_),
     socket_(io_service_),
-    acceptor_(io_service_, ip::tcp::endpoint(ip::tcp::v4(), std::get<SERVER_PORT>(settings))),
+    pu_acceptor_(new tcp::acceptor(io_service_, ip::tcp::endpoint(ip::tcp::v4(), std::get<SERVER_PORT>(settings)))),
     settings_(settings),
     p_server_{p_server_instance},
     connect_ID_{p_server_instance->connect_ID_}
@@ -38,6 +39,22 @@ namespace mazed {
   }}}
 
 
+  /**
+   * Constructor for connection accepted by the server's shared acceptor. No acceptor is created, the socket is expected
+   * to be passed to the shared acceptor via socket() member function. The socket is bound to given io_service.
+   */
+  server_connection::server_connection(mazed::settings_tuple &settings, mazed::server *p_server_instance,
+                                       unsigned connect_ID, asio::io_service &io_service) :
+    session_io_service_(io_service),
+    socket_(io_service),
+    settings_(settings),
+    p_server_{p_server_instance},
+    connect_ID_{connect_ID}
+  {{{
+    return;
+  }}}
+
+
   server_connection::~server_connection()
   {{{
     io_service_.stop();                         // Making sure the io_service has been stopped in case of signal.
@@ -59,12 +76,35 @@ namespace mazed {
   }}}
 
 
+  /**
+   * Starts servicing of the connection already accepted by the server's shared acceptor. It doesn't block, the server
+   * is notified by session_finished() when the client has been serviced.
+   */
+  void server_connection::serve()
+  {{{
+    p_handler_ = new mazed::client_handler(socket_, session_io_service_, settings_, p_server_->ps_shared_res_,
+                                           connect_ID_, boost::bind(&server::session_finished, p_server_, connect_ID_));
+    p_handler_->run();
+
+    return;
+  }}}
+
+
+  /**
+   * @return Socket of this connection, to be used for accepting by the server's shared acceptor.
+   */
+  tcp::socket &server_connection::socket()
+  {{{
+    return socket_;
+  }}}
+
+
   /**
    *  Starts accepting (listening) on given port of actual socket.
    */
   void server_connection::start_accept()
   {{{
-    acceptor_.async_accept(socket_, boost::bind(&server_connection::handle_accept, this, _1));
+    pu_acceptor_->async_accept(socket_, boost::bind(&server_connection::handle_accept, this, _1));
     return;
   }}}
 
@@ -75,7 +115,7 @@ namespace mazed {
    */
   void server_connection::handle_accept(const boost::system::error_code &error)
   {{{
-    acceptor_.close();  // We don't want to accept more connections on current socket.
+    pu_acceptor_->close();  // We don't want to accept more connections on current socket.
 
     if (error) {
       // Error occurred, log the problem and notify the server to start listening again:
@@ -18,6 +18,8 @@
  ~ ~~~[ HEADER FILES ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ ~
  * ****************************************************************************************************************** */
 
+#include <memory>
+
 #include <boost/asio.hpp>
 #include <boost/bind.hpp>
 
@@ -37,25 +39,35 @@ namespace mazed {
   class server;                         // Declaration needed because of the cross-references.
   
   /**
-   *  This is friend class of mazed::server class used for each client's connection.
+   *  This is friend class of mazed::server class used for each client's connection. It either accepts the connection
+   *  itself with its own acceptor, or it is given an already accepted socket by the server's shared acceptor. In the
+   *  latter case the connection is serviced by the server's shared io_service.
    */
   class server_connection {
+      friend class mazed::server;
+
       asio::io_service                  io_service_;
+      asio::io_service                  &session_io_service_;       // io_service the client is serviced by.
       tcp::socket                       socket_;
-      tcp::acceptor                     acceptor_;
+      std::unique_ptr<tcp::acceptor>    pu_acceptor_;
 
       mazed::settings_tuple             &settings_;
       mazed::server                     *p_server_;
 
-      mazed::client_handler             *p_handler_;
+      mazed::client_handler             *p_handler_ {NULL};
 
       unsigned connect_ID_;
 
     public:
        server_connection(mazed::settings_tuple &settings, mazed::server *server_instance);
+       server_connection(mazed::settings_tuple &settings, mazed::server *server_instance, unsigned connect_ID,
+                         asio::io_service &io_service);
       ~server_connection();
 
       void run();
+      void serve();
+
+      tcp::socket &socket();
 
     private:
       void start_accept();
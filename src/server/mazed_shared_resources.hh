@@ -20,11 +20,13 @@
 
 #include <memory>
 
-#include <boost/thread.hpp>
-
 #include "mazed_globals.hh"
 #include "mazed_mazes_manager.hh"
+#include "mazed_players_store.hh"
 #include "mazed_game_instance.hh"
+#include "mazed_games_registry.hh"
+#include "mazed_game_scheduler.hh"
+#include "mazed_save_engine.hh"
 
 
 /* ****************************************************************************************************************** *
@@ -41,15 +43,19 @@ namespace mazed {
    */
   class shared_resources {
     public:
-      boost::mutex                                access_mutex;
       std::unique_ptr<mazed::mazes_manager>       p_mazes_manager;
-      std::list<std::shared_ptr<game::instance>>  game_instances;
+      std::unique_ptr<mazed::players_store>       p_players_store;
+      std::unique_ptr<game::scheduler>            p_scheduler;          // Created in server::run(), outlives games.
+      std::unique_ptr<mazed::save_engine>         p_save_engine;        // Created in server::run().
+      std::unique_ptr<mazed::games_registry>      p_games_registry;     // Owns the running game instances.
       
       // // // // // // // // // // //
 
       shared_resources(mazed::settings_tuple settings)
       {{{
         p_mazes_manager = std::unique_ptr<mazed::mazes_manager>(new mazed::mazes_manager(settings));
+        p_players_store = std::unique_ptr<mazed::players_store>(new mazed::players_store(settings));
+        p_games_registry = std::unique_ptr<mazed::games_registry>(new mazed::games_registry());
 
         return;
       }}}
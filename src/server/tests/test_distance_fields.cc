@@ -0,0 +1,148 @@
+/**
+ * @file      test_distance_fields.cc
+ * @author    Dee'Kej (David Kaspar - xkaspa34)
+ * @version   0.1
+ * @brief     Test of the repair of the cached distance fields.
+ *
+ * @detailed  Random blocks of random mazes are blocked & opened again, the cached fields are repaired after every
+ *            change the same way as the maze::block_set() does it, and they're compared with the fields computed by
+ *            a fresh BFS afterwards.
+ */
+
+/* ****************************************************************************************************************** *
+ * ***[ START OF TEST_DISTANCE_FIELDS.CC ]*************************************************************************** *
+ * ****************************************************************************************************************** */
+
+
+/* ****************************************************************************************************************** *
+ ~ ~~~[ HEADER FILES ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ ~
+ * ****************************************************************************************************************** */
+
+// C++ header files:
+#include <iostream>
+#include <memory>
+#include <vector>
+
+// Program header files:
+#include "../mazed_game_bitboard.hh"
+#include "../mazed_game_distance_fields.hh"
+
+
+/* ****************************************************************************************************************** *
+ ~ ~~~[ GLOBAL VARIABLES ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ ~
+ * ****************************************************************************************************************** */
+
+const unsigned MAZES_NUM      = 50;     // Number of random mazes tested.
+const unsigned CHANGES_NUM    = 200;    // Number of blocks changed within one maze.
+const unsigned TARGETS_NUM    = 8;      // Number of fields cached by one maze.
+
+unsigned random_state {2463534242U};    // Xorshift, so the test is same for every run.
+
+
+/* ****************************************************************************************************************** *
+ ~ ~~~[ AUXILIARY FUNCTIONS ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ ~
+ * ****************************************************************************************************************** */
+
+unsigned random_number(unsigned limit)
+{{{
+  random_state ^= random_state << 13;
+  random_state ^= random_state >> 17;
+  random_state ^= random_state << 5;
+
+  return random_state % limit;
+}}}
+
+
+/**
+ * Tests one random maze of given size.
+ *
+ * @return  Number of fields, which differ from the fresh BFS.
+ */
+unsigned test_maze(signed char rows_num, signed char cols_num)
+{{{
+  game::bitboard blocked;
+  game::bitboard targets_board;
+  game::distance_fields cached(rows_num, cols_num);
+  std::vector<std::pair<signed char, signed char>> targets;
+  std::vector<std::pair<signed char, signed char>>::iterator it_targets;
+  unsigned failures {0};
+
+  for (unsigned i = 0; i < TARGETS_NUM; i++) {
+    targets.emplace_back(random_number(rows_num), random_number(cols_num));
+    targets_board.set(targets.back().first, targets.back().second);
+  }
+
+  // Roughly third of the maze is blocked at the beginning, the targets are never blocked:
+  for (signed char row = 0; row < rows_num; row++) {
+    for (signed char col = 0; col < cols_num; col++) {
+      if (random_number(3) == 0 && targets_board.test(row, col) == false) {
+        blocked.set(row, col);
+      }
+    }
+  }
+
+  for (it_targets = targets.begin(); it_targets != targets.end(); it_targets++) {
+    cached.get(blocked, *it_targets);
+  }
+
+  for (unsigned i = 0; i < CHANGES_NUM; i++) {
+    std::pair<signed char, signed char> coords(random_number(rows_num), random_number(cols_num));
+
+    if (targets_board.test(coords.first, coords.second) == true) {
+      continue;
+    }
+
+    if (blocked.test(coords.first, coords.second) == true) {
+      blocked.reset(coords.first, coords.second);
+    }
+    else {
+      blocked.set(coords.first, coords.second);
+    }
+
+    cached.repair(blocked, coords);
+
+    game::distance_fields fresh(rows_num, cols_num);
+
+    for (it_targets = targets.begin(); it_targets != targets.end(); it_targets++) {
+      if (*cached.get(blocked, *it_targets) != *fresh.get(blocked, *it_targets)) {
+        std::cerr << "test_distance_fields: " << int(rows_num) << "x" << int(cols_num) << " maze, change " << i
+                  << " at [" << int(coords.first) << ", " << int(coords.second) << "]: field of the target ["
+                  << int((*it_targets).first) << ", " << int((*it_targets).second) << "] differs" << std::endl;
+        failures++;
+      }
+    }
+
+    if (failures > 0) {
+      break;
+    }
+  }
+
+  return failures;
+}}}
+
+
+/* ****************************************************************************************************************** *
+ ~ ~~~[ MAIN FUNCTION ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ ~
+ * ****************************************************************************************************************** */
+
+int main()
+{{{
+  unsigned failures {0};
+
+  for (unsigned i = 0; i < MAZES_NUM; i++) {
+    failures += test_maze(2 + random_number(30), 2 + random_number(30));
+  }
+
+  if (failures > 0) {
+    std::cerr << "test_distance_fields: FAILED" << std::endl;
+    return 1;
+  }
+
+  std::cout << "test_distance_fields: " << MAZES_NUM << " mazes, " << MAZES_NUM * CHANGES_NUM << " changes: OK"
+            << std::endl;
+  return 0;
+}}}
+
+/* ****************************************************************************************************************** *
+ * ***[ END OF TEST_DISTANCE_FIELDS.CC ]***************************************************************************** *
+ * ****************************************************************************************************************** */
@@ -0,0 +1,238 @@
+/**
+ * @file      test_games_registry.cc
+ * @author    Dee'Kej (David Kaspar - xkaspa34)
+ * @version   0.1
+ * @brief     Concurrency stress test of the sharded games_registry.
+ *
+ * @detailed  Several threads add, change & remove the games (as the CREATE_GAME, JOIN_GAME & TERMINATE_GAME do),
+ *            while other threads keep reading the registry without any locking (as the LIST_RUNNING & JOIN_GAME do).
+ *            Every game listed has to be consistent and found in its shard, and the game removed has to be never found
+ *            again. The instances of the games aren't used by the registry, so they're only the unique addresses.
+ */
+
+/* ****************************************************************************************************************** *
+ * ***[ START OF TEST_GAMES_REGISTRY.CC ]**************************************************************************** *
+ * ****************************************************************************************************************** */
+
+
+/* ****************************************************************************************************************** *
+ ~ ~~~[ HEADER FILES ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ ~
+ * ****************************************************************************************************************** */
+
+// C++ header files:
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Boost header files:
+#include <boost/bind.hpp>
+#include <boost/thread.hpp>
+
+// Program header files:
+#include "../mazed_games_registry.hh"
+
+
+/* ****************************************************************************************************************** *
+ ~ ~~~[ GLOBAL VARIABLES ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ ~
+ * ****************************************************************************************************************** */
+
+const unsigned WRITERS_NUM    = 4;      // Number of threads adding & removing the games.
+const unsigned READERS_NUM    = 4;      // Number of threads reading the registry.
+const unsigned ITERATIONS_NUM = 5000;   // Number of games added by every writer.
+const unsigned WINDOW_SIZE    = 64;     // Number of games kept by every writer, so the shards' tables are growing.
+
+std::atomic<unsigned>       failures {0};
+std::atomic<bool>           writers_done {false};
+std::atomic<unsigned long>  snapshots_read {0};
+
+
+/* ****************************************************************************************************************** *
+ ~ ~~~[ AUXILIARY FUNCTIONS ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ ~
+ * ****************************************************************************************************************** */
+
+void fail(const std::string &reason)
+{{{
+  std::cerr << "test_games_registry: " << reason << std::endl;
+  failures++;
+  return;
+}}}
+
+
+/**
+ * Releases the placeholder of the game instance, which is never constructed.
+ */
+struct instance_deleter {
+  void operator()(game::instance *p_instance)
+  {{{
+    delete reinterpret_cast<char *>(p_instance);
+    return;
+  }}}
+};
+
+
+std::shared_ptr<game::instance> instance_create()
+{{{
+  return std::shared_ptr<game::instance>(reinterpret_cast<game::instance *>(new char), instance_deleter());
+}}}
+
+
+/**
+ * Removes the game & checks it's never found again.
+ */
+void game_remove(mazed::games_registry *p_registry, const std::pair<std::string, std::shared_ptr<game::instance>> &game)
+{{{
+  if (p_registry->remove(game.first) != game.second) {
+    fail(game.first + " wasn't removed");
+  }
+
+  if (p_registry->find(game.first) || p_registry->remove(game.first)) {
+    fail(game.first + " is found after its removal");
+  }
+
+  return;
+}}}
+
+
+/**
+ * Adds the games, changes their players & status and removes them, keeping at most WINDOW_SIZE games at once.
+ */
+void writer(mazed::games_registry *p_registry)
+{{{
+  std::deque<std::pair<std::string, std::shared_ptr<game::instance>>> games;
+
+  for (unsigned i = 0; i < ITERATIONS_NUM; i++) {
+    if (games.size() == WINDOW_SIZE) {
+      game_remove(p_registry, games.front());
+      games.pop_front();
+    }
+
+    std::shared_ptr<game::instance> ps_instance = instance_create();
+    std::string uid = p_registry->add(ps_instance, "test.maze", std::vector<std::string> {"owner"});
+
+    if (p_registry->find(uid) != ps_instance) {
+      fail(uid + " isn't found after its adding");
+    }
+
+    p_registry->set_players(uid, std::vector<std::string> {"owner", "player"});
+    p_registry->set_status(uid, protocol::E_game_status::RUNNING);
+
+    games.push_back(std::make_pair(uid, ps_instance));
+  }
+
+  while (games.empty() == false) {
+    game_remove(p_registry, games.front());
+    games.pop_front();
+  }
+
+  return;
+}}}
+
+
+/**
+ * Checks every game listed until the writers are done.
+ */
+void reader(mazed::games_registry *p_registry)
+{{{
+  mazed::games_registry::games_snapshot::const_iterator it_shard;
+  mazed::games_registry::games_table::const_iterator it_game;
+
+  while (writers_done == false) {
+    mazed::games_registry::games_snapshot snapshot = p_registry->get_games();
+
+    if (snapshot.size() != p_registry->get_shards_num()) {
+      fail("wrong number of the shards");
+    }
+
+    for (it_shard = snapshot.begin(); it_shard != snapshot.end(); it_shard++) {
+      for (it_game = (*it_shard)->begin(); it_game != (*it_shard)->end(); it_game++) {
+        if ((*it_game).uid == 0) {
+          continue;
+        }
+
+        if (!(*it_game).ps_info || !(*it_game).ps_instance) {
+          fail("game listed without its info or instance");
+          continue;
+        }
+
+        const protocol::game_info &info = *(*it_game).ps_info;
+
+        if (info.UID != "G" + std::to_string((*it_game).uid) || info.used_slots != info.players.size() ||
+            (*it_game).uid % p_registry->get_shards_num() != static_cast<unsigned long>(it_shard - snapshot.begin())) {
+          fail(info.UID + " is listed inconsistently");
+        }
+
+        // The game might have been removed meanwhile, but it's never replaced by another one:
+        std::shared_ptr<game::instance> ps_found = p_registry->find(info.UID);
+
+        if (ps_found && ps_found != (*it_game).ps_instance) {
+          fail(info.UID + " is found with another instance");
+        }
+      }
+    }
+
+    snapshots_read++;
+  }
+
+  return;
+}}}
+
+
+/* ****************************************************************************************************************** *
+ ~ ~~~[ MAIN FUNCTION ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ ~
+ * ****************************************************************************************************************** */
+
+int main()
+{{{
+  mazed::games_registry registry;
+  boost::thread_group writers;
+  boost::thread_group readers;
+
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+  for (unsigned i = 0; i < READERS_NUM; i++) {
+    readers.create_thread(boost::bind(reader, &registry));
+  }
+
+  for (unsigned i = 0; i < WRITERS_NUM; i++) {
+    writers.create_thread(boost::bind(writer, &registry));
+  }
+
+  writers.join_all();
+  writers_done = true;
+  readers.join_all();
+
+  long elapsed_ms = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() -
+                                                                          start).count();
+
+  // All the games have been removed:
+  mazed::games_registry::games_snapshot snapshot = registry.get_games();
+  mazed::games_registry::games_snapshot::const_iterator it_shard;
+  mazed::games_registry::games_table::const_iterator it_game;
+
+  for (it_shard = snapshot.begin(); it_shard != snapshot.end(); it_shard++) {
+    for (it_game = (*it_shard)->begin(); it_game != (*it_shard)->end(); it_game++) {
+      if ((*it_game).uid != 0) {
+        fail("G" + std::to_string((*it_game).uid) + " is left in the registry");
+      }
+    }
+  }
+
+  if (failures > 0) {
+    std::cerr << "test_games_registry: FAILED" << std::endl;
+    return 1;
+  }
+
+  std::cout << "test_games_registry: " << WRITERS_NUM << " writers, " << WRITERS_NUM * ITERATIONS_NUM
+            << " games, " << READERS_NUM << " readers, " << snapshots_read << " snapshots read in " << elapsed_ms
+            << " ms: OK" << std::endl;
+  return 0;
+}}}
+
+/* ****************************************************************************************************************** *
+ * ***[ END OF TEST_GAMES_REGISTRY.CC ]****************************************************************************** *
+ * ****************************************************************************************************************** */
@@ -0,0 +1,146 @@
+/**
+ * @file      test_maze_layout.cc
+ * @author    Dee'Kej (David Kaspar - xkaspa34)
+ * @version   0.1
+ * @brief     Test of the analysis of the maze_layout done when the maze is loaded.
+ *
+ * @detailed  Small mazes are parsed & their analysis for the 1st player is compared with the expected one.
+ */
+
+/* ****************************************************************************************************************** *
+ * ***[ START OF TEST_MAZE_LAYOUT.CC ]******************************************************************************* *
+ * ****************************************************************************************************************** */
+
+
+/* ****************************************************************************************************************** *
+ ~ ~~~[ HEADER FILES ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ ~
+ * ****************************************************************************************************************** */
+
+// C++ header files:
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Program header files:
+#include "../mazed_game_maze_layout.hh"
+#include "../mazed_maze_file.hh"
+
+
+/* ****************************************************************************************************************** *
+ ~ ~~~[ AUXILIARY FUNCTIONS ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ ~
+ * ****************************************************************************************************************** */
+
+/**
+ * Parses the 15x15 maze given by its rows, where the '.' stands for the empty block. Rows missing at the end are
+ * filled with the walls.
+ */
+game::maze_layout *maze_parse(const std::vector<std::string> &rows)
+{{{
+  std::string text = "version=1.0\nsize=15x15\n--\n";
+
+  for (std::size_t i = 0; i < 15; i++) {
+    std::string row = (i < rows.size()) ? rows[i] : "XXXXXXXXXXXXXXX";
+
+    for (std::size_t j = 0; j < row.size(); j++) {
+      text += (row[j] == '.') ? ' ' : row[j];
+      text += (j == row.size() - 1) ? '\n' : ' ';
+    }
+  }
+
+  std::istringstream maze_file(text);
+  return mazed::maze_file::parse(maze_file);
+}}}
+
+
+/**
+ * Parses the maze & compares the analysis for the 1st player with the expected one.
+ *
+ * @return  true if the analysis is as expected, false otherwise.
+ */
+bool test_maze(const std::string &name, const std::vector<std::string> &rows, bool reachable, bool solvable,
+               unsigned keys_used, int min_moves, bool verified)
+{{{
+  std::unique_ptr<game::maze_layout> pu_layout(maze_parse(rows));
+
+  if (!pu_layout) {
+    std::cerr << "test_maze_layout: " << name << ": maze couldn't be parsed" << std::endl;
+    return false;
+  }
+
+  const game::maze_layout::analysis_result &analysis = pu_layout->get_analysis(0);
+
+  if (analysis.reachable != reachable || analysis.solvable != solvable || analysis.keys_used != keys_used ||
+      analysis.min_moves != min_moves || analysis.verified != verified) {
+    std::cerr << "test_maze_layout: " << name << ": reachable " << analysis.reachable << ", solvable "
+              << analysis.solvable << ", keys used " << analysis.keys_used << ", moves " << analysis.min_moves
+              << ", verified " << analysis.verified << std::endl;
+    return false;
+  }
+
+  return true;
+}}}
+
+
+/* ****************************************************************************************************************** *
+ ~ ~~~[ MAIN FUNCTION ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ ~
+ * ****************************************************************************************************************** */
+
+int main()
+{{{
+  unsigned failures {0};
+
+  // Target reachable without any key:
+  failures += test_maze("open path", {
+    "XXXXXXXXXXXXXXX",
+    "X1..GXXXXXXXXXX",
+  }, true, true, 0, 3, true) ? 0 : 1;
+
+  // The only key opens one of two gates, the gate found last leads to a dead end:
+  failures += test_maze("two gates", {
+    "XXXXXXXXXXXXXXX",
+    "X1~GXXXXXXXXXXX",
+    "X.XXXXXXXXXXXXX",
+    "X*XXXXXXXXXXXXX",
+    "X~XXXXXXXXXXXXX",
+    "X.XXXXXXXXXXXXX",
+  }, false, true, 1, 2, true) ? 0 : 1;
+
+  // Two gates in a row, but only one key:
+  failures += test_maze("not enough keys", {
+    "XXXXXXXXXXXXXXX",
+    "X1~~GXXXXXXXXXX",
+    "X*XXXXXXXXXXXXX",
+  }, false, false, 0, -1, true) ? 0 : 1;
+
+  // Every gate leads to a dead end, there are too many orders of the keys & gates to be searched:
+  failures += test_maze("too many states", {
+    "XXXXXXXXXXXXXXX",
+    "X1............X",
+    "X*.*.*.*.*.*.*X",
+    "X.............X",
+    "X~X~X~X~X~X~X~X",
+    "X.X.X.X.X.X.X.X",
+    "XXXXXXXXXXXXXXX",
+    "XXXXXXXXXXXXXXX",
+    "XXXXXXXXXXXXXXX",
+    "XXXXXXXXXXXXXXX",
+    "XXXXXXXXXXXXXXX",
+    "XXXXXXXXXXXXXXX",
+    "XXXXXXXXXXXXXXX",
+    "XXXXXXXXXXXXXGX",
+  }, false, true, 0, -1, false) ? 0 : 1;
+
+  if (failures > 0) {
+    std::cerr << "test_maze_layout: FAILED" << std::endl;
+    return 1;
+  }
+
+  std::cout << "test_maze_layout: 4 mazes: OK" << std::endl;
+  return 0;
+}}}
+
+/* ****************************************************************************************************************** *
+ * ***[ END OF TEST_MAZE_LAYOUT.CC ]********************************************************************************* *
+ * ****************************************************************************************************************** */
@@ -0,0 +1,255 @@
+/**
+ * @file      test_mazes_manager.cc
+ * @author    Dee'Kej (David Kaspar - xkaspa34)
+ * @version   0.1
+ * @brief     Concurrency stress test of the mazes_manager.
+ *
+ * @detailed  Several threads create & delete the mazes (as the CREATE_GAME & TERMINATE_GAME do), list the mazes and
+ *            query their metadata at once, while another thread keeps replacing the maze files and creating & removing
+ *            another maze file within the same folder. Every maze created has to match its file and every listing
+ *            has to contain all the mazes, which are never removed.
+ */
+
+/* ****************************************************************************************************************** *
+ * ***[ START OF TEST_MAZES_MANAGER.CC ]***************************************************************************** *
+ * ****************************************************************************************************************** */
+
+
+/* ****************************************************************************************************************** *
+ ~ ~~~[ HEADER FILES ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ ~
+ * ****************************************************************************************************************** */
+
+// C++ header files:
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <vector>
+
+// Boost header files:
+#include <boost/bind.hpp>
+#include <boost/filesystem.hpp>
+#include <boost/thread.hpp>
+
+// Program header files:
+#include "../mazed_globals.hh"
+#include "../mazed_mazes_manager.hh"
+
+
+/* ****************************************************************************************************************** *
+ ~ ~~~[ GLOBAL VARIABLES ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ ~
+ * ****************************************************************************************************************** */
+
+const unsigned THREADS_NUM    = 4;      // Number of threads using the mazes_manager.
+const unsigned ITERATIONS_NUM = 500;    // Number of iterations of every thread.
+const unsigned MAZES_NUM      = 4;      // Number of mazes, which are never removed.
+
+std::atomic<unsigned> failures {0};
+std::atomic<bool>     workers_done {false};
+
+
+/* ****************************************************************************************************************** *
+ ~ ~~~[ AUXILIARY FUNCTIONS ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ ~
+ * ****************************************************************************************************************** */
+
+void fail(const std::string &reason)
+{{{
+  std::cerr << "test_mazes_manager: " << reason << std::endl;
+  failures++;
+  return;
+}}}
+
+
+std::string maze_name(unsigned maze_num)
+{{{
+  return "stable_" + std::to_string(maze_num) + ".maze";
+}}}
+
+
+/**
+ * @return  Text of the valid maze with the given size, bordered by the walls with the players in its corners.
+ */
+std::string maze_text(unsigned size)
+{{{
+  std::string text = "version=1.0\nsize=" + std::to_string(size) + "x" + std::to_string(size) + "\n--\n";
+
+  for (unsigned row = 0; row < size; row++) {
+    for (unsigned col = 0; col < size; col++) {
+      char block = (row == 0 || col == 0 || row == size - 1 || col == size - 1) ? 'X' : ' ';
+
+      if (row == 1 && col == 1) {
+        block = '1';
+      }
+      else if (row == 1 && col == size - 2) {
+        block = '2';
+      }
+      else if (row == size - 2 && col == 1) {
+        block = '3';
+      }
+      else if (row == size - 2 && col == size - 2) {
+        block = '4';
+      }
+      else if (row == size / 2 && col == size / 2) {
+        block = 'G';
+      }
+      else if (row == 2 && col == size / 2) {
+        block = '@';
+      }
+
+      text += block;
+      text += (col == size - 1) ? '\n' : ' ';
+    }
+  }
+
+  return text;
+}}}
+
+
+/**
+ * Writes the maze aside first & renames it then, so the half-written maze is never seen by the mazes_manager.
+ */
+void write_maze(const boost::filesystem::path &folder, const std::string &name, unsigned size)
+{{{
+  boost::filesystem::path tmp_path = folder / (name + ".tmp");
+
+  {
+    std::ofstream maze_file(tmp_path.string());
+    maze_file << maze_text(size);
+  }
+
+  boost::filesystem::rename(tmp_path, folder / name);
+  return;
+}}}
+
+
+/**
+ * Creates & deletes the mazes, lists them & queries their metadata.
+ */
+void worker(mazed::mazes_manager *p_manager, unsigned worker_num)
+{{{
+  mazed::mazes_manager::mazes_filter filter;
+  std::vector<std::string> page;
+
+  filter.name = "stable_";
+
+  for (unsigned i = 0; i < ITERATIONS_NUM; i++) {
+    unsigned maze_num = (worker_num + i) % MAZES_NUM;
+    std::unique_ptr<game::maze> pu_maze(p_manager->load_maze(maze_name(maze_num)));
+
+    if (!pu_maze) {
+      fail(maze_name(maze_num) + " couldn't be loaded");
+    }
+    else if (pu_maze->get_rows() != static_cast<signed char>(MAZE_MIN_SIZE + maze_num)) {
+      fail(maze_name(maze_num) + " has wrong size");
+    }
+
+    pu_maze.reset();
+
+    std::vector<std::string> mazes = p_manager->list_mazes();
+
+    for (unsigned j = 0; j < MAZES_NUM; j++) {
+      if (std::find(mazes.begin(), mazes.end(), maze_name(j)) == mazes.end()) {
+        fail(maze_name(j) + " is missing in the listing");
+      }
+    }
+
+    page.clear();
+
+    if (p_manager->query_mazes(filter, page) != MAZES_NUM) {
+      fail("wrong number of the mazes queried");
+    }
+  }
+
+  return;
+}}}
+
+
+/**
+ * Replaces the mazes & creates & removes another maze until the workers are done.
+ */
+void writer(boost::filesystem::path folder)
+{{{
+  unsigned i {0};
+
+  while (workers_done == false) {
+    unsigned maze_num = i % MAZES_NUM;
+
+    write_maze(folder, maze_name(maze_num), MAZE_MIN_SIZE + maze_num);
+    write_maze(folder, "volatile.maze", MAZE_MIN_SIZE + i % 2);
+    boost::filesystem::remove(folder / "volatile.maze");
+
+    i++;
+  }
+
+  return;
+}}}
+
+
+/* ****************************************************************************************************************** *
+ ~ ~~~[ MAIN FUNCTION ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ ~
+ * ****************************************************************************************************************** */
+
+int main()
+{{{
+  char folder_template[] = "/tmp/test_mazes_XXXXXX";
+
+  if (mkdtemp(folder_template) == NULL) {
+    std::perror("test_mazes_manager: mkdtemp");
+    return 1;
+  }
+
+  boost::filesystem::path folder(folder_template);
+
+  try {
+    for (unsigned i = 0; i < MAZES_NUM; i++) {
+      write_maze(folder, maze_name(i), MAZE_MIN_SIZE + i);
+    }
+
+    mazed::settings_tuple settings;
+
+    std::get<mazed::DAEMON_FOLDER>(settings) = folder;
+    std::get<mazed::MAZES_FOLDER>(settings) = ".";
+    std::get<mazed::MAZES_EXTENSION>(settings) = ".maze";
+    std::get<mazed::SAVES_FOLDER>(settings) = ".";
+    std::get<mazed::SAVES_EXTENSION>(settings) = ".save";
+
+    mazed::mazes_manager manager(settings);
+    boost::thread_group workers;
+    boost::thread writer_thread(boost::bind(writer, folder));
+
+    for (unsigned i = 0; i < THREADS_NUM; i++) {
+      workers.create_thread(boost::bind(worker, &manager, i));
+    }
+
+    workers.join_all();
+    workers_done = true;
+    writer_thread.join();
+
+    std::pair<unsigned long, unsigned long> stats = manager.templates_stats();
+
+    boost::filesystem::remove_all(folder);
+
+    if (failures > 0) {
+      std::cerr << "test_mazes_manager: FAILED" << std::endl;
+      return 1;
+    }
+
+    std::cout << "test_mazes_manager: " << THREADS_NUM << " threads, " << THREADS_NUM * ITERATIONS_NUM
+              << " mazes created (" << stats.first << " cache hits, " << stats.second << " misses): OK" << std::endl;
+    return 0;
+  }
+  catch (const std::exception &e) {
+    std::cerr << "test_mazes_manager: " << e.what() << std::endl;
+    boost::filesystem::remove_all(folder);
+    return 1;
+  }
+}}}
+
+/* ****************************************************************************************************************** *
+ * ***[ END OF TEST_MAZES_MANAGER.CC ]******************************************************************************* *
+ * ****************************************************************************************************************** */
@@ -0,0 +1,294 @@
+/**
+ * @file      test_save_file.cc
+ * @author    Dee'Kej (David Kaspar - xkaspa34)
+ * @version   0.1
+ * @brief     Test of the save file of the game.
+ *
+ * @detailed  The snapshot of the game is encoded & decoded back and compared with the original, then the truncated &
+ *            corrupted saves have to be refused. Finally the decoded snapshot is restored into the maze, and every
+ *            type of its blocks is checked, as well as the snapshots not fitting the maze are refused.
+ */
+
+/* ****************************************************************************************************************** *
+ * ***[ START OF TEST_SAVE_FILE.CC ]********************************************************************************* *
+ * ****************************************************************************************************************** */
+
+
+/* ****************************************************************************************************************** *
+ ~ ~~~[ HEADER FILES ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ ~
+ * ****************************************************************************************************************** */
+
+// C++ header files:
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+
+// Program header files:
+#include "../mazed_game_maze.hh"
+#include "../mazed_maze_file.hh"
+#include "../mazed_save_file.hh"
+
+
+/* ****************************************************************************************************************** *
+ ~ ~~~[ GLOBAL VARIABLES ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ ~
+ * ****************************************************************************************************************** */
+
+// Maze with 1 key, 3 gates, 1 guardian & 2 players. Blocks of the 1st row are: wall, player, empty, key, empty, gate,
+// empty, gate, empty, gate, empty, target, empty, empty, wall.
+const std::string MAZE_TEXT =
+  "version=1.0\n"
+  "size=15x15\n"
+  "--\n"
+  "X X X X X X X X X X X X X X X\n"
+  "X 1   *   ~   ~   ~   G     X\n"
+  "X 2           @             X\n"
+  "X                           X\n"
+  "X                           X\n"
+  "X                           X\n"
+  "X                           X\n"
+  "X                           X\n"
+  "X                           X\n"
+  "X                           X\n"
+  "X                           X\n"
+  "X                           X\n"
+  "X                           X\n"
+  "X                           X\n"
+  "X X X X X X X X X X X X X X X\n";
+
+const std::size_t CHECKED_OFFSET = 12;  // Offset of the save's content behind the checksum.
+const std::size_t KEYS_NUM_OFFSET = 32; // Offset of the keys_num within the header.
+
+unsigned failures {0};
+
+
+/* ****************************************************************************************************************** *
+ ~ ~~~[ AUXILIARY FUNCTIONS ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ ~
+ * ****************************************************************************************************************** */
+
+void check(bool condition, const std::string &what)
+{{{
+  if (condition == false) {
+    std::cerr << "test_save_file: " << what << std::endl;
+    failures++;
+  }
+
+  return;
+}}}
+
+
+/**
+ * @return  Snapshot fitting the MAZE_TEXT - the key moved & the key dropped on the open gate, 2 gates open, the
+ *          guardian on the target, the 1st player holding a key, the 2nd one without it & the others not present.
+ */
+game::snapshot snapshot_create()
+{{{
+  game::snapshot state;
+
+  state.maze_name = "test.maze";
+  state.game_owner = "owner";
+  state.game_speed = 500;
+  state.ticks = 1234567890123UL;
+
+  state.keys = {{3, 3}, {1, 7}};
+  state.gates_open = {{1, 5}, {1, 7}};
+  state.guardians = {{1, 11}};
+
+  state.players[0].present = true;
+  state.players[0].nick = "first";
+  state.players[0].coords = {3, 1};
+  state.players[0].lifes = 3;
+  state.players[0].has_key = true;
+
+  state.players[1].present = true;
+  state.players[1].nick = "second";
+  state.players[1].coords = {2, 1};
+  state.players[1].lifes = 2;
+  state.players[1].has_key = false;
+
+  return state;
+}}}
+
+
+bool snapshots_equal(const game::snapshot &first, const game::snapshot &second)
+{{{
+  if (first.maze_name != second.maze_name || first.maze_fingerprint != second.maze_fingerprint ||
+      first.game_owner != second.game_owner || first.game_speed != second.game_speed ||
+      first.ticks != second.ticks || first.keys != second.keys || first.gates_open != second.gates_open ||
+      first.guardians != second.guardians) {
+    return false;
+  }
+
+  for (unsigned i = 0; i < GAME_MAX_PLAYERS; i++) {
+    const game::snapshot::player_state &first_player = first.players[i];
+    const game::snapshot::player_state &second_player = second.players[i];
+
+    if (first_player.present != second_player.present) {
+      return false;
+    }
+
+    if (first_player.present == true &&
+        (first_player.nick != second_player.nick || first_player.coords != second_player.coords ||
+         first_player.lifes != second_player.lifes || first_player.has_key != second_player.has_key)) {
+      return false;
+    }
+  }
+
+  return true;
+}}}
+
+
+/**
+ * Computes the checksum of the modified save again, so the save is refused by its content & not by the checksum.
+ */
+void checksum_update(std::string &content)
+{{{
+  std::uint32_t checksum = mazed::maze_file::checksum(reinterpret_cast<const unsigned char *>(content.data()) +
+                                                      CHECKED_OFFSET, content.size() - CHECKED_OFFSET);
+  std::memcpy(&content[CHECKED_OFFSET - sizeof(checksum)], &checksum, sizeof(checksum));
+  return;
+}}}
+
+
+/**
+ * @return  New maze of the MAZE_TEXT.
+ */
+game::maze *maze_create()
+{{{
+  std::istringstream maze_file(MAZE_TEXT);
+  std::shared_ptr<const game::maze_layout> ps_layout(mazed::maze_file::parse(maze_file));
+
+  return (ps_layout) ? new game::maze(ps_layout) : NULL;
+}}}
+
+
+/* ****************************************************************************************************************** *
+ ~ ~~~[ TESTS ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ ~
+ * ****************************************************************************************************************** */
+
+void test_round_trip(const std::string &content, const game::snapshot &state)
+{{{
+  game::snapshot decoded;
+
+  check(mazed::save_file::decode(content, decoded) == true, "encoded save couldn't be decoded");
+  check(snapshots_equal(state, decoded) == true, "decoded save differs from the encoded snapshot");
+
+  return;
+}}}
+
+
+void test_corrupted(const std::string &content)
+{{{
+  game::snapshot decoded;
+
+  for (std::size_t length = 0; length < content.size(); length++) {
+    std::string truncated = content.substr(0, length);
+    check(mazed::save_file::decode(truncated, decoded) == false, "save truncated to " + std::to_string(length) +
+                                                                 " bytes was decoded");
+
+    // Truncated save with the valid checksum has to be refused by its lengths:
+    if (length >= CHECKED_OFFSET) {
+      checksum_update(truncated);
+      check(mazed::save_file::decode(truncated, decoded) == false, "save truncated to " + std::to_string(length) +
+                                                                   " bytes with valid checksum was decoded");
+    }
+  }
+
+  for (std::size_t i = 0; i < content.size(); i++) {
+    std::string corrupted = content;
+    corrupted[i] ^= 0x5A;
+    check(mazed::save_file::decode(corrupted, decoded) == false, "save with byte " + std::to_string(i) +
+                                                                 " corrupted was decoded");
+  }
+
+  std::string extended = content + "X";
+  checksum_update(extended);
+  check(mazed::save_file::decode(extended, decoded) == false, "save with extra byte was decoded");
+
+  std::string keys_overflow = content;
+  keys_overflow[KEYS_NUM_OFFSET] = '\xFF';
+  keys_overflow[KEYS_NUM_OFFSET + 1] = '\xFF';
+  checksum_update(keys_overflow);
+  check(mazed::save_file::decode(keys_overflow, decoded) == false, "save with too many keys was decoded");
+
+  return;
+}}}
+
+
+void test_restore(const game::snapshot &state)
+{{{
+  std::unique_ptr<game::maze> pu_maze(maze_create());
+
+  if (!pu_maze) {
+    check(false, "maze couldn't be parsed");
+    return;
+  }
+
+  check(pu_maze->restore(state) == true, "snapshot couldn't be restored");
+
+  check(pu_maze->block_get(1, 0) == game::block::WALL, "wall changed");
+  check(pu_maze->block_get(1, 2) == game::block::EMPTY, "empty block changed");
+  check(pu_maze->block_get(1, 3) == game::block::EMPTY, "key of the maze wasn't removed");
+  check(pu_maze->block_get(3, 3) == game::block::KEY, "key wasn't restored");
+  check(pu_maze->block_get(1, 5) == game::block::GATE_OPEN, "open gate wasn't restored");
+  check(pu_maze->block_get(1, 7) == game::block::GATE_DROPPED_KEY, "key dropped on the gate wasn't restored");
+  check(pu_maze->block_get(1, 9) == game::block::GATE_CLOSED, "closed gate changed");
+  check(pu_maze->block_get(1, 11) == game::block::TARGET, "target changed");
+
+  // Snapshots not fitting the maze:
+  game::snapshot key_on_wall = state;
+  key_on_wall.keys.push_back({0, 0});
+
+  game::snapshot key_on_target = state;
+  key_on_target.keys.push_back({1, 11});
+
+  game::snapshot gate_on_empty = state;
+  gate_on_empty.gates_open.push_back({1, 2});
+
+  game::snapshot key_on_closed_gate = state;
+  key_on_closed_gate.keys.push_back({1, 9});
+
+  game::snapshot player_on_key = state;
+  player_on_key.players[1].coords = {3, 3};
+
+  game::snapshot guardians_missing = state;
+  guardians_missing.guardians.clear();
+
+  const game::snapshot *refused[] = {&key_on_wall, &key_on_target, &gate_on_empty, &key_on_closed_gate,
+                                     &player_on_key, &guardians_missing};
+
+  for (unsigned i = 0; i < sizeof(refused) / sizeof(refused[0]); i++) {
+    pu_maze.reset(maze_create());
+    check(pu_maze->restore(*refused[i]) == false, "snapshot " + std::to_string(i) + " not fitting the maze restored");
+  }
+
+  return;
+}}}
+
+
+/* ****************************************************************************************************************** *
+ ~ ~~~[ MAIN FUNCTION ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ ~
+ * ****************************************************************************************************************** */
+
+int main()
+{{{
+  game::snapshot state = snapshot_create();
+  std::string content = mazed::save_file::encode(state);
+
+  test_round_trip(content, state);
+  test_corrupted(content);
+  test_restore(state);
+
+  if (failures > 0) {
+    std::cerr << "test_save_file: FAILED" << std::endl;
+    return 1;
+  }
+
+  std::cout << "test_save_file: " << content.size() << " B save: OK" << std::endl;
+  return 0;
+}}}
+
+/* ****************************************************************************************************************** *
+ * ***[ END OF TEST_SAVE_FILE.CC ]*********************************************************************************** *
+ * ****************************************************************************************************************** */
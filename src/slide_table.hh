@@ -0,0 +1,207 @@
+/**
+ * @file      slide_table.hh
+ * @author    Dee'Kej (David Kaspar - xkaspa34)
+ * @version   0.1
+ * @brief     Table of slide lengths of the maze, shared by the server and the client.
+ */
+
+
+/* ****************************************************************************************************************** *
+ * ***[ START OF SLIDE_TABLE.HH ]************************************************************************************ *
+ * ****************************************************************************************************************** */
+
+#ifndef H_GUARD_SLIDE_TABLE_HH
+#define H_GUARD_SLIDE_TABLE_HH
+
+
+/* ****************************************************************************************************************** *
+ ~ ~~~[ HEADER FILES ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ ~
+ * ****************************************************************************************************************** */
+
+#include <array>
+#include <cstddef>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+
+/* ****************************************************************************************************************** *
+ ~ ~~~[ SLIDE_TABLE CLASS ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ ~
+ * ****************************************************************************************************************** */
+
+namespace game {
+
+  /**
+   * Holds for every cell of the maze and every direction the number of cells, which can be passed before the blocking
+   * cell or the edge of the maze is reached. The player keeps moving in the same direction until it's blocked, so the
+   * end of its slide is found in O(1). When a cell becomes blocked or passable, only its row and column are patched.
+   */
+  class slide_table {
+    public:
+      // Values are the same as of the game::E_move & protocol::E_user_command:
+      enum E_direction : unsigned char {
+        LEFT = 1,
+        RIGHT,
+        UP,
+        DOWN,
+      };
+
+    private:
+      using schar_t = signed char;
+
+      schar_t                                     rows_num_;
+      schar_t                                     cols_num_;
+      std::vector<bool>                           blocked_;       // Row-major.
+      std::vector<std::array<unsigned char, 4>>   lengths_;       // Row-major, indexed by direction - LEFT.
+
+      static_assert(sizeof(std::array<unsigned char, 4>) == 4, "lengths of the game::slide_table are not contiguous");
+      bool                                        built_ {false};
+
+      // // // // // // // // // // //
+
+      void build_row(schar_t row)
+      {{{
+        unsigned char length {0};
+
+        for (schar_t col = 0; col < cols_num_; col++) {
+          lengths_[row * cols_num_ + col][LEFT - LEFT] = length;
+          length = (blocked_[row * cols_num_ + col] == true) ? 0 : length + 1;
+        }
+
+        length = 0;
+
+        for (schar_t col = cols_num_ - 1; col >= 0; col--) {
+          lengths_[row * cols_num_ + col][RIGHT - LEFT] = length;
+          length = (blocked_[row * cols_num_ + col] == true) ? 0 : length + 1;
+        }
+
+        return;
+      }}}
+
+
+      void build_col(schar_t col)
+      {{{
+        unsigned char length {0};
+
+        for (schar_t row = 0; row < rows_num_; row++) {
+          lengths_[row * cols_num_ + col][UP - LEFT] = length;
+          length = (blocked_[row * cols_num_ + col] == true) ? 0 : length + 1;
+        }
+
+        length = 0;
+
+        for (schar_t row = rows_num_ - 1; row >= 0; row--) {
+          lengths_[row * cols_num_ + col][DOWN - LEFT] = length;
+          length = (blocked_[row * cols_num_ + col] == true) ? 0 : length + 1;
+        }
+
+        return;
+      }}}
+
+    public:
+      slide_table(schar_t rows_num, schar_t cols_num) :
+        rows_num_{rows_num}, cols_num_{cols_num}, blocked_(rows_num * cols_num, false),
+        lengths_(rows_num * cols_num)
+      {{{
+        return;
+      }}}
+
+
+      ~slide_table()
+      {{{
+        return;
+      }}}
+
+
+      /**
+       * Builds the whole table from the cells set so far. Cells set after the build are patched immediately.
+       */
+      void build()
+      {{{
+        for (schar_t row = 0; row < rows_num_; row++) {
+          build_row(row);
+        }
+
+        for (schar_t col = 0; col < cols_num_; col++) {
+          build_col(col);
+        }
+
+        built_ = true;
+        return;
+      }}}
+
+
+      /**
+       * @return  Raw lengths of the table, rows_num * cols_num * 4 bytes.
+       */
+      const unsigned char *data() const
+      {{{
+        return lengths_[0].data();
+      }}}
+
+
+      void set_blocked(schar_t row, schar_t col, bool blocked)
+      {{{
+        if (blocked_[row * cols_num_ + col] == blocked) {
+          return;
+        }
+
+        blocked_[row * cols_num_ + col] = blocked;
+
+        if (built_ == true) {
+          build_row(row);
+          build_col(col);
+        }
+
+        return;
+      }}}
+
+
+      /**
+       * @return  Number of cells passed by the slide from the given cell in the given direction.
+       */
+      unsigned char length(schar_t row, schar_t col, E_direction direction) const
+      {{{
+        return lengths_[row * cols_num_ + col][direction - LEFT];
+      }}}
+
+
+      /**
+       * @return  Coordinates of the cell, where the slide from the given cell in the given direction ends.
+       */
+      std::pair<schar_t, schar_t> slide_end(schar_t row, schar_t col, E_direction direction) const
+      {{{
+        unsigned char slide = length(row, col, direction);
+
+        switch (direction) {
+          case LEFT :
+            return std::pair<schar_t, schar_t>(row, col - slide);
+
+          case RIGHT :
+            return std::pair<schar_t, schar_t>(row, col + slide);
+
+          case UP :
+            return std::pair<schar_t, schar_t>(row - slide, col);
+
+          case DOWN :
+          default :
+            return std::pair<schar_t, schar_t>(row + slide, col);
+        }
+      }}}
+
+
+      /**
+       * @return  Approximate number of bytes occupied by the table.
+       */
+      std::size_t memory_size() const
+      {{{
+        return sizeof(*this) + blocked_.capacity() / 8 + lengths_.capacity() * sizeof(lengths_[0]);
+      }}}
+  };
+}
+
+/* ****************************************************************************************************************** *
+ * ***[ END OF SLIDE_TABLE.HH ]************************************************************************************** *
+ * ****************************************************************************************************************** */
+
+#endif